@@ -0,0 +1,157 @@
+#include <cu0/proc/command_graph.hh>
+#include <cu0/proc/command_runner.hh>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    //! appends the name of the node to the shared file
+    auto file = std::ofstream{argv[1], std::ios::app};
+    file << argv[2] << std::flush;
+    std::cout << argv[2];
+    return argc > 3 ? std::stoi(argv[3]) : 0;
+  }
+
+  using namespace std::chrono_literals;
+  const auto path = std::filesystem::temp_directory_path() /
+      ("check_cu0_command_graph_" + std::to_string(::getpid()));
+  //! creates an executable of a node
+  const auto node = [&argv, &path](
+      const std::string& name,
+      const std::string& code = "0"
+  ) {
+    return cu0::Executable{
+      .binary = argv[0],
+      .arguments = { path.string(), name, code, },
+    };
+  };
+  //! reads the names of the nodes in the order they have been run
+  const auto order = [&path]() {
+    auto file = std::ifstream{path};
+    auto ret = std::string(std::istreambuf_iterator<char>{file}, {});
+    std::filesystem::remove(path);
+    return ret;
+  };
+  auto created = cu0::CommandRunner::create(1);
+  assert(std::holds_alternative<cu0::CommandRunner>(created));
+  auto& runner = std::get<cu0::CommandRunner>(created);
+  {
+    auto graph = cu0::CommandGraph{};
+    assert(graph.size() == 0);
+    assert(graph.criticalPath() == 0ns);
+    assert(graph.run(runner).empty());
+    //! a dependency has to be added before
+    const auto invalid = graph.add(node("a"), std::vector<std::size_t>{ 0, });
+    assert(
+        std::get<cu0::CommandGraph::AddError>(invalid) ==
+            cu0::CommandGraph::AddError::INVAL
+    );
+    assert(graph.size() == 0);
+  }
+  {
+    //! the longest path is started first
+    auto graph = cu0::CommandGraph{};
+    const auto a = std::get<std::size_t>(graph.add(node("a"), {}, 10ms));
+    const auto b = std::get<std::size_t>(graph.add(node("b"), {}, 1ms));
+    const auto c = std::get<std::size_t>(
+        graph.add(node("c"), std::vector{ b, }, 100ms)
+    );
+    const auto d = std::get<std::size_t>(
+        graph.add(node("d"), std::vector{ a, c, }, 1ms)
+    );
+    assert(d == 3);
+    assert(graph.size() == 4);
+    assert(graph.criticalPath() == 102ms);
+    const auto results = graph.run(runner);
+    assert(order() == "bcad");
+    for (auto i = std::size_t{0}; i < results.size(); i++) {
+      assert(results[i].exitCode.value() == 0);
+      assert(results[i].out == std::string(1, static_cast<char>('a' + i)));
+      assert(results[i].duration > 0ns);
+    }
+    //! the durations replace the estimates
+    graph.updateEstimates(results);
+    assert(
+        graph.criticalPath() ==
+            results[b].duration + results[c].duration + results[d].duration ||
+        graph.criticalPath() == results[a].duration + results[d].duration
+    );
+  }
+  {
+    //! without estimates the number of nodes on the path is used,
+    //!     then the order of adding
+    auto graph = cu0::CommandGraph{};
+    static_cast<void>(graph.add(node("x")));
+    const auto y = std::get<std::size_t>(graph.add(node("y")));
+    static_cast<void>(graph.add(node("z"), std::vector{ y, }));
+    static_cast<void>(graph.run(runner));
+    assert(order() == "yxz");
+  }
+  {
+    //! the dependents of a failed node are not run
+    auto graph = cu0::CommandGraph{};
+    const auto a = std::get<std::size_t>(graph.add(node("a", "3")));
+    const auto b = std::get<std::size_t>(graph.add(node("b")));
+    const auto c = std::get<std::size_t>(
+        graph.add(node("c"), std::vector{ a, b, })
+    );
+    const auto d = std::get<std::size_t>(
+        graph.add(node("d"), std::vector{ c, })
+    );
+    const auto e = std::get<std::size_t>(
+        graph.add(node("e"), std::vector{ b, })
+    );
+    auto parallel = cu0::CommandRunner::create(4);
+    const auto [results, error] =
+        graph.runCautious(std::get<cu0::CommandRunner>(parallel));
+    assert(error == cu0::ProcessReactor::RunError::NO_ERROR);
+    assert(results[a].exitCode.value() == 3);
+    assert(results[b].exitCode.value() == 0);
+    assert(!results[c].exitCode.has_value());
+    assert(results[c].error == cu0::Process::CreateError::NO_ERROR);
+    assert(!results[d].exitCode.has_value());
+    assert(results[e].exitCode.value() == 0);
+    const auto names = order();
+    assert(names.size() == 3);
+    assert(names.find('c') == std::string::npos);
+  }
+  {
+    //! dependents are run after their dependencies in parallel
+    auto graph = cu0::CommandGraph{};
+    auto roots = std::vector<std::size_t>{};
+    for (const auto& name : { "a", "b", "c", "d", }) {
+      roots.push_back(std::get<std::size_t>(graph.add(node(name))));
+    }
+    const auto join = std::get<std::size_t>(graph.add(node("j"), roots));
+    static_cast<void>(graph.add(node("k"), std::vector{ join, }));
+    auto parallel = cu0::CommandRunner::create(4);
+    const auto results = graph.run(std::get<cu0::CommandRunner>(parallel));
+    const auto names = order();
+    assert(names.size() == 6);
+    assert(names.substr(4) == "jk");
+    for (const auto& result : results) {
+      assert(result.exitCode.value() == 0);
+    }
+  }
+#else
+#warning <sys/epoll.h> or <unistd.h> or <sys/types.h> or <sys/wait.h> or \
+    <signal.h> is not found => cu0::CommandGraph will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::CommandGraph will not be checked
+#endif
+
+  return 0;
+}
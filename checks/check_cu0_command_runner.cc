@@ -0,0 +1,151 @@
+#include <cu0/proc/command_runner.hh>
+#include <cu0/proc/process.hh>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "echo") {
+      std::cout << argv[2];
+      std::cerr << argv[2] << argv[2];
+      return std::stoi(argv[2]) % 256;
+    } else if (std::string{argv[1]} == "large") {
+      std::cout << std::string(std::size_t{1} << 20, argv[2][0]);
+      return 0;
+    } else if (std::string{argv[1]} == "hold") {
+      //! marks the start and the end of the process in the shared file
+      auto file = std::ofstream{argv[2], std::ios::app};
+      file << '+' << std::flush;
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      file << '-' << std::flush;
+      return 0;
+    }
+    return 100;
+  }
+
+  {
+    auto created = cu0::CommandRunner::create(0);
+    assert(std::holds_alternative<cu0::CommandRunner>(created));
+    auto& runner = std::get<cu0::CommandRunner>(created);
+    assert(runner.concurrency() == 1);
+    assert(runner.run({}).empty());
+  }
+  {
+    auto created = cu0::CommandRunner::create();
+    assert(std::holds_alternative<cu0::CommandRunner>(created));
+    assert(std::get<cu0::CommandRunner>(created).concurrency() >= 1);
+  }
+  auto created = cu0::CommandRunner::create(4);
+  assert(std::holds_alternative<cu0::CommandRunner>(created));
+  auto runner = std::get<cu0::CommandRunner>(std::move(created));
+  {
+    //! the results are in the order of the executables
+    constexpr auto N = 100;
+    auto executables = std::vector<cu0::Executable>{};
+    for (auto i = 0; i < N; i++) {
+      executables.push_back(
+          cu0::Executable{
+            .binary = argv[0],
+            .arguments = { "echo", std::to_string(i), },
+          }
+      );
+    }
+    const auto results = runner.run(executables);
+    assert(results.size() == N);
+    for (auto i = 0; i < N; i++) {
+      assert(results[i].error == cu0::Process::CreateError::NO_ERROR);
+      assert(results[i].exitCode.value() == i);
+      assert(results[i].out == std::to_string(i));
+      assert(results[i].err == std::to_string(i) + std::to_string(i));
+    }
+  }
+  {
+    //! outputs larger than a pipe buffer are read concurrently
+    auto executables = std::vector<cu0::Executable>{};
+    for (const auto& letter : { "a", "b", "c", "d", "e", "f", }) {
+      executables.push_back(
+          cu0::Executable{
+            .binary = argv[0],
+            .arguments = { "large", letter, },
+          }
+      );
+    }
+    const auto results = runner.run(executables);
+    for (auto i = std::size_t{0}; i < results.size(); i++) {
+      assert(results[i].exitCode.value() == 0);
+      assert(
+          results[i].out ==
+              std::string(std::size_t{1} << 20, static_cast<char>('a' + i))
+      );
+    }
+  }
+  {
+    //! errors of execve() are the exit status code
+    const auto results = runner.run(
+        std::vector{ cu0::Executable{ .binary = "/nonexistent/binary", }, }
+    );
+    assert(results[0].exitCode.value() == ENOENT);
+    //! invalid redirections are errors of the creation
+    const auto invalid = runner.run(
+        std::vector{ cu0::Executable{ .binary = argv[0], }, },
+        cu0::Stdio{ .in = cu0::Redirection::toStdout(), }
+    );
+    assert(invalid[0].error == cu0::Process::CreateError::INVAL);
+    assert(!invalid[0].exitCode.has_value());
+  }
+  {
+    //! at most the concurrency of processes run at a time
+    const auto path = std::filesystem::temp_directory_path() /
+        ("check_cu0_command_runner_" + std::to_string(::getpid()));
+    auto executables = std::vector<cu0::Executable>(
+        12,
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "hold", path.string(), },
+        }
+    );
+    const auto results = runner.run(
+        executables,
+        cu0::Stdio{
+          .in = cu0::Redirection::null(),
+          .out = cu0::Redirection::null(),
+          .err = cu0::Redirection::null(),
+        }
+    );
+    for (const auto& result : results) {
+      assert(result.exitCode.value() == 0);
+      assert(result.out.empty());
+    }
+    auto file = std::ifstream{path};
+    const auto marks = std::string(std::istreambuf_iterator<char>{file}, {});
+    assert(marks.size() == 2 * executables.size());
+    auto running = 0;
+    for (const auto& mark : marks) {
+      running += mark == '+' ? 1 : -1;
+      assert(running >= 0 && running <= 4);
+    }
+    std::filesystem::remove(path);
+  }
+#else
+#warning <sys/epoll.h> or <unistd.h> or <sys/types.h> or <sys/wait.h> or \
+    <signal.h> is not found => cu0::CommandRunner will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::CommandRunner will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <cu0/proc/exec_plan.hh>
+#include <cassert>
+#include <string>
+
+int main() {
+
+  const auto emptyPlan = cu0::ExecPlan{cu0::Executable{}};
+  assert(emptyPlan.argumentCount() == 0);
+  assert(emptyPlan.argv()[0] != NULL);
+  assert(emptyPlan.argv()[0][0] == '\0');
+  assert(emptyPlan.argv()[1] == NULL);
+  assert(emptyPlan.envp()[0] == NULL);
+
+  auto plan = cu0::ExecPlan{cu0::Executable{
+    .binary = "binary",
+    .arguments = { "arg1", "arg2", "arg3", },
+    .environment = { { "k1", "v1", }, { "k2", "v2", }, },
+  }};
+  assert(plan.argumentCount() == 3);
+  assert(std::string{plan.argv()[0]} == "binary");
+  assert(std::string{plan.argv()[1]} == "arg1");
+  assert(std::string{plan.argv()[2]} == "arg2");
+  assert(std::string{plan.argv()[3]} == "arg3");
+  assert(plan.argv()[4] == NULL);
+  assert(std::string{plan.envp()[0]} == "k1=v1");
+  assert(std::string{plan.envp()[1]} == "k2=v2");
+  assert(plan.envp()[2] == NULL);
+  assert(plan.size() == 7 + 3 * 5 + 2 * 6);
+
+  assert(
+      plan.argument(1, "longerArgument2") ==
+          cu0::ExecPlan::PatchError::NO_ERROR
+  );
+  assert(plan.argument(0) == "arg1");
+  assert(plan.argument(1) == "longerArgument2");
+  assert(plan.argument(2) == "arg3");
+  assert(std::string{plan.argv()[3]} == "arg3");
+  assert(std::string{plan.envp()[0]} == "k1=v1");
+  assert(std::string{plan.envp()[1]} == "k2=v2");
+
+  //! patching within the capacity does not allocate
+  const auto* const data = plan.argv()[0];
+  const auto capacity = plan.capacity();
+  plan.argument(1, "a");
+  assert(plan.argv()[0] == data);
+  assert(plan.capacity() == capacity);
+  assert(plan.argument(1) == "a");
+  plan.argument(2, "");
+  assert(plan.argument(2).empty());
+  plan.argument(2, "longerArgument3");
+  assert(plan.argv()[0] == data);
+  assert(plan.capacity() == capacity);
+  assert(plan.argument(2) == "longerArgument3");
+  assert(std::string{plan.envp()[1]} == "k2=v2");
+
+  //! an index out of range does not touch the environment
+  assert(plan.argument(3, "k1=patched") == cu0::ExecPlan::PatchError::INVAL);
+  assert(plan.argument(3).empty());
+  assert(emptyPlan.argument(0).empty());
+  assert(std::string{plan.envp()[0]} == "k1=v1");
+  assert(plan.argv()[4] == NULL);
+
+  plan.reserve(4096);
+  assert(plan.capacity() >= 4096);
+  assert(std::string{plan.argv()[0]} == "binary");
+  assert(plan.argument(2) == "longerArgument3");
+
+  const auto copy = plan;
+  plan.argument(0, "patched");
+  assert(copy.argument(0) == "arg1");
+  assert(plan.argument(0) == "patched");
+  assert(copy.argv()[0] != plan.argv()[0]);
+  assert(std::string{copy.envp()[0]} == "k1=v1");
+  assert(copy.envp()[2] == NULL);
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+#include <cu0/proc/pipeline.hh>
+#include <cassert>
+#include <cerrno>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+#endif
+
+int main(int argc, char** argv) {
+
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "cat") {
+      std::cout << std::cin.rdbuf();
+      return 0;
+    } else if (std::string{argv[1]} == "err") {
+      std::cerr << "err";
+      std::cerr.flush();
+      std::cout << std::cin.rdbuf();
+      return 0;
+    } else if (std::string{argv[1]} == "count") {
+      auto count = std::size_t{0};
+      char c;
+      while (std::cin.get(c)) {
+        count++;
+      }
+      std::cout << count;
+      return 0;
+    }
+    return std::stoi(argv[1]);
+  }
+
+  assert(cu0::Pipeline{}.size() == 0);
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+  {
+    const auto created = cu0::Pipeline{}.create();
+    assert(std::holds_alternative<cu0::Process::CreateError>(created));
+    assert(
+        std::get<cu0::Process::CreateError>(created) ==
+            cu0::Process::CreateError::INVAL
+    );
+  }
+  {
+    auto pipeline = cu0::Pipeline{};
+    pipeline.
+        then({ .binary = argv[0], .arguments = { "cat", }, }).
+        then({ .binary = argv[0], .arguments = { "cat", }, }).
+        then({ .binary = argv[0], .arguments = { "count", }, });
+    assert(pipeline.size() == 3);
+    auto created = pipeline.create();
+    assert(std::holds_alternative<std::vector<cu0::Process>>(created));
+    auto& processes = std::get<std::vector<cu0::Process>>(created);
+    assert(processes.size() == 3);
+    assert(processes.front().stdinPipe() >= 0);
+    assert(processes.front().stdoutPipe() == -1);
+    assert(processes[1].stdinPipe() == -1);
+    assert(processes[1].stdoutPipe() == -1);
+    assert(processes.back().stdinPipe() == -1);
+    assert(processes.back().stdoutPipe() >= 0);
+    constexpr auto SIZE = std::size_t{1} << 20;
+    //! more than the pipe buffers can hold -> the stages run concurrently
+    processes.front().stdin(std::string(SIZE, 'x'));
+    processes.front().closeStdin();
+    auto out = std::string{};
+    processes.back().stdoutChunks([&out](std::span<const std::byte> chunk) {
+      out.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    });
+    assert(out == std::to_string(SIZE));
+    for (auto& process : processes) {
+      process.wait();
+      assert(process.exitCode().value() == 0);
+      assert(process.stderr().empty());
+    }
+  }
+  {
+    auto created = cu0::Pipeline{}.
+        then({ .binary = argv[0], .arguments = { "err", }, }).
+        then({ .binary = argv[0], .arguments = { "err", }, }).
+        mergeStderr().
+        create(cu0::Process::SpawnStrategy::POSIX_SPAWN);
+    assert(std::holds_alternative<std::vector<cu0::Process>>(created));
+    auto& processes = std::get<std::vector<cu0::Process>>(created);
+    assert(processes.front().stderrPipe() == -1);
+    assert(processes.back().stderrPipe() == -1);
+    processes.front().stdin("in");
+    processes.front().closeStdin();
+    auto out = std::string{};
+    processes.back().stdoutChunks([&out](std::span<const std::byte> chunk) {
+      out.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    });
+    assert(out == "errerrin");
+    for (auto& process : processes) {
+      process.wait();
+      assert(process.exitCode().value() == 0);
+    }
+  }
+  {
+    auto created = cu0::Pipeline{}.
+        then({ .binary = argv[0], .arguments = { "3", }, }).
+        then({ .binary = argv[0], .arguments = { "4", }, }).
+        create();
+    assert(std::holds_alternative<std::vector<cu0::Process>>(created));
+    auto& processes = std::get<std::vector<cu0::Process>>(created);
+    processes.front().wait();
+    processes.back().wait();
+    assert(processes.front().exitCode().value() == 3);
+    assert(processes.back().exitCode().value() == 4);
+  }
+  {
+    //! a failed stage stops the stages created before it
+    const auto missing = std::string{argv[0]} + "_missing";
+    const auto created = cu0::Pipeline{}.
+        then({ .binary = argv[0], .arguments = { "cat", }, }).
+        then({ .binary = missing, }).
+        then({ .binary = argv[0], .arguments = { "cat", }, }).
+        create(cu0::Process::SpawnStrategy::POSIX_SPAWN);
+    assert(
+        std::get<cu0::Process::CreateError>(created) ==
+            static_cast<cu0::Process::CreateError>(ENOENT)
+    );
+    //! the first stage has been waited => no child is left
+    assert(::waitpid(-1, nullptr, WNOHANG) < 0 && errno == ECHILD);
+  }
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+  {
+    //! a failed pipe of a stage closes only the created file descriptors
+    rlimit previous;
+    assert(::getrlimit(RLIMIT_NOFILE, &previous) == 0);
+    auto lowered = previous;
+    lowered.rlim_cur = 64;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    //! occupies all the file descriptors
+    auto occupied = std::vector<int>{};
+    for (auto fd = ::dup(0); fd >= 0; fd = ::dup(0)) {
+      occupied.push_back(fd);
+    }
+    //! frees the file descriptors of the stdin pipe (2) or
+    //!     of the stdin and stdout pipes (4) => the next pipe fails
+    for (const auto& [free, merge] : { std::pair{2, true}, {4, false}, }) {
+      for (auto i = 0; i < free; i++) {
+        ::close(occupied.back());
+        occupied.pop_back();
+      }
+      auto pipeline = cu0::Pipeline{};
+      pipeline.then({ .binary = argv[0], .arguments = { "cat", }, });
+      if (merge) {
+        pipeline.mergeStderr();
+      }
+      const auto created = pipeline.create();
+      assert(
+          std::get<cu0::Process::CreateError>(created) ==
+              cu0::Process::CreateError::MFILE
+      );
+      for (const auto& fd : occupied) {
+        assert(::fcntl(fd, F_GETFD) >= 0);
+      }
+      for (auto fd = 0; fd < 3; fd++) {
+        assert(::fcntl(fd, F_GETFD) >= 0);
+      }
+      //! the created pipes have been closed => they can be created again
+      for (auto i = 0; i < free; i++) {
+        const auto fd = ::dup(0);
+        assert(fd >= 0);
+        occupied.push_back(fd);
+      }
+      assert(::dup(0) < 0);
+    }
+    for (const auto& fd : occupied) {
+      ::close(fd);
+    }
+    assert(::setrlimit(RLIMIT_NOFILE, &previous) == 0);
+  }
+#else
+#warning <fcntl.h> or <sys/resource.h> is not found => \
+    a failure of cu0::Pipeline::create() will not be checked
+#endif
+#else
+#warning <unistd.h> or <sys/types.h> or <sys/wait.h> is not found => \
+    cu0::Pipeline::create() will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::Pipeline::create() will not be checked
+#endif
+
+  return 0;
+}
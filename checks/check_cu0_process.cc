@@ -3,8 +3,13 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 int main(int argc, char** argv) {
 
@@ -12,6 +17,7 @@ int main(int argc, char** argv) {
 #if __has_include(<unistd.h>)
   const auto thisProcess = cu0::Process::current();
   assert(thisProcess.pid() == static_cast<unsigned>(getpid()));
+  assert(thisProcess.pidfd() == -1);
 #else
 #warning <unistd.h> is not found => cu0::Process::current() will not be checked
 #endif
@@ -24,6 +30,7 @@ int main(int argc, char** argv) {
   };
   const auto someProcess = ProcessCheck{};
   assert(someProcess.pid() == 0);
+  assert(someProcess.pidfd() == -1);
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
@@ -73,6 +80,9 @@ int main(int argc, char** argv) {
 #endif
 
   constexpr auto SLEEP_DURATION = 8; //! [s]
+  constexpr auto SHORT_SLEEP_DURATION = 1; //! [s]
+  constexpr auto LINE_COUNT = 1024;
+  constexpr auto LARGE_OUTPUT_SIZE = std::size_t{1} << 20; //! [B]
   //! for subprocess check
   if (argc > 1) {
     if (std::string{argv[1]} == "64") {
@@ -84,6 +94,78 @@ int main(int argc, char** argv) {
     } else if (std::string{argv[1]} == "128") {
       std::this_thread::sleep_for(std::chrono::seconds{SLEEP_DURATION});
       return 0;
+    } else if (std::string{argv[1]} == "160") {
+      for (auto i = 0; i < LINE_COUNT; i++) {
+        std::cout << "line" << i << (i + 1 < LINE_COUNT ? "\n" : "");
+        std::cerr << i << '\n';
+      }
+      return 0;
+    } else if (std::string{argv[1]} == "224") {
+      auto count = std::size_t{0};
+      char c;
+      while (std::cin.get(c)) {
+        count++;
+      }
+      std::cout << count;
+      return 0;
+    } else if (std::string{argv[1]} == "208") {
+      //! binary output with a pause => a short read happens in the middle
+      std::cout.write("a\0b", 3);
+      std::cout.flush();
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+      std::cerr.write("\0", 1);
+      std::cout << std::string(LARGE_OUTPUT_SIZE, 'x');
+      return 0;
+    } else if (std::string{argv[1]} == "240") {
+      //! echoes the stdin to both the stdout and the stderr
+      char buffer[4096];
+      ssize_t bytes;
+      while ((bytes = ::read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+        if (
+            ::write(STDOUT_FILENO, buffer, bytes) != bytes ||
+            ::write(STDERR_FILENO, buffer, bytes) != bytes
+        ) {
+          return 1;
+        }
+      }
+      return 0;
+    } else if (std::string{argv[1]} == "176") {
+      //! ignores SIGTERM => only SIGKILL terminates the process
+      ::signal(SIGTERM, SIG_IGN);
+      std::cout << "ignoring" << std::endl;
+      std::this_thread::sleep_for(std::chrono::seconds{SLEEP_DURATION});
+      return 0;
+    } else if (std::string{argv[1]} == "144") {
+      //! burns cpu time and touches memory for the resource usage check
+      auto memory = std::vector<char>(LARGE_OUTPUT_SIZE * 64, 1);
+      const auto start = std::chrono::steady_clock::now();
+      auto sum = 0u;
+      while (std::chrono::steady_clock::now() - start <
+          std::chrono::milliseconds{300}) {
+        for (const auto& c : memory) {
+          sum += c;
+        }
+      }
+      return sum == 0;
+    } else if (std::string{argv[1]} == "96") {
+      //! writes to the file descriptors specified by the arguments
+      const auto x = std::stoi(argv[2]);
+      const auto y = std::stoi(argv[3]);
+      return ::write(x, "x", 1) != 1 || ::write(y, "y", 1) != 1;
+    } else if (std::string{argv[1]} == "80") {
+      //! prints the size of the stdin file and whether it is sealed
+      const auto size = ::lseek(STDIN_FILENO, 0, SEEK_END);
+#ifdef F_GET_SEALS
+      const auto seals = ::fcntl(STDIN_FILENO, F_GET_SEALS);
+      const auto sealed = seals >= 0 && (seals & F_SEAL_WRITE) != 0;
+#else
+      const auto sealed = false;
+#endif
+      std::cout << size << (sealed ? " sealed" : "");
+      return 0;
+    } else if (std::string{argv[1]} == "192") {
+      std::this_thread::sleep_for(std::chrono::seconds{SHORT_SLEEP_DURATION});
+      return 0;
     }
     std::cout << argv[1];
     std::cerr << argv[1] << argv[1];
@@ -177,6 +259,35 @@ int main(int argc, char** argv) {
     assert(processWithExitCodeTwo.exitCode().has_value());
     assert(processWithExitCodeTwo.exitCode().value() == 2);
   }
+  {
+    const auto executableWithShortSleep = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"192"},
+    };
+    auto createdWithShortSleep =
+        cu0::Process::create(executableWithShortSleep);
+    assert(std::holds_alternative<cu0::Process>(createdWithShortSleep));
+    auto& processWithShortSleep =
+        std::get<cu0::Process>(createdWithShortSleep);
+#if __has_include(<sys/syscall.h>) && defined(SYS_pidfd_open)
+    assert(processWithShortSleep.pidfd() >= 0);
+#endif
+    const auto start = std::chrono::high_resolution_clock::now();
+    const auto cpuStart = std::clock();
+    assert(
+        processWithShortSleep.waitCautious() ==
+            cu0::Process::WaitError::NO_ERROR
+    );
+    const auto cpuElapsed = std::clock() - cpuStart;
+    const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+    assert(processWithShortSleep.exitCode().value() == 0);
+    assert(elapsed >= std::chrono::seconds{SHORT_SLEEP_DURATION} / 2);
+    //! waiting should not consume cpu time while the process is running
+    assert(cpuElapsed < CLOCKS_PER_SEC / 4);
+    auto movedProcess = std::move(processWithShortSleep);
+    assert(movedProcess.exitCode().value() == 0);
+    assert(movedProcess.waitCautious() == cu0::Process::WaitError::CHILD);
+  }
 #else
 #warning <sys/types.h> or <sys/wait.h> is not found => \
     cu0::Process::wait() will not be checked
@@ -353,7 +464,10 @@ int main(int argc, char** argv) {
     processWithExitCode64.stdin("64\r\n");
     processWithExitCode64.wait();
     assert(processWithExitCode64.exitCode().value() == 64);
-    assert(processWithExitCode64.stdout() == "64");
+    const auto out = processWithExitCode64.stdout();
+    assert(out == "64");
+    //! a small output does not keep a whole read buffer
+    assert(out.capacity() < cu0::Process::READ_SIZE);
     assert(processWithExitCode64.stderr() == "6464");
   }
   {
@@ -531,6 +645,142 @@ int main(int argc, char** argv) {
     assert(errStr == "6464");
     assert(stderrErrorCode == cu0::Process::ReadError::NO_ERROR);
   }
+  for (
+      const auto& strategy : {
+        cu0::Process::SpawnStrategy::VFORK,
+        cu0::Process::SpawnStrategy::FORK,
+        cu0::Process::SpawnStrategy::POSIX_SPAWN,
+        cu0::Process::SpawnStrategy::CLONE,
+      }
+  ) {
+    const auto executableWithExitCode64 = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"64"},
+    };
+    auto createdWithExitCode64 =
+        cu0::Process::create(executableWithExitCode64, strategy);
+    if (
+        std::holds_alternative<cu0::Process::CreateError>(
+            createdWithExitCode64
+        )
+    ) {
+      //! the strategy may be not supported by the platform
+      assert(
+          std::get<cu0::Process::CreateError>(createdWithExitCode64) ==
+              cu0::Process::CreateError::NOSYS
+      );
+      continue;
+    }
+    auto& processWithExitCode64 =
+        std::get<cu0::Process>(createdWithExitCode64);
+    assert(processWithExitCode64.pid() != 0);
+    processWithExitCode64.stdin("64\r\n");
+    processWithExitCode64.wait();
+    assert(processWithExitCode64.exitCode().value() == 64);
+    assert(processWithExitCode64.stdout() == "64");
+    assert(processWithExitCode64.stderr() == "6464");
+    auto createdEmpty = cu0::Process::create(cu0::Executable{}, strategy);
+    if (strategy == cu0::Process::SpawnStrategy::POSIX_SPAWN) {
+      assert(std::holds_alternative<cu0::Process::CreateError>(createdEmpty));
+      assert(
+          static_cast<int>(std::get<cu0::Process::CreateError>(createdEmpty)) ==
+              ENOENT
+      );
+    } else {
+      assert(std::holds_alternative<cu0::Process>(createdEmpty));
+      auto& emptyProcess = std::get<cu0::Process>(createdEmpty);
+      emptyProcess.wait();
+      assert(emptyProcess.exitCode().value() == ENOENT);
+    }
+  }
+  {
+    auto plan = cu0::ExecPlan{cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"0"},
+    }};
+    for (const auto& code : { 0, 1, 2, 255, }) {
+      plan.argument(0, std::to_string(code));
+      auto created = cu0::Process::create(plan);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      process.wait();
+      assert(process.exitCode().value() == code);
+      assert(process.stdout() == std::to_string(code));
+    }
+  }
+  {
+    const auto executableWithExitCode64 = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"64"},
+    };
+    auto createdWithExitCode64 =
+        cu0::Process::create(executableWithExitCode64);
+    assert(std::holds_alternative<cu0::Process>(createdWithExitCode64));
+    auto& processWithExitCode64 =
+        std::get<cu0::Process>(createdWithExitCode64);
+    const auto input = std::array<std::byte, 3>{
+      std::byte{'6'}, std::byte{'4'}, std::byte{'\n'},
+    };
+    const auto [errorCode, bytesWritten] =
+        processWithExitCode64.stdinCautious(std::span<const std::byte>{input});
+    assert(errorCode == cu0::Process::WriteError::NO_ERROR);
+    assert(bytesWritten == 3);
+    processWithExitCode64.wait();
+    assert(processWithExitCode64.exitCode().value() == 64);
+    assert(processWithExitCode64.stdout() == "64");
+  }
+#if __has_include(<sys/uio.h>)
+  {
+    const auto executableWithExitCode64 = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"64"},
+    };
+    auto createdWithExitCode64 =
+        cu0::Process::create(executableWithExitCode64);
+    assert(std::holds_alternative<cu0::Process>(createdWithExitCode64));
+    auto& processWithExitCode64 =
+        std::get<cu0::Process>(createdWithExitCode64);
+    const auto inputs = std::array<std::string_view, 5>{
+      "", "1", "", "28", "\n",
+    };
+    const auto [errorCode, bytesWritten] =
+        processWithExitCode64.stdinCautious(
+            std::span<const std::string_view>{inputs}
+        );
+    assert(errorCode == cu0::Process::WriteError::NO_ERROR);
+    assert(bytesWritten == 4);
+    processWithExitCode64.wait();
+    assert(processWithExitCode64.exitCode().value() == 64);
+    assert(processWithExitCode64.stdout() == "128");
+  }
+  {
+    const auto executableWithCount = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"224"},
+    };
+    auto createdWithCount = cu0::Process::create(executableWithCount);
+    assert(std::holds_alternative<cu0::Process>(createdWithCount));
+    auto& processWithCount = std::get<cu0::Process>(createdWithCount);
+    //! more buffers than one writev() accepts and more data than a pipe holds
+    const auto block = std::string(4096, 'x');
+    auto inputs = std::vector<std::string_view>(1000, block);
+    processWithCount.stdin(std::span<const std::string_view>{inputs});
+    processWithCount.stdin(std::string_view{block});
+    //! one write() per 3 bytes
+    const auto [writeError, written] =
+        processWithCount.stdinCautious<3>(std::string_view{block});
+    assert(writeError == cu0::Process::WriteError::NO_ERROR);
+    assert(written == block.size());
+    processWithCount.closeStdin();
+    auto out = std::string{};
+    processWithCount.stdoutChunks([&out](std::span<const std::byte> chunk) {
+      out.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    });
+    assert(out == std::to_string(1002 * block.size()));
+    processWithCount.wait();
+    assert(processWithCount.exitCode().value() == 0);
+  }
+#endif
 #else
 #warning <unistd.h> is not found => \
     cu0::Process::stdin() will not be checked
@@ -775,6 +1025,180 @@ int main(int argc, char** argv) {
     assert(str == "255");
     assert(errorCode == cu0::Process::ReadError::NO_ERROR);
   }
+  {
+    const auto executableWithLines = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"160"},
+    };
+    auto createdWithLines = cu0::Process::create(executableWithLines);
+    assert(std::holds_alternative<cu0::Process>(createdWithLines));
+    auto& processWithLines = std::get<cu0::Process>(createdWithLines);
+    auto lineCount = 0;
+    assert(
+        processWithLines.stdoutLines<7>(
+            [&lineCount](std::string_view line) {
+              assert(line == "line" + std::to_string(lineCount));
+              lineCount++;
+            }
+        ) == cu0::Process::ReadError::NO_ERROR
+    );
+    assert(lineCount == LINE_COUNT);
+    auto errBytes = std::size_t{0};
+    auto errChunks = 0;
+    assert(
+        processWithLines.stderrChunks<16>(
+            [&errBytes, &errChunks](std::span<const std::byte> chunk) {
+              assert(!chunk.empty());
+              assert(chunk.size() <= 16);
+              errBytes += chunk.size();
+              errChunks++;
+            }
+        ) == cu0::Process::ReadError::NO_ERROR
+    );
+    auto expectedErrBytes = std::size_t{0};
+    for (auto i = 0; i < LINE_COUNT; i++) {
+      expectedErrBytes += std::to_string(i).size() + 1;
+    }
+    assert(errBytes == expectedErrBytes);
+    assert(errChunks >= static_cast<int>(expectedErrBytes / 16));
+    processWithLines.wait();
+    assert(processWithLines.exitCode().value() == 0);
+  }
+  {
+    const auto executableWithLines = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"160"},
+    };
+    auto createdWithLines = cu0::Process::create(executableWithLines);
+    assert(std::holds_alternative<cu0::Process>(createdWithLines));
+    auto& processWithLines = std::get<cu0::Process>(createdWithLines);
+    auto lineCount = 0;
+    assert(
+        processWithLines.stderrLines([&lineCount](std::string_view line) {
+          assert(line == std::to_string(lineCount));
+          return ++lineCount < 3;
+        }) == cu0::Process::ReadError::NO_ERROR
+    );
+    assert(lineCount == 3);
+    auto firstChunk = std::string{};
+    assert(
+        processWithLines.stdoutChunks<4>(
+            [&firstChunk](std::span<const std::byte> chunk) {
+              firstChunk.append(
+                  reinterpret_cast<const char*>(chunk.data()), chunk.size()
+              );
+              return false;
+            }
+        ) == cu0::Process::ReadError::NO_ERROR
+    );
+    assert(firstChunk == "line");
+    processWithLines.wait();
+  }
+  {
+    const auto executableWithBinaryOutput = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"208"},
+    };
+    auto createdWithBinaryOutput =
+        cu0::Process::create(executableWithBinaryOutput);
+    assert(std::holds_alternative<cu0::Process>(createdWithBinaryOutput));
+    auto& processWithBinaryOutput =
+        std::get<cu0::Process>(createdWithBinaryOutput);
+    const auto [outStr, outErrorCode] =
+        processWithBinaryOutput.stdoutCautious();
+    assert(outErrorCode == cu0::Process::ReadError::NO_ERROR);
+    assert(outStr.size() == 3 + LARGE_OUTPUT_SIZE);
+    assert(outStr.substr(0, 3) == std::string_view("a\0b", 3));
+    assert(std::all_of(outStr.begin() + 3, outStr.end(), [](const char c) {
+      return c == 'x';
+    }));
+    assert(processWithBinaryOutput.stderr<1>() == std::string_view("\0", 1));
+    processWithBinaryOutput.wait();
+    assert(processWithBinaryOutput.exitCode().value() == 0);
+  }
+#if __has_include(<fcntl.h>) && __has_include(<poll.h>) && \
+    __has_include(<signal.h>)
+  {
+    const auto executableWithEcho = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"240"},
+    };
+    auto createdWithEcho = cu0::Process::create(executableWithEcho);
+    assert(std::holds_alternative<cu0::Process>(createdWithEcho));
+    auto& processWithEcho = std::get<cu0::Process>(createdWithEcho);
+    //! far more than the pipe buffers => sequential I/O would deadlock
+    auto input = std::string(LARGE_OUTPUT_SIZE * 4, '\0');
+    for (auto i = std::size_t{0}; i < input.size(); i++) {
+      input[i] = static_cast<char>(i % 251);
+    }
+    const auto [outStr, errStr, writeError, readError] =
+        processWithEcho.communicateCautious(input);
+    assert(writeError == cu0::Process::WriteError::NO_ERROR);
+    assert(readError == cu0::Process::ReadError::NO_ERROR);
+    assert(outStr == input);
+    assert(errStr == input);
+    assert(processWithEcho.stdinPipe() == -1);
+    processWithEcho.wait();
+    assert(processWithEcho.exitCode().value() == 0);
+  }
+  {
+    const auto executableWithEcho = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"240"},
+    };
+    auto createdWithEcho = cu0::Process::create(executableWithEcho);
+    assert(std::holds_alternative<cu0::Process>(createdWithEcho));
+    auto& processWithEcho = std::get<cu0::Process>(createdWithEcho);
+    const auto [outStr, errStr] = processWithEcho.communicate();
+    assert(outStr.empty());
+    assert(errStr.empty());
+    processWithEcho.wait();
+    assert(processWithEcho.exitCode().value() == 0);
+  }
+  {
+    //! the input cannot be passed to a stdin which is not a pipe
+    const auto executableWithEcho = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"240"},
+    };
+    auto createdWithEcho = cu0::Process::create(
+        executableWithEcho,
+        cu0::Stdio{ .in = cu0::Redirection::null(), }
+    );
+    assert(std::holds_alternative<cu0::Process>(createdWithEcho));
+    auto& processWithEcho = std::get<cu0::Process>(createdWithEcho);
+    const auto [outStr, errStr, writeError, readError] =
+        processWithEcho.communicateCautious("lost");
+    assert(writeError == cu0::Process::WriteError::BADF);
+    assert(readError == cu0::Process::ReadError::NO_ERROR);
+    assert(outStr.empty());
+    assert(errStr.empty());
+    processWithEcho.wait();
+    assert(processWithEcho.exitCode().value() == 0);
+  }
+  {
+    //! the process exits without reading its stdin
+    const auto executableWithSleep = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"192"},
+    };
+    auto createdWithSleep = cu0::Process::create(executableWithSleep);
+    assert(std::holds_alternative<cu0::Process>(createdWithSleep));
+    auto& processWithSleep = std::get<cu0::Process>(createdWithSleep);
+    const auto [outStr, errStr, writeError, readError] =
+        processWithSleep.communicateCautious(
+            std::string(LARGE_OUTPUT_SIZE, 'x')
+        );
+    assert(writeError == cu0::Process::WriteError::PIPE);
+    assert(readError == cu0::Process::ReadError::NO_ERROR);
+    assert(outStr.empty());
+    processWithSleep.wait();
+    assert(processWithSleep.exitCode().value() == 0);
+  }
+#else
+#warning <fcntl.h> or <poll.h> or <signal.h> is not found => \
+    cu0::Process::communicate() will not be checked
+#endif
 #else
 #warning <unistd.h> is not found => \
     cu0::Process::stdout() will not be checked
@@ -906,5 +1330,746 @@ int main(int argc, char** argv) {
     cu0::Process::terminationCode() will not be checked
 #endif
 
+#ifdef __unix__
+#if __has_include(<signal.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>) && __has_include(<poll.h>)
+  struct ProcessWithoutPidfdCheck : public cu0::Process {
+    ProcessWithoutPidfdCheck(cu0::Process&& other) {
+      this->swap(std::move(other));
+      ::close(this->pidfd_);
+      this->pidfd_ = -1;
+    }
+  };
+  {
+    const auto executableWithSleep = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"128"},
+    };
+    auto createdWithSleep = cu0::Process::create(executableWithSleep);
+    assert(std::holds_alternative<cu0::Process>(createdWithSleep));
+    auto& processWithSleep = std::get<cu0::Process>(createdWithSleep);
+    const auto start = std::chrono::steady_clock::now();
+    const auto cpuStart = std::clock();
+    assert(
+        processWithSleep.waitFor(std::chrono::milliseconds{200}) ==
+            cu0::Process::WaitError::TIMEDOUT
+    );
+    const auto cpuEnd = std::clock();
+    const auto end = std::chrono::steady_clock::now();
+    assert(end - start >= std::chrono::milliseconds{200});
+    assert(end - start < std::chrono::seconds{SLEEP_DURATION} / 2);
+    //! the wait sleeps instead of spinning
+    assert(
+        static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC < 0.1
+    );
+    assert(!processWithSleep.exitCode().has_value());
+    assert(!processWithSleep.terminationCode().has_value());
+    processWithSleep.terminate(std::chrono::seconds{SLEEP_DURATION});
+    assert(processWithSleep.terminationCode().value() == SIGTERM);
+  }
+  {
+    const auto executableWithShortSleep = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"192"},
+    };
+    auto createdWithShortSleep =
+        cu0::Process::create(executableWithShortSleep);
+    assert(std::holds_alternative<cu0::Process>(createdWithShortSleep));
+    auto& processWithShortSleep =
+        std::get<cu0::Process>(createdWithShortSleep);
+    assert(
+        processWithShortSleep.waitUntil(
+            std::chrono::system_clock::now() +
+                std::chrono::seconds{SLEEP_DURATION}
+        ) == cu0::Process::WaitError::NO_ERROR
+    );
+    assert(processWithShortSleep.exitCode().value() == 0);
+    //! a waited process is not signalled again
+    assert(
+        processWithShortSleep.terminateCautious(std::chrono::seconds{
+          SLEEP_DURATION
+        }) == cu0::Process::WaitError::NO_ERROR
+    );
+    assert(processWithShortSleep.exitCode().value() == 0);
+    assert(!processWithShortSleep.terminationCode().has_value());
+    //! no process => the process group of this process is not signalled
+    const auto moved = std::move(processWithShortSleep);
+    assert(moved.exitCode().value() == 0);
+    assert(
+        processWithShortSleep.terminateCautious(std::chrono::seconds{
+          SLEEP_DURATION
+        }) == cu0::Process::WaitError::CHILD
+    );
+  }
+  {
+    const auto executableIgnoringTerm = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"176"},
+    };
+    auto createdIgnoringTerm = cu0::Process::create(executableIgnoringTerm);
+    assert(std::holds_alternative<cu0::Process>(createdIgnoringTerm));
+    auto& processIgnoringTerm = std::get<cu0::Process>(createdIgnoringTerm);
+    //! wait until SIGTERM is ignored
+    processIgnoringTerm.stdoutLines([](std::string_view) { return false; });
+    const auto start = std::chrono::steady_clock::now();
+    assert(
+        processIgnoringTerm.terminateCautious(std::chrono::milliseconds{200}) ==
+            cu0::Process::WaitError::NO_ERROR
+    );
+    const auto end = std::chrono::steady_clock::now();
+    assert(end - start >= std::chrono::milliseconds{200});
+    assert(end - start < std::chrono::seconds{SLEEP_DURATION} / 2);
+    assert(processIgnoringTerm.terminationCode().value() == SIGKILL);
+  }
+  {
+    //! without the process file descriptor waitpid(WNOHANG) is polled
+    const auto executableWithSleep = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"128"},
+    };
+    auto createdWithSleep = cu0::Process::create(executableWithSleep);
+    assert(std::holds_alternative<cu0::Process>(createdWithSleep));
+    auto processWithSleep = ProcessWithoutPidfdCheck{
+      std::move(std::get<cu0::Process>(createdWithSleep))
+    };
+    assert(processWithSleep.pidfd() == -1);
+    assert(
+        processWithSleep.waitFor(std::chrono::milliseconds{100}) ==
+            cu0::Process::WaitError::TIMEDOUT
+    );
+    assert(
+        processWithSleep.terminateCautious(std::chrono::seconds{
+          SLEEP_DURATION
+        }) == cu0::Process::WaitError::NO_ERROR
+    );
+    assert(processWithSleep.terminationCode().value() == SIGTERM);
+    assert(
+        processWithSleep.waitFor(std::chrono::milliseconds{100}) ==
+            cu0::Process::WaitError::CHILD
+    );
+    assert(
+        processWithSleep.terminateCautious(std::chrono::seconds{
+          SLEEP_DURATION
+        }) == cu0::Process::WaitError::NO_ERROR
+    );
+    assert(processWithSleep.terminationCode().value() == SIGTERM);
+  }
+  {
+    auto processes = std::vector<cu0::Process>{};
+    for (const auto& argument : { "192", "5", "192", }) {
+      auto created = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { argument, },
+      });
+      assert(std::holds_alternative<cu0::Process>(created));
+      processes.push_back(std::get<cu0::Process>(std::move(created)));
+    }
+    //! the last process is waited by polling waitpid(WNOHANG)
+    processes.back() = ProcessWithoutPidfdCheck{std::move(processes.back())};
+    assert(processes.back().pidfd() == -1);
+    const auto first = cu0::Process::waitAny(processes);
+    assert(std::holds_alternative<std::size_t>(first));
+    assert(std::get<std::size_t>(first) == 1);
+    assert(processes[1].exitCode().value() == 5);
+    auto rest = std::vector<std::size_t>{};
+    for (auto i = 0; i < 2; i++) {
+      const auto next = cu0::Process::waitAny(processes);
+      assert(std::holds_alternative<std::size_t>(next));
+      rest.push_back(std::get<std::size_t>(next));
+      assert(processes[rest.back()].exitCode().value() == 0);
+    }
+    std::sort(rest.begin(), rest.end());
+    assert((rest == std::vector<std::size_t>{ 0, 2, }));
+    const auto none = cu0::Process::waitAny(processes);
+    assert(std::holds_alternative<cu0::Process::WaitError>(none));
+    assert(
+        std::get<cu0::Process::WaitError>(none) ==
+            cu0::Process::WaitError::CHILD
+    );
+  }
+  {
+    constexpr auto N = 32;
+    auto processes = std::vector<cu0::Process>{};
+    for (auto i = 0; i < N; i++) {
+      auto created = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { std::to_string(i), },
+      });
+      assert(std::holds_alternative<cu0::Process>(created));
+      processes.push_back(std::get<cu0::Process>(std::move(created)));
+    }
+    processes[0] = ProcessWithoutPidfdCheck{std::move(processes[0])};
+    assert(
+        cu0::Process::waitAll(processes) == cu0::Process::WaitError::NO_ERROR
+    );
+    for (auto i = 0; i < N; i++) {
+      assert(processes[i].exitCode().value() == i);
+    }
+    assert(
+        cu0::Process::waitAll(processes) == cu0::Process::WaitError::NO_ERROR
+    );
+  }
+  {
+    auto processes = std::vector<cu0::Process>{};
+    for (const auto& argument : { "7", "128", }) {
+      auto created = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { argument, },
+      });
+      assert(std::holds_alternative<cu0::Process>(created));
+      processes.push_back(std::get<cu0::Process>(std::move(created)));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    assert(
+        cu0::Process::waitAllUntil(
+            processes, start + std::chrono::milliseconds{300}
+        ) == cu0::Process::WaitError::TIMEDOUT
+    );
+    const auto end = std::chrono::steady_clock::now();
+    assert(end - start >= std::chrono::milliseconds{300});
+    assert(end - start < std::chrono::seconds{SLEEP_DURATION} / 2);
+    //! the process which exited before the deadline has been waited
+    assert(processes[0].exitCode().value() == 7);
+    assert(!processes[1].exitCode().has_value());
+    processes[1].terminate(std::chrono::seconds{SLEEP_DURATION});
+    assert(
+        cu0::Process::waitAllUntil(
+            processes, std::chrono::steady_clock::now()
+        ) == cu0::Process::WaitError::NO_ERROR
+    );
+  }
+#if __has_include(<sys/resource.h>)
+  for (const auto withPidfd : { true, false, }) {
+    const auto executableBusy = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"144"},
+    };
+    auto createdBusy = cu0::Process::create(executableBusy);
+    assert(std::holds_alternative<cu0::Process>(createdBusy));
+    auto processBusy = std::get<cu0::Process>(std::move(createdBusy));
+    if (!withPidfd) { //! waited by wait4()
+      processBusy = ProcessWithoutPidfdCheck{std::move(processBusy)};
+    }
+    assert(!processBusy.resourceUsage().has_value());
+    processBusy.wait();
+    assert(processBusy.exitCode().value() == 0);
+    assert(processBusy.resourceUsage().has_value());
+    const auto& usage = processBusy.resourceUsage().value();
+    //! a part of the time may be accounted to the kernel
+    assert(
+        usage.userTime + usage.systemTime >= std::chrono::milliseconds{200}
+    );
+    assert(
+        usage.maxResidentSetSize >=
+            static_cast<long>(LARGE_OUTPUT_SIZE * 64 / 1024)
+    );
+    assert(
+        usage.minorPageFaults >=
+            static_cast<long>(LARGE_OUTPUT_SIZE * 64 / ::getpagesize() / 2)
+    );
+    assert(usage.voluntaryContextSwitches >= 0);
+    assert(usage.involuntaryContextSwitches >= 0);
+  }
+#else
+#warning <sys/resource.h> is not found => \
+    cu0::Process::resourceUsage() will not be checked
+#endif
+#else
+#warning <signal.h> or <sys/types.h> or <sys/wait.h> or <poll.h> is not \
+    found => cu0::Process::waitFor() and cu0::Process::waitUntil() and \
+    cu0::Process::terminate() and cu0::Process::waitAny() and \
+    cu0::Process::waitAll() will not be checked
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::Process::waitFor() and cu0::Process::waitUntil() and \
+    cu0::Process::terminate() and cu0::Process::waitAny() and \
+    cu0::Process::waitAll() will not be checked
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  {
+    //! reads until the end of the file
+    const auto readAll = [](const int& fd) {
+      auto ret = std::string{};
+      char buffer[256];
+      ssize_t bytes;
+      while ((bytes = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        ret.append(buffer, bytes);
+      }
+      return ret;
+    };
+    const auto path = std::filesystem::temp_directory_path() /
+        ("check_cu0_process_" + std::to_string(::getpid()));
+    for (
+        const auto& strategy : {
+          cu0::Process::SpawnStrategy::VFORK,
+          cu0::Process::SpawnStrategy::FORK,
+          cu0::Process::SpawnStrategy::POSIX_SPAWN,
+          cu0::Process::SpawnStrategy::CLONE,
+        }
+    ) {
+      //! only the stdout pipe is created, stdin reads nothing
+      auto createdWithNull = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"224"}, },
+          cu0::Stdio{
+            .in = cu0::Redirection::null(),
+            .err = cu0::Redirection::null(),
+          },
+          strategy
+      );
+      if (std::holds_alternative<cu0::Process::CreateError>(createdWithNull)) {
+        //! the strategy may be not supported by the platform
+        assert(
+            std::get<cu0::Process::CreateError>(createdWithNull) ==
+                cu0::Process::CreateError::NOSYS
+        );
+        continue;
+      }
+      auto& processWithNull = std::get<cu0::Process>(createdWithNull);
+      assert(processWithNull.stdinPipe() == -1);
+      assert(processWithNull.stdoutPipe() >= 0);
+      assert(processWithNull.stderrPipe() == -1);
+      assert(processWithNull.stdout() == "0");
+      processWithNull.wait();
+      assert(processWithNull.exitCode().value() == 0);
+      //! stdout and the merged stderr go to the file
+      auto createdWithFile = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"7"}, },
+          cu0::Stdio{
+            .in = cu0::Redirection::null(),
+            .out = cu0::Redirection::file(path),
+            .err = cu0::Redirection::toStdout(),
+          },
+          strategy
+      );
+      assert(std::holds_alternative<cu0::Process>(createdWithFile));
+      auto& processWithFile = std::get<cu0::Process>(createdWithFile);
+      assert(processWithFile.stdoutPipe() == -1);
+      assert(processWithFile.stderrPipe() == -1);
+      processWithFile.wait();
+      assert(processWithFile.exitCode().value() == 7);
+      {
+        auto file = std::ifstream{path};
+        auto content = std::string{};
+        std::getline(file, content);
+        assert(content == "777");
+      }
+      //! appended with the specified flags
+      auto createdWithAppend = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"8"}, },
+          cu0::Stdio{
+            .out = cu0::Redirection::file(path, O_WRONLY | O_APPEND),
+            .err = cu0::Redirection::null(),
+          },
+          strategy
+      );
+      assert(std::holds_alternative<cu0::Process>(createdWithAppend));
+      std::get<cu0::Process>(createdWithAppend).wait();
+      {
+        auto file = std::ifstream{path};
+        auto content = std::string{};
+        std::getline(file, content);
+        assert(content == "7778");
+      }
+      //! extra file descriptors overlapping each other are swapped
+      int xFd[2];
+      int yFd[2];
+      assert(::pipe2(xFd, O_CLOEXEC) == 0);
+      assert(::pipe2(yFd, O_CLOEXEC) == 0);
+      const auto x = ::fcntl(xFd[1], F_DUPFD_CLOEXEC, 64);
+      const auto y = ::fcntl(yFd[1], F_DUPFD_CLOEXEC, 64);
+      ::close(xFd[1]);
+      ::close(yFd[1]);
+      auto createdWithFds = cu0::Process::create(
+          cu0::Executable{
+            .binary = argv[0],
+            .arguments = { "96", std::to_string(x), std::to_string(y), },
+          },
+          cu0::Stdio{
+            .in = cu0::Redirection::null(),
+            .out = cu0::Redirection::null(),
+            .err = cu0::Redirection::null(),
+            .fds = { { x, y, }, { y, x, }, },
+          },
+          strategy
+      );
+      ::close(x);
+      ::close(y);
+      assert(std::holds_alternative<cu0::Process>(createdWithFds));
+      auto& processWithFds = std::get<cu0::Process>(createdWithFds);
+      processWithFds.wait();
+      assert(processWithFds.exitCode().value() == 0);
+      assert(readAll(xFd[0]) == "y");
+      assert(readAll(yFd[0]) == "x");
+      ::close(xFd[0]);
+      ::close(yFd[0]);
+      //! an existing file descriptor becomes stdout
+      int outFd[2];
+      assert(::pipe2(outFd, O_CLOEXEC) == 0);
+      auto createdWithFd = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"9"}, },
+          cu0::Stdio{
+            .out = cu0::Redirection::fd(outFd[1]),
+            .err = cu0::Redirection::fd(outFd[1]),
+          },
+          strategy
+      );
+      ::close(outFd[1]);
+      assert(std::holds_alternative<cu0::Process>(createdWithFd));
+      std::get<cu0::Process>(createdWithFd).wait();
+      assert(readAll(outFd[0]) == "999");
+      ::close(outFd[0]);
+      //! a closed file descriptor is not silently left out
+      //!     @note placed high => not reused by the created pipes
+      const auto closedFd = ::fcntl(0, F_DUPFD_CLOEXEC, 512);
+      assert(closedFd >= 0);
+      ::close(closedFd);
+      auto createdWithClosed = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"0"}, },
+          cu0::Stdio{ .out = cu0::Redirection::fd(closedFd), },
+          strategy
+      );
+      if (strategy == cu0::Process::SpawnStrategy::POSIX_SPAWN) {
+        assert(
+            std::get<cu0::Process::CreateError>(createdWithClosed) ==
+                static_cast<cu0::Process::CreateError>(EBADF)
+        );
+      } else {
+        auto& processWithClosed = std::get<cu0::Process>(createdWithClosed);
+        processWithClosed.wait();
+        assert(processWithClosed.exitCode().value() == EBADF);
+      }
+    }
+    std::filesystem::remove(path);
+    for (
+        const auto& stdio : {
+          cu0::Stdio{ .in = cu0::Redirection::toStdout() },
+          cu0::Stdio{ .out = cu0::Redirection::toStdout() },
+          cu0::Stdio{ .err = cu0::Redirection::fd(-1) },
+          cu0::Stdio{ .fds = { { -1, 0, }, } },
+        }
+    ) {
+      const auto created = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"0"}, }, stdio
+      );
+      assert(std::holds_alternative<cu0::Process::CreateError>(created));
+      assert(
+          std::get<cu0::Process::CreateError>(created) ==
+              cu0::Process::CreateError::INVAL
+      );
+    }
+    const auto createdMissing = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = {"0"}, },
+        cu0::Stdio{ .in = cu0::Redirection::file(path / "missing") }
+    );
+    assert(
+        std::holds_alternative<cu0::Process::CreateError>(createdMissing)
+    );
+  }
+#else
+#warning <unistd.h> or <fcntl.h> or <sys/types.h> or <sys/wait.h> is not \
+    found => cu0::Process::create() with cu0::Stdio will not be checked
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::Process::create() with cu0::Stdio will not be checked
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+  {
+    const auto path = std::filesystem::temp_directory_path() /
+        ("check_cu0_process_splice_" + std::to_string(::getpid()));
+    const auto expected = std::string("a\0b", 3) +
+        std::string(LARGE_OUTPUT_SIZE, 'x');
+    const auto contentOf = [&path]() {
+      auto file = std::ifstream{path, std::ios::binary};
+      return std::string{
+        std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}
+      };
+    };
+    const auto executableWithBinaryOutput = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"208"},
+    };
+    //! older kernels do not splice() to O_APPEND => read() + write() are used
+    for (const auto& flags : { O_TRUNC, O_APPEND, }) {
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto fd = ::open(
+          path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | flags, 0666
+      );
+      assert(fd >= 0);
+      const auto [moved, readError, writeError] = process.stdoutTo(fd);
+      ::close(fd);
+      assert(moved == expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      assert(contentOf() == expected);
+      assert(process.stderr() == std::string(1, '\0'));
+      std::filesystem::remove(path);
+      process.wait();
+    }
+    {
+      //! a non-blocking stdout is waited instead of failing
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto flags = ::fcntl(process.stdoutPipe(), F_GETFL);
+      ::fcntl(process.stdoutPipe(), F_SETFL, flags | O_NONBLOCK);
+      const auto fd = ::open(
+          path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | O_TRUNC, 0666
+      );
+      assert(fd >= 0);
+      const auto [moved, readError, writeError] = process.stdoutTo(fd);
+      ::close(fd);
+      assert(moved == expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      assert(contentOf() == expected);
+      process.stderr();
+      process.wait();
+    }
+    {
+      //! an error of the file descriptor is not reported as a read error
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      assert(fd >= 0);
+      const auto [moved, readError, writeError] = process.stdoutTo(fd);
+      ::close(fd);
+      assert(moved == 0);
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::BADF);
+      process.closeStdin();
+      process.stdout();
+      process.stderr();
+      process.wait();
+      std::filesystem::remove(path);
+    }
+    //! the sink gets the same data as the file
+    for (const auto& flags : { O_TRUNC, O_APPEND, }) {
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto fd = ::open(
+          path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | flags, 0666
+      );
+      assert(fd >= 0);
+      auto copy = std::string{};
+      const auto [moved, readError, writeError] = process.stdoutTee(
+          fd,
+          [&copy](std::span<const std::byte> chunk) {
+            copy.append(
+                reinterpret_cast<const char*>(chunk.data()), chunk.size()
+            );
+          }
+      );
+      ::close(fd);
+      assert(moved == expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      assert(copy == expected);
+      assert(contentOf() == expected);
+      std::filesystem::remove(path);
+      process.wait();
+    }
+    {
+      //! tee() directly into a pipe
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      int fds[2];
+      assert(::pipe2(fds, O_CLOEXEC) == 0);
+      auto piped = std::string{};
+      auto reader = std::thread{[&piped, &fds]() {
+        char buffer[4096];
+        ssize_t bytes;
+        while ((bytes = ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+          piped.append(buffer, bytes);
+        }
+      }};
+      auto copied = std::size_t{0};
+      const auto [moved, readError, writeError] = process.stdoutTee(
+          fds[1],
+          [&copied](std::span<const std::byte> chunk) {
+            copied += chunk.size();
+          }
+      );
+      ::close(fds[1]);
+      reader.join();
+      ::close(fds[0]);
+      assert(moved == expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      assert(copied == expected.size());
+      assert(piped == expected);
+      process.wait();
+    }
+    {
+      //! the sink stops the transfer
+      auto created = cu0::Process::create(executableWithBinaryOutput);
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+      assert(fd >= 0);
+      auto calls = 0;
+      const auto [moved, readError, writeError] = process.stdoutTee(
+          fd,
+          [&calls](std::span<const std::byte>) {
+            calls++;
+            return false;
+          }
+      );
+      ::close(fd);
+      assert(calls == 1);
+      assert(moved > 0);
+      assert(moved < expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      process.closeStdin();
+      process.stdout();
+      process.wait();
+    }
+    {
+      //! a buffer larger than the stack of this thread is allocated
+      constexpr auto HUGE_BUFFER_SIZE = std::size_t{1} << 24;
+      auto teeCreated = cu0::Process::create(executableWithBinaryOutput);
+      auto& teeProcess = std::get<cu0::Process>(teeCreated);
+      const auto fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+      assert(fd >= 0);
+      auto teed = std::size_t{0};
+      const auto [moved, readError, writeError] =
+          teeProcess.stdoutTee<HUGE_BUFFER_SIZE>(
+              fd,
+              [&teed](std::span<const std::byte> chunk) {
+                teed += chunk.size();
+              }
+          );
+      ::close(fd);
+      assert(moved == expected.size());
+      assert(teed == expected.size());
+      assert(readError == cu0::Process::ReadError::NO_ERROR);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      teeProcess.wait();
+      auto chunksCreated = cu0::Process::create(executableWithBinaryOutput);
+      auto& chunksProcess = std::get<cu0::Process>(chunksCreated);
+      auto read = std::size_t{0};
+      assert(
+          chunksProcess.stdoutChunks<HUGE_BUFFER_SIZE>(
+              [&read](std::span<const std::byte> chunk) {
+                read += chunk.size();
+              }
+          ) == cu0::Process::ReadError::NO_ERROR
+      );
+      assert(read == expected.size());
+      chunksProcess.wait();
+    }
+    {
+      //! stderr is not piped
+      auto created = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"0"}, },
+          cu0::Stdio{ .err = cu0::Redirection::null() }
+      );
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto [moved, readError, writeError] =
+          process.stderrTo(STDOUT_FILENO);
+      assert(moved == 0);
+      assert(readError == cu0::Process::ReadError::BADF);
+      assert(writeError == cu0::Process::WriteError::NO_ERROR);
+      process.wait();
+    }
+  }
+#else
+#warning <unistd.h> or <fcntl.h> or <sys/stat.h> is not found => \
+    cu0::Process::stdoutTo() and cu0::Process::stdoutTee() will not be checked
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutTo() and cu0::Process::stdoutTee() will not be checked
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  {
+    const auto input = std::string(LARGE_OUTPUT_SIZE * 4 + 123, 'i');
+    //! the input is in a sealed file => it can be sought
+    auto createdWithMemory = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = {"80"}, },
+        cu0::Stdio{ .in = cu0::Redirection::memory(input) }
+    );
+    assert(std::holds_alternative<cu0::Process>(createdWithMemory));
+    auto& processWithMemory = std::get<cu0::Process>(createdWithMemory);
+    assert(processWithMemory.stdinPipe() == -1);
+    assert(
+        processWithMemory.stdout() ==
+            std::to_string(input.size()) + " sealed"
+    );
+    processWithMemory.wait();
+    auto createdWithMemoryRead = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = {"224"}, },
+        cu0::Stdio{ .in = cu0::Redirection::memory(input) }
+    );
+    assert(std::holds_alternative<cu0::Process>(createdWithMemoryRead));
+    auto& processWithMemoryRead =
+        std::get<cu0::Process>(createdWithMemoryRead);
+    assert(processWithMemoryRead.stdout() == std::to_string(input.size()));
+    processWithMemoryRead.wait();
+    //! an in-memory file is supported for stdin only
+    const auto createdWithMemoryOut = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = {"0"}, },
+        cu0::Stdio{ .out = cu0::Redirection::memory(input) }
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(createdWithMemoryOut) ==
+            cu0::Process::CreateError::INVAL
+    );
+    //! the pages of the input are passed to the pipe
+    for (const auto& offset : { 0, 1, 4095, }) {
+      auto created = cu0::Process::create(
+          cu0::Executable{ .binary = argv[0], .arguments = {"224"}, }
+      );
+      assert(std::holds_alternative<cu0::Process>(created));
+      auto& process = std::get<cu0::Process>(created);
+      const auto view = std::string_view{input}.substr(offset);
+      const auto [error, bytes] = process.stdinSplicedCautious(view);
+      assert(error == cu0::Process::WriteError::NO_ERROR);
+      assert(bytes == view.size());
+      process.closeStdin();
+      assert(process.stdout() == std::to_string(view.size()));
+      process.wait();
+    }
+    auto createdSpliced = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = {"224"}, }
+    );
+    assert(std::holds_alternative<cu0::Process>(createdSpliced));
+    auto& processSpliced = std::get<cu0::Process>(createdSpliced);
+    processSpliced.stdinSpliced(std::as_bytes(std::span{input}));
+    processSpliced.closeStdin();
+    assert(processSpliced.stdout() == std::to_string(input.size()));
+    processSpliced.wait();
+    const auto [error, bytes] = processSpliced.stdinSplicedCautious(input);
+    assert(error == cu0::Process::WriteError::BADF);
+    assert(bytes == 0);
+  }
+#else
+#warning <unistd.h> or <fcntl.h> or <sys/uio.h> is not found => \
+    cu0::Redirection::memory() and cu0::Process::stdinSpliced() will not be \
+    checked
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::Redirection::memory() and cu0::Process::stdinSpliced() will not be \
+    checked
+#endif
+
   return 0;
 }
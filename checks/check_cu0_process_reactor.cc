@@ -0,0 +1,257 @@
+#include <cu0/proc/process_reactor.hh>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+#endif
+
+int main(int argc, char** argv) {
+
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "64") {
+      std::string input;
+      std::cin >> input;
+      std::cout << input;
+      std::cerr << input << input;
+      return std::stoi(argv[1]);
+    }
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+    if (std::string{argv[1]} == "descendant") {
+      //! the descendant keeps stdout opened after the exit
+      std::cout << "early" << std::flush;
+      if (::fork() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        std::cout << "late" << std::flush;
+        std::_Exit(0);
+      }
+      return 5;
+    }
+#endif
+#endif
+    std::cout << argv[1];
+    std::cerr << argv[1] << argv[1];
+    return std::stoi(argv[1]);
+  }
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  {
+    auto created = cu0::ProcessReactor::create();
+    assert(std::holds_alternative<cu0::ProcessReactor>(created));
+    auto& reactor = std::get<cu0::ProcessReactor>(created);
+    assert(reactor.size() == 0);
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+
+    constexpr auto N = 64;
+    struct Output {
+      std::string out{};
+      std::string err{};
+      bool exited = false;
+    };
+    auto processes = std::list<cu0::Process>{};
+    auto outputs = std::array<Output, N>{};
+    for (auto i = 0; i < N; i++) {
+      auto createdProcess = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { std::to_string(i), },
+      });
+      assert(std::holds_alternative<cu0::Process>(createdProcess));
+      auto& process = processes.emplace_back(
+          std::get<cu0::Process>(std::move(createdProcess))
+      );
+      auto& output = outputs[i];
+      assert(
+          reactor.add(process, {
+            .onStdout = [&output](
+                cu0::Process&,
+                std::span<const std::byte> data
+            ) {
+              output.out.append(
+                  reinterpret_cast<const char*>(data.data()), data.size()
+              );
+            },
+            .onStderr = [&output](
+                cu0::Process&,
+                std::span<const std::byte> data
+            ) {
+              output.err.append(
+                  reinterpret_cast<const char*>(data.data()), data.size()
+              );
+            },
+            .onExit = [&output](cu0::Process&) {
+              output.exited = true;
+            },
+          }) == cu0::ProcessReactor::AddError::NO_ERROR
+      );
+      assert(
+          reactor.add(process, {}) == cu0::ProcessReactor::AddError::EXIST
+      );
+    }
+    assert(reactor.size() == N);
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+    assert(reactor.size() == 0);
+    auto i = 0;
+    for (const auto& process : processes) {
+      assert(outputs[i].exited);
+      assert(process.exitCode().value() == i);
+      assert(outputs[i].out == std::to_string(i));
+      assert(outputs[i].err == std::to_string(i) + std::to_string(i));
+      i++;
+    }
+  }
+  {
+    auto created = cu0::ProcessReactor::create(2);
+    assert(std::holds_alternative<cu0::ProcessReactor>(created));
+    auto reactor = std::get<cu0::ProcessReactor>(std::move(created));
+    auto createdProcess = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "64", },
+    });
+    assert(std::holds_alternative<cu0::Process>(createdProcess));
+    auto& process = std::get<cu0::Process>(createdProcess);
+    auto out = std::string{};
+    auto chunks = 0;
+    auto exitCode = -1;
+    assert(
+        reactor.add(process, {
+          .onStdout = [&out, &chunks](
+              cu0::Process&,
+              std::span<const std::byte> d
+          ) {
+            //! the buffer size bounds the size of a chunk
+            assert(d.size() <= 2);
+            out.append(reinterpret_cast<const char*>(d.data()), d.size());
+            chunks++;
+          },
+          .onStdinWritable = [](cu0::Process& process) {
+            process.stdin("4096\n");
+            process.closeStdin();
+            return false;
+          },
+          .onExit = [&exitCode](cu0::Process& process) {
+            exitCode = process.exitCode().value();
+          },
+        }) == cu0::ProcessReactor::AddError::NO_ERROR
+    );
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+    assert(out == "4096");
+    assert(chunks == 2);
+    assert(exitCode == 64);
+  }
+  {
+    auto created = cu0::ProcessReactor::create();
+    assert(std::holds_alternative<cu0::ProcessReactor>(created));
+    auto& reactor = std::get<cu0::ProcessReactor>(created);
+    auto createdProcess = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "1", },
+    });
+    assert(std::holds_alternative<cu0::Process>(createdProcess));
+    auto& process = std::get<cu0::Process>(createdProcess);
+    auto exited = false;
+    assert(
+        reactor.add(process, {
+          .onExit = [&exited](cu0::Process&) {
+            exited = true;
+          },
+        }) == cu0::ProcessReactor::AddError::NO_ERROR
+    );
+    reactor.remove(process);
+    assert(reactor.size() == 0);
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+    assert(!exited);
+    process.wait();
+    assert(process.exitCode().value() == 1);
+  }
+  {
+    //! output written after the exit by a descendant is dispatched
+    //!     before the exit
+    auto created = cu0::ProcessReactor::create();
+    auto& reactor = std::get<cu0::ProcessReactor>(created);
+    auto createdProcess = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "descendant", },
+    });
+    auto& process = std::get<cu0::Process>(createdProcess);
+    auto out = std::string{};
+    auto outAtExit = std::string{};
+    assert(
+        reactor.add(process, {
+          .onStdout = [&out](cu0::Process&, std::span<const std::byte> d) {
+            out.append(reinterpret_cast<const char*>(d.data()), d.size());
+          },
+          .onExit = [&out, &outAtExit](cu0::Process&) {
+            outAtExit = out;
+          },
+        }) == cu0::ProcessReactor::AddError::NO_ERROR
+    );
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+    assert(out == "earlylate");
+    assert(outAtExit == "earlylate");
+    assert(process.exitCode().value() == 5);
+  }
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+  {
+    //! without the process file descriptor and output pipes
+    //!     the exit cannot be detected => the process is not added
+    auto created = cu0::ProcessReactor::create();
+    auto& reactor = std::get<cu0::ProcessReactor>(created);
+    rlimit previous;
+    assert(::getrlimit(RLIMIT_NOFILE, &previous) == 0);
+    auto lowered = previous;
+    lowered.rlim_cur = 64;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    //! no file descriptor is left for pidfd_open()
+    auto occupied = std::vector<int>{};
+    for (auto fd = ::dup(0); fd >= 0; fd = ::dup(0)) {
+      occupied.push_back(fd);
+    }
+    auto createdProcess = cu0::Process::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "3", }, },
+        cu0::Stdio{
+          .in = cu0::Redirection::inherit(),
+          .out = cu0::Redirection::inherit(),
+          .err = cu0::Redirection::inherit(),
+        }
+    );
+    for (const auto& fd : occupied) {
+      ::close(fd);
+    }
+    assert(::setrlimit(RLIMIT_NOFILE, &previous) == 0);
+    auto& process = std::get<cu0::Process>(createdProcess);
+    assert(process.pidfd() < 0);
+    assert(
+        reactor.add(process, { .onExit = [](cu0::Process&) {}, }) ==
+            cu0::ProcessReactor::AddError::BADF
+    );
+    assert(reactor.size() == 0);
+    assert(reactor.run() == cu0::ProcessReactor::RunError::NO_ERROR);
+    process.wait();
+    assert(process.exitCode().value() == 3);
+  }
+#else
+#warning <fcntl.h> or <sys/resource.h> is not found => \
+    cu0::ProcessReactor without process file descriptors will not be checked
+#endif
+#else
+#warning <sys/epoll.h> or <unistd.h> or <sys/types.h> or <sys/wait.h> is not \
+    found => cu0::ProcessReactor will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::ProcessReactor will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#include <cu0/proc/process_reaper.hh>
+#include <cassert>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+int main(int argc, char** argv) {
+
+  constexpr auto SLEEP_DURATION = 8; //! [s]
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "sleep") {
+      std::this_thread::sleep_for(std::chrono::seconds{SLEEP_DURATION});
+      return 0;
+    }
+    return std::stoi(argv[1]);
+  }
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<sys/eventfd.h>) && \
+    __has_include(<unistd.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+  {
+    auto created = cu0::ProcessReaper::create();
+    assert(std::holds_alternative<cu0::ProcessReaper>(created));
+    auto& reaper = std::get<cu0::ProcessReaper>(created);
+    assert(reaper.size() == 0);
+    reaper.drain();
+
+    constexpr auto N = 256;
+    auto exitCodes = std::array<int, N + 1>{};
+    exitCodes.fill(-1);
+    auto count = std::atomic<int>{0};
+    for (auto i = 0; i < N; i++) {
+      auto createdProcess = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { std::to_string(i % 128), },
+      });
+      assert(std::holds_alternative<cu0::Process>(createdProcess));
+      assert(
+          reaper.adopt(
+              std::get<cu0::Process>(std::move(createdProcess)),
+              [&exitCodes, &count, &reaper, &argv, i](cu0::Process& process) {
+                exitCodes[i] = process.exitCode().value();
+                count++;
+                if (i == 0) { //! adopting from a callback
+                  auto another = cu0::Process::create(cu0::Executable{
+                    .binary = argv[0],
+                    .arguments = { "3", },
+                  });
+                  assert(std::holds_alternative<cu0::Process>(another));
+                  assert(
+                      reaper.adopt(
+                          std::get<cu0::Process>(std::move(another)),
+                          [&exitCodes, &count](cu0::Process& process) {
+                            exitCodes[N] = process.exitCode().value();
+                            count++;
+                          }
+                      ) == cu0::ProcessReaper::AdoptError::NO_ERROR
+                  );
+                }
+              }
+          ) == cu0::ProcessReaper::AdoptError::NO_ERROR
+      );
+    }
+    reaper.drain();
+    assert(reaper.size() == 0);
+    assert(count == N + 1);
+    for (auto i = 0; i < N; i++) {
+      assert(exitCodes[i] == i % 128);
+    }
+    assert(exitCodes[N] == 3);
+
+    //! a process without the process file descriptor is rejected
+    struct ProcessCheck : public cu0::Process {
+      constexpr ProcessCheck() = default;
+    };
+    auto withoutPidfd = ProcessCheck{};
+    assert(
+        reaper.adopt(std::move(withoutPidfd)) ==
+            cu0::ProcessReaper::AdoptError::BADF
+    );
+  }
+  {
+    auto* reaper = cu0::ProcessReaper::global();
+    assert(reaper != nullptr);
+    assert(reaper == cu0::ProcessReaper::global());
+    auto createdProcess = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "7", },
+    });
+    assert(std::holds_alternative<cu0::Process>(createdProcess));
+    auto exitCode = std::atomic<int>{-1};
+    assert(
+        reaper->adopt(
+            std::get<cu0::Process>(std::move(createdProcess)),
+            [&exitCode](cu0::Process& process) {
+              exitCode = process.exitCode().value();
+            }
+        ) == cu0::ProcessReaper::AdoptError::NO_ERROR
+    );
+    reaper->drain();
+    assert(exitCode == 7);
+  }
+  {
+    //! the destructor does not wait for running processes
+    auto pid = pid_t{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+      auto created = cu0::ProcessReaper::create();
+      assert(std::holds_alternative<cu0::ProcessReaper>(created));
+      auto moved = std::get<cu0::ProcessReaper>(std::move(created));
+      auto createdProcess = cu0::Process::create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { "sleep", },
+      });
+      assert(std::holds_alternative<cu0::Process>(createdProcess));
+      pid = std::get<cu0::Process>(createdProcess).pid();
+      assert(
+          moved.adopt(std::get<cu0::Process>(std::move(createdProcess))) ==
+              cu0::ProcessReaper::AdoptError::NO_ERROR
+      );
+      assert(moved.size() == 1);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    assert(end - start < std::chrono::seconds{SLEEP_DURATION} / 2);
+    ::kill(pid, SIGKILL);
+    ::waitpid(pid, nullptr, 0);
+  }
+  {
+    //! a moved-from reaper adopts nothing
+    auto created = cu0::ProcessReaper::create();
+    assert(std::holds_alternative<cu0::ProcessReaper>(created));
+    auto& movedFrom = std::get<cu0::ProcessReaper>(created);
+    const auto moved = std::move(movedFrom);
+    assert(movedFrom.size() == 0);
+    movedFrom.drain();
+    auto createdProcess = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "5", },
+    });
+    assert(std::holds_alternative<cu0::Process>(createdProcess));
+    auto& process = std::get<cu0::Process>(createdProcess);
+    assert(
+        movedFrom.adopt(std::move(process)) ==
+            cu0::ProcessReaper::AdoptError::INVAL
+    );
+    //! the process is left untouched
+    process.wait();
+    assert(process.exitCode().value() == 5);
+  }
+#else
+#warning <sys/epoll.h> or <sys/eventfd.h> or <unistd.h> or <sys/types.h> or \
+    <sys/wait.h> is not found => cu0::ProcessReaper will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::ProcessReaper will not be checked
+#endif
+
+  return 0;
+}
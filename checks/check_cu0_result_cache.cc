@@ -0,0 +1,173 @@
+#include <cu0/proc/result_cache.hh>
+#include <cassert>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<poll.h>) && \
+    __has_include(<signal.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "kill") {
+      ::raise(SIGKILL);
+    }
+    //! echoes the stdin and the argument, counts the executions in the file
+    auto file = std::ofstream{argv[1], std::ios::app};
+    file << '.' << std::flush;
+    std::cout << std::cin.rdbuf() << argv[2];
+    std::cerr << "err";
+    return 7;
+  }
+
+  using cu0::ResultCache;
+  assert(
+      ResultCache::hexOf(ResultCache::digestOf("")) ==
+          "e3b0c44298fc1c149afbf4c8996fb924" "27ae41e4649b934ca495991b7852b855"
+  );
+  assert(
+      ResultCache::hexOf(ResultCache::digestOf("abc")) ==
+          "ba7816bf8f01cfea414140de5dae2223" "b00361a396177a9cb410ff61f20015ad"
+  );
+  assert(
+      ResultCache::hexOf(
+          ResultCache::digestOf(
+              "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
+          )
+      ) ==
+          "248d6a61d20638b8e5c026930c3e6039" "a33ce45964ff2167f6ecedd419db06c1"
+  );
+
+  const auto base = std::filesystem::temp_directory_path() /
+      ("check_cu0_result_cache_" + std::to_string(::getpid()));
+  const auto counter = base / "counter";
+  //! reads the number of executions
+  const auto executions = [&counter]() {
+    auto file = std::ifstream{counter};
+    return std::string(std::istreambuf_iterator<char>{file}, {}).size();
+  };
+  {
+    //! a file is not a directory
+    std::filesystem::create_directories(base);
+    std::ofstream{base / "file"} << "";
+    const auto opened = ResultCache::open(base / "file");
+    assert(
+        std::get<ResultCache::OpenError>(opened) ==
+            ResultCache::OpenError::NOTDIR
+    );
+  }
+  auto opened = ResultCache::open(base / "cache");
+  assert(std::holds_alternative<ResultCache>(opened));
+  const auto& cache = std::get<ResultCache>(opened);
+  assert(cache.directory() == base / "cache");
+  const auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = { counter.string(), "a", },
+  };
+  {
+    //! executed on a miss, read on a hit
+    auto first = cache.run(executable, "in");
+    const auto& miss = std::get<ResultCache::Record>(first);
+    assert(!miss.cached());
+    assert(miss.exitCode().value() == 7);
+    assert(miss.out() == "ina");
+    assert(miss.err() == "err");
+    assert(executions() == 1);
+    auto second = cache.run(executable, "in");
+    auto hit = std::get<ResultCache::Record>(std::move(second));
+    assert(hit.cached());
+    assert(hit.exitCode().value() == 7);
+    assert(hit.out() == "ina");
+    assert(hit.err() == "err");
+    assert(executions() == 1);
+    //! a moved record keeps the mapping
+    const auto moved = std::move(hit);
+    assert(moved.cached());
+    assert(moved.out() == "ina");
+  }
+  {
+    //! everything passed to the process is a part of the key
+    const auto key = cache.keyOf(executable, "in").value();
+    assert(cache.keyOf(executable, "in").value() == key);
+    assert(cache.keyOf(executable, "i").value() != key);
+    auto other = executable;
+    other.arguments.back() = "b";
+    assert(cache.keyOf(other).value() != key);
+    other = executable;
+    other.environment["A"] = "1";
+    assert(cache.keyOf(other).value() != key);
+    //! sizes separate the values
+    auto joined = cu0::Executable{ .arguments = { "ab", "c", }, };
+    auto split = cu0::Executable{ .arguments = { "a", "bc", }, };
+    joined.binary = split.binary = argv[0];
+    assert(cache.keyOf(joined).value() != cache.keyOf(split).value());
+    //! the contents of the binary are a part of the key
+    const auto copy = base / "binary";
+    std::filesystem::copy_file(argv[0], copy);
+    other = executable;
+    other.binary = copy;
+    const auto copied = cache.keyOf(other, "in").value();
+    std::ofstream{copy, std::ios::app} << '\0';
+    assert(cache.keyOf(other, "in").value() != copied);
+    //! the path of the binary (argv[0]) is a part of the key =>
+    //!     links of a multi-call binary differ
+    const auto link = base / "link";
+    std::filesystem::create_hard_link(copy, link);
+    auto linked = other;
+    linked.binary = link;
+    assert(cache.keyOf(linked, "in").value() != cache.keyOf(other, "in"));
+    //! a missing binary has no key
+    other.binary = base / "missing";
+    assert(!cache.keyOf(other).has_value());
+  }
+  {
+    //! a stored result is found, a corrupted one is a miss
+    const auto key = cache.keyOf(executable, "stored").value();
+    assert(!cache.find(key).has_value());
+    assert(
+        cache.store(key, 3, "out", "") == ResultCache::StoreError::NO_ERROR
+    );
+    const auto found = cache.find(key);
+    assert(found.has_value());
+    assert(found->exitCode().value() == 3);
+    assert(found->out() == "out");
+    assert(found->err().empty());
+    const auto hex = ResultCache::hexOf(key);
+    std::filesystem::resize_file(
+        base / "cache" / hex.substr(0, 2) / hex.substr(2),
+        10
+    );
+    assert(!cache.find(key).has_value());
+  }
+  {
+    //! a process terminated by a signal is not stored
+    const auto killed = cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "kill", "", },
+    };
+    for (auto i = 0; i < 2; i++) {
+      auto ran = cache.run(killed);
+      const auto& record = std::get<ResultCache::Record>(ran);
+      assert(!record.cached());
+      assert(!record.exitCode().has_value());
+    }
+  }
+  std::filesystem::remove_all(base);
+#else
+#warning <fcntl.h> or <sys/mman.h> or <sys/stat.h> or <sys/uio.h> or \
+    <unistd.h> or <poll.h> or <signal.h> is not found => \
+    cu0::ResultCache will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::ResultCache will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,248 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/ring_buffer.hh>
+#include <cassert>
+#include <array>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<linux/futex.h>) && __has_include(<poll.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief accesses a byte of the checked data
+ * @param index is the index of the byte
+ * @return byte at the index
+ */
+std::byte patternAt(const std::size_t& index) {
+  return static_cast<std::byte>(index * 31 % 251);
+}
+
+/*!
+ * @brief The Scribbler struct exposes the layout of the shared memory
+ */
+struct Scribbler : cu0::RingBuffer {
+  using cu0::RingBuffer::Header;
+};
+#endif
+#endif
+
+int main(int argc, char** argv) {
+
+  constexpr auto LARGE_SIZE = std::size_t{64} << 20; //! [B]
+  constexpr auto CAPACITY = std::size_t{1} << 16; //! [B]
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<linux/futex.h>) && __has_include(<poll.h>) && \
+    __has_include(<unistd.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    auto attached = cu0::RingBuffer::attach();
+    if (!std::holds_alternative<cu0::RingBuffer>(attached)) {
+      return 1;
+    }
+    auto& ring = std::get<cu0::RingBuffer>(attached);
+    if (std::string{argv[1]} == "write") {
+      //! chunks of various sizes => the data wrap around at various offsets
+      const auto size = std::stoull(argv[2]);
+      auto chunk = std::vector<std::byte>(CAPACITY * 3);
+      auto i = std::size_t{0};
+      for (auto written = std::size_t{0}; written < size;) {
+        const auto n = std::min<std::size_t>(
+            size - written, (i++ * 7919) % chunk.size() + 1
+        );
+        for (auto j = std::size_t{0}; j < n; j++) {
+          chunk[j] = patternAt(written + j);
+        }
+        if (
+            ring.write(std::span{chunk}.first(n)) !=
+                cu0::RingBuffer::WriteError::NO_ERROR
+        ) {
+          return 2;
+        }
+        written += n;
+      }
+      ring.close();
+      return 0;
+    } else if (std::string{argv[1]} == "crash") {
+      ring.write("crash");
+      //! the destructor is not called => the ring buffer is not closed
+      ::_exit(0);
+    } else if (std::string{argv[1]} == "closed") {
+      //! the reader closes the ring buffer => the write fails
+      const auto data = std::string(CAPACITY * 4, 'x');
+      return ring.write(data) == cu0::RingBuffer::WriteError::PIPE ? 32 : 3;
+    }
+    return 4;
+  }
+
+  {
+    auto small = cu0::RingBuffer::create(1000);
+    assert(std::holds_alternative<cu0::RingBuffer>(small));
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    assert(std::get<cu0::RingBuffer>(small).capacity() == page);
+    auto odd = cu0::RingBuffer::create(page * 3);
+    assert(std::holds_alternative<cu0::RingBuffer>(odd));
+    assert(std::get<cu0::RingBuffer>(odd).capacity() == page * 4);
+    const auto huge = cu0::RingBuffer::create(std::size_t{1} << 41);
+    assert(std::holds_alternative<cu0::RingBuffer::CreateError>(huge));
+    assert(
+        std::get<cu0::RingBuffer::CreateError>(huge) ==
+            cu0::RingBuffer::CreateError::INVAL
+    );
+  }
+  {
+    //! a moved-from ring buffer is not used
+    auto created = cu0::RingBuffer::create(CAPACITY);
+    auto& movedFrom = std::get<cu0::RingBuffer>(created);
+    const auto moved = std::move(movedFrom);
+    assert(moved.capacity() == CAPACITY);
+    assert(movedFrom.capacity() == 0);
+    movedFrom.close();
+    assert(movedFrom.write("x") == cu0::RingBuffer::WriteError::PIPE);
+    auto buffer = std::array<std::byte, 1>{};
+    const auto [read, error] = movedFrom.read(buffer);
+    assert(read == 0);
+    assert(error == cu0::RingBuffer::ReadError::PIPE);
+  }
+  {
+    //! a header scribbled by the writer does not move reads past the mapping
+    auto created = cu0::RingBuffer::create(CAPACITY);
+    auto& ring = std::get<cu0::RingBuffer>(created);
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto* memory = ::mmap(
+        NULL, page + CAPACITY, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd(), 0
+    );
+    assert(memory != MAP_FAILED);
+    auto& header = *static_cast<Scribbler::Header*>(memory);
+    header.capacity = std::uint64_t{1} << 40;
+    header.head = (std::uint64_t{1} << 40) + 3;
+    header.writerClosed = 1;
+    assert(ring.capacity() == CAPACITY);
+    auto buffer = std::vector<std::byte>(CAPACITY * 2);
+    const auto [read, error] = ring.read(buffer);
+    assert(read == CAPACITY);
+    assert(error == cu0::RingBuffer::ReadError::NO_ERROR);
+    ::munmap(memory, page + CAPACITY);
+  }
+  {
+    const auto missing = cu0::RingBuffer::attach(-1);
+    assert(
+        std::get<cu0::RingBuffer::AttachError>(missing) ==
+            cu0::RingBuffer::AttachError::BADF
+    );
+    int fds[2];
+    assert(::pipe2(fds, O_CLOEXEC) == 0);
+    const auto notRing = cu0::RingBuffer::attach(fds[0]);
+    assert(
+        std::get<cu0::RingBuffer::AttachError>(notRing) ==
+            cu0::RingBuffer::AttachError::INVAL
+    );
+    ::close(fds[0]);
+    ::close(fds[1]);
+    ::unsetenv(cu0::RingBuffer::ENVIRONMENT_VARIABLE);
+    const auto withoutEnvironment = cu0::RingBuffer::attach();
+    assert(
+        std::get<cu0::RingBuffer::AttachError>(withoutEnvironment) ==
+            cu0::RingBuffer::AttachError::BADF
+    );
+  }
+  //! creates a process writing into a new ring buffer
+  const auto spawn = [&argv, &CAPACITY](
+      const std::vector<std::string>& arguments
+  ) {
+    auto createdRing = cu0::RingBuffer::create(CAPACITY);
+    assert(std::holds_alternative<cu0::RingBuffer>(createdRing));
+    auto ring = std::get<cu0::RingBuffer>(std::move(createdRing));
+    auto executable = cu0::Executable{
+      .binary = argv[0],
+      .arguments = arguments,
+    };
+    auto stdio = cu0::Stdio{};
+    ring.share(executable, stdio, 7);
+    assert(
+        executable.environment[cu0::RingBuffer::ENVIRONMENT_VARIABLE] == "7"
+    );
+    auto createdProcess = cu0::Process::create(executable, stdio);
+    assert(std::holds_alternative<cu0::Process>(createdProcess));
+    return std::make_tuple(
+        std::move(ring), std::get<cu0::Process>(std::move(createdProcess))
+    );
+  };
+  {
+    //! zero-copy chunks
+    auto [ring, process] = spawn({ "write", std::to_string(LARGE_SIZE), });
+    auto read = std::size_t{0};
+    auto equal = true;
+    const auto error = ring.readChunks(
+        [&read, &equal](std::span<const std::byte> chunk) {
+          for (const auto& byte : chunk) {
+            equal = equal && byte == patternAt(read++);
+          }
+        },
+        process.pidfd()
+    );
+    assert(error == cu0::RingBuffer::ReadError::NO_ERROR);
+    assert(read == LARGE_SIZE);
+    assert(equal);
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+  {
+    //! copies into a small buffer, the writer is not watched
+    auto [ring, process] = spawn({ "write", std::to_string(CAPACITY * 5), });
+    auto buffer = std::array<std::byte, 1000>{};
+    auto read = std::size_t{0};
+    while (true) {
+      const auto [bytes, error] = ring.read(buffer);
+      assert(error == cu0::RingBuffer::ReadError::NO_ERROR);
+      if (bytes == 0) {
+        break;
+      }
+      assert(bytes <= buffer.size());
+      for (auto i = std::size_t{0}; i < bytes; i++) {
+        assert(buffer[i] == patternAt(read + i));
+      }
+      read += bytes;
+    }
+    assert(read == CAPACITY * 5);
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+  {
+    //! the writer exits without closing
+    auto [ring, process] = spawn({ "crash", });
+    auto read = std::string{};
+    const auto error = ring.readChunks(
+        [&read](std::span<const std::byte> chunk) {
+          read.append(
+              reinterpret_cast<const char*>(chunk.data()), chunk.size()
+          );
+        },
+        process.pidfd()
+    );
+    assert(error == cu0::RingBuffer::ReadError::PIPE);
+    assert(read == "crash");
+    process.wait();
+  }
+  {
+    //! the reader is closed
+    auto [ring, process] = spawn({ "closed", });
+    ring.close();
+    process.wait();
+    assert(process.exitCode().value() == 32);
+  }
+#else
+#warning <fcntl.h> or <sys/mman.h> or <sys/stat.h> or <sys/syscall.h> or \
+    <linux/futex.h> or <poll.h> or <unistd.h> is not found => \
+    cu0::RingBuffer will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::RingBuffer will not be checked
+#endif
+
+  return 0;
+}
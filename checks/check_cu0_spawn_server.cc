@@ -0,0 +1,186 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/spawn_server.hh>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>) && __has_include(<poll.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "echo") {
+      for (auto i = 2; i < argc; i++) {
+        std::cout << (i > 2 ? " " : "") << argv[i];
+      }
+      return 0;
+    } else if (std::string{argv[1]} == "exit") {
+      return std::stoi(argv[2]);
+    } else if (std::string{argv[1]} == "environment") {
+      const auto* value = std::getenv("SOME_KEY");
+      std::cout << (value == nullptr ? "" : value);
+      return 0;
+    } else if (std::string{argv[1]} == "cat") {
+      std::cout << std::cin.rdbuf();
+      return 0;
+    } else if (std::string{argv[1]} == "fd") {
+      return ::write(std::stoi(argv[2]), "fd", 2) == 2 ? 0 : 1;
+    }
+    return 100;
+  }
+
+  //! a file descriptor without FD_CLOEXEC opened before the server
+  int leaked[2];
+  assert(::pipe(leaked) == 0);
+  auto created = cu0::SpawnServer::create();
+  assert(std::holds_alternative<cu0::SpawnServer>(created));
+  auto server = std::get<cu0::SpawnServer>(std::move(created));
+  {
+    //! the server does not keep the file descriptors of this process
+    ::close(leaked[1]);
+    auto event = pollfd{ .fd = leaked[0], .events = POLLIN, .revents = 0, };
+    assert(::poll(&event, 1, 1000) == 1);
+    assert((event.revents & POLLHUP) != 0);
+    ::close(leaked[0]);
+  }
+  //! spawns this binary with the specified arguments
+  const auto spawn = [&server, &argv](
+      const std::vector<std::string>& arguments,
+      const std::map<std::string, std::string>& environment = {},
+      const cu0::Stdio& stdio = {}
+  ) {
+    auto spawned = server.spawn(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = arguments,
+          .environment = environment,
+        },
+        stdio
+    );
+    assert(std::holds_alternative<cu0::Process>(spawned));
+    return std::get<cu0::Process>(std::move(spawned));
+  };
+  //! the memory of this process grows after the server has been created
+  auto memory = std::vector<char>(std::size_t{64} << 20, 1);
+  {
+    auto process = spawn({ "echo", "a", "b", });
+    assert(process.pid() != 0);
+    assert(process.pidfd() != -1);
+    assert(process.stdout() == "a b");
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+  {
+    auto process = spawn({ "exit", "7", });
+    process.wait();
+    assert(process.exitCode().value() == 7);
+  }
+  {
+    //! errors of execve() are the exit status code
+    auto spawned = server.spawn(
+        cu0::Executable{ .binary = "/nonexistent/binary", }
+    );
+    assert(std::holds_alternative<cu0::Process>(spawned));
+    auto& process = std::get<cu0::Process>(spawned);
+    process.wait();
+    assert(process.exitCode().value() == ENOENT);
+  }
+  {
+    auto process = spawn({ "environment", }, { { "SOME_KEY", "value", }, });
+    assert(process.stdout() == "value");
+    process.wait();
+  }
+  {
+    auto process = spawn({ "cat", });
+    process.stdin("some input");
+    process.closeStdin();
+    assert(process.stdout() == "some input");
+    process.wait();
+  }
+  {
+    //! stdio redirections and extra file descriptors are passed
+    const auto path = std::filesystem::temp_directory_path() /
+        ("check_cu0_spawn_server_" + std::to_string(::getpid()));
+    int fds[2];
+    assert(::pipe2(fds, O_CLOEXEC) == 0);
+    auto process = spawn(
+        { "fd", "5", }, {},
+        cu0::Stdio{
+          .err = cu0::Redirection::null(),
+          .fds = { { 5, fds[1], }, },
+        }
+    );
+    ::close(fds[1]);
+    assert(process.stderrPipe() == -1);
+    process.wait();
+    assert(process.exitCode().value() == 0);
+    char buffer[3] = {};
+    assert(::read(fds[0], buffer, sizeof(buffer)) == 2);
+    assert(std::string{buffer} == "fd");
+    ::close(fds[0]);
+    auto echo = spawn(
+        { "echo", "file", }, {},
+        cu0::Stdio{ .out = cu0::Redirection::file(path), }
+    );
+    assert(echo.stdoutPipe() == -1);
+    echo.wait();
+    auto file = std::ifstream{path};
+    assert(std::string(std::istreambuf_iterator<char>{file}, {}) == "file");
+    std::filesystem::remove(path);
+  }
+  {
+    //! concurrent spawns
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < 4; i++) {
+      threads.emplace_back([&spawn, i]() {
+        for (auto j = 0; j < 10; j++) {
+          auto process = spawn({ "exit", std::to_string(i * 10 + j), });
+          process.wait();
+          assert(process.exitCode().value() == i * 10 + j);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  {
+    //! the server exits when it is destructed
+    auto moved = std::move(server);
+    auto spawned = moved.spawn(
+        cu0::Executable{ .binary = argv[0], .arguments = { "exit", "3", }, }
+    );
+    assert(std::holds_alternative<cu0::Process>(spawned));
+    auto& process = std::get<cu0::Process>(spawned);
+    process.wait();
+    assert(process.exitCode().value() == 3);
+    //! a moved-from server spawns nothing
+    const auto notSpawned = server.spawn(
+        cu0::Executable{ .binary = argv[0], .arguments = { "exit", "0", }, }
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(notSpawned) ==
+            cu0::Process::CreateError::INVAL
+    );
+  }
+#else
+#warning <sys/socket.h> or <sys/syscall.h> or <sys/types.h> or \
+    <sys/wait.h> or <unistd.h> or <poll.h> is not found => \
+    cu0::SpawnServer will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::SpawnServer will not be checked
+#endif
+
+  return 0;
+}
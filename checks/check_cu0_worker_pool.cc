@@ -0,0 +1,172 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/worker_pool.hh>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<signal.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "worker") {
+      const auto served = cu0::WorkerPool::serve(
+          [](std::string_view request) -> std::string {
+            if (request == "pid") {
+              return std::to_string(::getpid());
+            } else if (request == "crash") {
+              std::_Exit(3);
+            } else if (request == "print") {
+              //! written to the stderr instead of breaking the response
+              std::cout << "printed by the worker" << std::endl;
+              return "printed";
+            }
+            return std::string{request};
+          }
+      );
+      return served == cu0::WorkerPool::ServeError::NO_ERROR ? 0 : 1;
+    } else if (std::string{argv[1]} == "broken") {
+      //! a response frame shorter than its size
+      const auto size = std::uint64_t{10};
+      static_cast<void>(::write(STDOUT_FILENO, &size, sizeof(size)));
+      static_cast<void>(::write(STDOUT_FILENO, "abc", 3));
+      return 0;
+    } else if (std::string{argv[1]} == "oversized") {
+      //! output before serving is read as the size of a response frame
+      static_cast<void>(::write(STDOUT_FILENO, "garbage!", 8));
+      const auto served = cu0::WorkerPool::serve(
+          [](std::string_view request) { return request; }
+      );
+      return served == cu0::WorkerPool::ServeError::NO_ERROR ? 0 : 1;
+    }
+    return 100;
+  }
+
+  {
+    const auto empty = cu0::WorkerPool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "worker", }, }, 0
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(empty) ==
+            cu0::Process::CreateError::INVAL
+    );
+    auto created = cu0::WorkerPool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "broken", }, }
+    );
+    assert(std::holds_alternative<cu0::WorkerPool>(created));
+    const auto& broken = std::get<cu0::WorkerPool>(created);
+    assert(broken.size() >= 1);
+    const auto [response, error] = broken.callCautious("request");
+    assert(response.empty());
+    assert(error == cu0::WorkerPool::CallError::PIPE);
+  }
+  {
+    //! an oversized response is not allocated and the worker is released
+    auto created = cu0::WorkerPool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "oversized", }, },
+        1
+    );
+    assert(std::holds_alternative<cu0::WorkerPool>(created));
+    const auto& oversized = std::get<cu0::WorkerPool>(created);
+    for (auto i = 0; i < 2; i++) {
+      const auto [response, error] = oversized.callCautious("request");
+      assert(response.empty());
+      assert(error == cu0::WorkerPool::CallError::MSGSIZE);
+    }
+  }
+  auto created = cu0::WorkerPool::create(
+      cu0::Executable{ .binary = argv[0], .arguments = { "worker", }, }, 2
+  );
+  assert(std::holds_alternative<cu0::WorkerPool>(created));
+  auto pool = std::get<cu0::WorkerPool>(std::move(created));
+  assert(pool.size() == 2);
+  {
+    assert(pool.call("some request") == "some request");
+    assert(pool.call("").empty());
+    //! binary-safe
+    const auto binary = std::string{ 'a', '\0', 'b', };
+    assert(pool.call(binary) == binary);
+    //! larger than a pipe buffer in both directions
+    const auto large = std::string(std::size_t{4} << 20, 'x');
+    assert(pool.call(large) == large);
+    assert(pool.call("print") == "printed");
+  }
+  {
+    //! the workers are reused
+    const auto pid = pool.call("pid");
+    for (auto i = 0; i < 10; i++) {
+      assert(pool.call("pid") == pid);
+    }
+  }
+  {
+    //! concurrent calls are served by all the workers
+    auto pids = std::vector<std::set<std::string>>(4);
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < 4; i++) {
+      threads.emplace_back([&pool, &pids, i]() {
+        for (auto j = 0; j < 50; j++) {
+          const auto request = std::to_string(i * 50 + j);
+          assert(pool.call(request) == request);
+          pids[i].insert(pool.call("pid"));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto all = std::set<std::string>{};
+    for (const auto& set : pids) {
+      all.insert(set.begin(), set.end());
+    }
+    assert(all.size() <= 2);
+  }
+  {
+    //! a crashed worker is created again
+    const auto count = []() {
+      const auto entries =
+          std::filesystem::directory_iterator{"/proc/self/fd"};
+      return std::distance(begin(entries), end(entries));
+    };
+    const auto before = count();
+    for (auto i = 0; i < 4; i++) {
+      const auto pid = pool.call("pid");
+      const auto [response, error] = pool.callCautious("crash");
+      assert(response.empty());
+      assert(error == cu0::WorkerPool::CallError::PIPE);
+      assert(pool.call("pid") != pid);
+      assert(pool.call("again") == "again");
+    }
+    //! no file descriptors are left opened
+    assert(count() == before);
+  }
+  {
+    //! the workers exit when the pool is destructed
+    auto moved = std::move(pool);
+    assert(moved.size() == 2);
+    assert(pool.size() == 0);
+    assert(moved.call("moved") == "moved");
+    //! a moved-from pool calls no worker
+    const auto [response, error] = pool.callCautious("moved from");
+    assert(response.empty());
+    assert(error == cu0::WorkerPool::CallError::INVAL);
+  }
+#else
+#warning <signal.h> or <sys/types.h> or <sys/wait.h> or <sys/uio.h> or \
+    <unistd.h> or <fcntl.h> is not found => \
+    cu0::WorkerPool will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::WorkerPool will not be checked
+#endif
+
+  return 0;
+}
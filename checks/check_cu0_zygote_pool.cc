@@ -0,0 +1,335 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/zygote_pool.hh>
+#include <cassert>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief runs a launched process
+ * @param executable is the requested executable
+ * @param zygote is the pid of the zygote which launched the process
+ * @return exit status code of the launched process
+ */
+int run(const cu0::Executable& executable, const pid_t& zygote) {
+  const auto& arguments = executable.arguments;
+  if (arguments.empty()) {
+    return 100;
+  }
+  if (arguments[0] == "echo") {
+    for (auto i = std::size_t{1}; i < arguments.size(); i++) {
+      std::cout << (i > 1 ? " " : "") << arguments[i];
+    }
+    std::cout << std::flush;
+    return 0;
+  } else if (arguments[0] == "exit") {
+    return std::stoi(arguments[1]);
+  } else if (arguments[0] == "environment") {
+    //! the environment of the zygote is replaced
+    const auto* value = std::getenv("SOME_KEY");
+    std::cout << (value == nullptr ? "" : value) <<
+        (std::getenv(cu0::ZygotePool::ENVIRONMENT_VARIABLE) == nullptr) <<
+        std::flush;
+    return 0;
+  } else if (arguments[0] == "cat") {
+    std::cout << std::cin.rdbuf() << std::flush;
+    return 0;
+  } else if (arguments[0] == "fd") {
+    const auto fd = std::stoi(arguments[1]);
+    return ::write(fd, "fd", 2) == 2 ? 0 : 1;
+  } else if (arguments[0] == "parent") {
+    //! launched as a sibling of the zygote
+    return ::getppid() != zygote ? 0 : 1;
+  } else if (arguments[0] == "kill") {
+    //! the launcher closes stdin once it has received the reply =>
+    //!     the zygote is not killed before it replies
+    char byte;
+    while (::read(STDIN_FILENO, &byte, 1) > 0) {}
+    ::kill(zygote, SIGKILL);
+    //! the zygote is a zombie once its control socket is closed =>
+    //!     the next launch does not send its request to the dying zygote
+    const auto stat = "/proc/" + std::to_string(zygote) + "/stat";
+    auto state = std::string{};
+    while (state != "Z") {
+      auto file = std::ifstream{stat};
+      auto line = std::string{};
+      std::getline(file, line);
+      const auto end = line.rfind(')');
+      state = end == std::string::npos ? "Z" : line.substr(end + 2, 1);
+    }
+    return 0;
+  }
+  return 101;
+}
+#endif
+#endif
+
+int main(int argc, char** argv) {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "zygote") {
+      const auto zygote = ::getpid();
+      auto served = cu0::ZygotePool::serve();
+      if (std::holds_alternative<cu0::ZygotePool::ServeError>(served)) {
+        return std::get<cu0::ZygotePool::ServeError>(served) ==
+            cu0::ZygotePool::ServeError::PIPE ? 0 : 1;
+      }
+      return run(std::get<cu0::Executable>(served), zygote);
+    } else if (std::string{argv[1]} == "broken") {
+      return 0;
+    }
+    return 102;
+  }
+
+  {
+    //! not created by a zygote pool
+    const auto served = cu0::ZygotePool::serve();
+    assert(
+        std::get<cu0::ZygotePool::ServeError>(served) ==
+            cu0::ZygotePool::ServeError::BADF
+    );
+    const auto empty = cu0::ZygotePool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "zygote", }, }, 0
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(empty) ==
+            cu0::Process::CreateError::INVAL
+    );
+    //! the executable exits without serving
+    const auto broken = cu0::ZygotePool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "broken", }, }
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(broken) ==
+            cu0::Process::CreateError::AGAIN
+    );
+  }
+  auto created = cu0::ZygotePool::create(
+      cu0::Executable{ .binary = argv[0], .arguments = { "zygote", }, }, 2
+  );
+  assert(std::holds_alternative<cu0::ZygotePool>(created));
+  auto pool = std::get<cu0::ZygotePool>(std::move(created));
+  assert(pool.size() == 2);
+  //! launches the specified arguments
+  const auto launch = [&pool](
+      const std::vector<std::string>& arguments,
+      const std::map<std::string, std::string>& environment = {},
+      const cu0::Stdio& stdio = {}
+  ) {
+    auto launched = pool.launch(
+        cu0::Executable{ .arguments = arguments, .environment = environment, },
+        stdio
+    );
+    assert(std::holds_alternative<cu0::Process>(launched));
+    return std::get<cu0::Process>(std::move(launched));
+  };
+  {
+    auto process = launch({ "echo", "a", "b", });
+    assert(process.pid() != 0);
+    assert(process.stdout() == "a b");
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+  {
+    auto process = launch({ "exit", "7", });
+    process.wait();
+    assert(process.exitCode().value() == 7);
+  }
+  {
+    auto process = launch({ "parent", });
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+  {
+    auto process = launch({ "environment", }, { { "SOME_KEY", "value", }, });
+    assert(process.stdout() == "value1");
+    process.wait();
+  }
+  {
+    auto process = launch({ "cat", });
+    process.stdin("some input");
+    process.closeStdin();
+    assert(process.stdout() == "some input");
+    process.wait();
+  }
+  {
+    //! stdio redirections and extra file descriptors are passed
+    const auto path = std::filesystem::temp_directory_path() /
+        ("check_cu0_zygote_pool_" + std::to_string(::getpid()));
+    int fds[2];
+    assert(::pipe2(fds, O_CLOEXEC) == 0);
+    auto process = launch(
+        { "fd", "5", }, {},
+        cu0::Stdio{
+          .out = cu0::Redirection::file(path),
+          .fds = { { 5, fds[1], }, },
+        }
+    );
+    ::close(fds[1]);
+    assert(process.stdoutPipe() == -1);
+    process.wait();
+    assert(process.exitCode().value() == 0);
+    char buffer[3] = {};
+    assert(::read(fds[0], buffer, sizeof(buffer)) == 2);
+    assert(std::string{buffer} == "fd");
+    ::close(fds[0]);
+    auto echo = launch(
+        { "echo", "file", }, {},
+        cu0::Stdio{ .out = cu0::Redirection::file(path), }
+    );
+    echo.wait();
+    auto file = std::ifstream{path};
+    assert(std::string(std::istreambuf_iterator<char>{file}, {}) == "file");
+    std::filesystem::remove(path);
+    const auto invalid = pool.launch(
+        cu0::Executable{ .arguments = { "echo", }, },
+        cu0::Stdio{ .fds = { { 5, -1, }, }, }
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(invalid) ==
+            cu0::Process::CreateError::INVAL
+    );
+  }
+  {
+    //! no file descriptors are left opened
+    const auto count = []() {
+      const auto entries =
+          std::filesystem::directory_iterator{"/proc/self/fd"};
+      return std::distance(begin(entries), end(entries));
+    };
+    const auto before = count();
+    for (auto i = 0; i < 10; i++) {
+      auto process = launch({ "cat", });
+      process.closeStdin();
+      assert(process.stdout().empty());
+      process.wait();
+    }
+    assert(count() == before);
+  }
+  {
+    //! concurrent launches
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < 4; i++) {
+      threads.emplace_back([&launch, i]() {
+        for (auto j = 0; j < 25; j++) {
+          auto process = launch({ "exit", std::to_string(i * 25 + j), });
+          process.wait();
+          assert(process.exitCode().value() == i * 25 + j);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  {
+    //! the zygotes are killed => they are created again
+    for (auto i = 0; i < 2; i++) {
+      auto process = launch({ "kill", });
+      process.closeStdin();
+      process.wait();
+    }
+    for (auto i = 0; i < 4; i++) {
+      auto process = launch({ "echo", "again", });
+      assert(process.stdout() == "again");
+      process.wait();
+    }
+  }
+#if __has_include(<fcntl.h>) && __has_include(<sys/resource.h>)
+  {
+    //! a failed restart of a zygote is retried by the next launch
+    auto single = cu0::ZygotePool::create(
+        cu0::Executable{ .binary = argv[0], .arguments = { "zygote", }, }, 1
+    );
+    auto& restarted = std::get<cu0::ZygotePool>(single);
+    const auto inherited = cu0::Stdio{
+      .in = cu0::Redirection::inherit(),
+      .out = cu0::Redirection::inherit(),
+      .err = cu0::Redirection::inherit(),
+    };
+    auto killer = std::get<cu0::Process>(
+        restarted.launch(cu0::Executable{ .arguments = { "kill", }, })
+    );
+    killer.closeStdin();
+    killer.wait();
+    //! no file descriptors are left for the socket of the new zygote
+    rlimit previous;
+    assert(::getrlimit(RLIMIT_NOFILE, &previous) == 0);
+    auto lowered = previous;
+    lowered.rlim_cur = 64;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    auto occupied = std::vector<int>{};
+    for (auto fd = ::dup(0); fd >= 0; fd = ::dup(0)) {
+      occupied.push_back(fd);
+    }
+    const auto failed = restarted.launch(
+        cu0::Executable{ .arguments = { "exit", "0", }, },
+        inherited
+    );
+    assert(
+        std::get<cu0::Process::CreateError>(failed) ==
+            cu0::Process::CreateError::MFILE
+    );
+    for (const auto& fd : occupied) {
+      ::close(fd);
+    }
+    assert(::setrlimit(RLIMIT_NOFILE, &previous) == 0);
+    auto launched = restarted.launch(
+        cu0::Executable{ .arguments = { "echo", "restarted", }, }
+    );
+    auto& process = std::get<cu0::Process>(launched);
+    assert(process.stdout() == "restarted");
+    process.wait();
+    assert(process.exitCode().value() == 0);
+  }
+#else
+#warning <fcntl.h> or <sys/resource.h> is not found => \
+    a failed restart of cu0::ZygotePool will not be checked
+#endif
+  {
+    //! the zygotes exit when the pool is destructed
+    auto moved = std::move(pool);
+    assert(moved.size() == 2);
+    assert(pool.size() == 0);
+    //! a moved-from pool launches nothing
+    const auto launched =
+        pool.launch(cu0::Executable{ .arguments = { "exit", "0", }, });
+    assert(
+        std::get<cu0::Process::CreateError>(launched) ==
+            cu0::Process::CreateError::INVAL
+    );
+  }
+#else
+#warning <sys/socket.h> or <sys/syscall.h> or <sys/types.h> or \
+    <sys/wait.h> or <unistd.h> is not found => \
+    cu0::ZygotePool will not be checked
+#endif
+#else
+#warning __unix__ is not defined => cu0::ZygotePool will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::CommandGraph will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/epoll.h>) || !__has_include(<signal.h>)
+#warning <sys/epoll.h> or <signal.h> is not found => \
+    cu0::CommandGraph will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! a command
+    std::cout << "step " << argv[1];
+    return 0;
+  }
+  //! @note not supported on all platforms yet
+  auto created = cu0::CommandRunner::create();
+  if (!std::holds_alternative<cu0::CommandRunner>(created)) {
+    std::cout << "Error: the command runner was not created" << '\n';
+    return 1;
+  }
+  auto& runner = std::get<cu0::CommandRunner>(created);
+  const auto step = [&argv](const std::string& name) {
+    return cu0::Executable{ .binary = argv[0], .arguments = {name}, };
+  };
+  auto graph = cu0::CommandGraph{};
+  //! @note dependencies are added before the nodes depending on them
+  const auto compile = std::get<std::size_t>(graph.add(step("compile")));
+  const auto generate = std::get<std::size_t>(graph.add(step("generate")));
+  const auto link = std::get<std::size_t>(
+      graph.add(step("link"), std::vector{compile, generate})
+  );
+  static_cast<void>(graph.add(step("test"), std::vector{link}));
+  //! @note independent nodes run in parallel
+  auto results = graph.run(runner);
+  for (const auto& result : results) {
+    std::cout << result.out << " exited with " << result.exitCode.value_or(-1)
+        << '\n';
+  }
+  //! @note the next run starts the nodes on the longest path first
+  graph.updateEstimates(results);
+  results = graph.run(runner);
+}
+
+#endif
+#endif
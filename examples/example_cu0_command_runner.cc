@@ -0,0 +1,50 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::CommandRunner will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/epoll.h>) || !__has_include(<signal.h>)
+#warning <sys/epoll.h> or <signal.h> is not found => \
+    cu0::CommandRunner will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! a command
+    std::cout << "command " << argv[1];
+    return 0;
+  }
+  //! @note not supported on all platforms yet
+  //! @note at most 4 processes run at a time
+  auto created = cu0::CommandRunner::create(4);
+  if (!std::holds_alternative<cu0::CommandRunner>(created)) {
+    std::cout << "Error: the command runner was not created" << '\n';
+    return 1;
+  }
+  auto& runner = std::get<cu0::CommandRunner>(created);
+  auto executables = std::vector<cu0::Executable>{};
+  for (auto i = 0; i < 16; i++) {
+    executables.push_back(
+        cu0::Executable{ .binary = argv[0], .arguments = {std::to_string(i)}, }
+    );
+  }
+  //! @note the next command starts as soon as a running one exits
+  for (const auto& result : runner.run(executables)) {
+    std::cout << result.out << " exited with " << result.exitCode.value_or(-1)
+        << '\n';
+  }
+}
+
+#endif
+#endif
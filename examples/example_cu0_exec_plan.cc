@@ -0,0 +1,42 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note plan packs argv and envp of the executable into one arena
+  auto plan = cu0::ExecPlan{cu0::Executable{
+    .binary = "someExecutable",
+    .arguments = { "--input", "<placeholder>", },
+  }};
+  for (const auto& input : { "first", "second", "third", }) {
+    //! @note patching an argument does not allocate memory if
+    //!     the arena capacity is sufficient
+    plan.argument(1, input);
+    //! @note not supported on all platforms yet
+    auto variant = cu0::Process::create(plan);
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      std::cout << "Error: the process was not created" << '\n';
+      continue;
+    }
+    std::get<cu0::Process>(variant).wait();
+  }
+}
+
+#endif
+#endif
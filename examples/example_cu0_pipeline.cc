@@ -0,0 +1,48 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Pipeline::create() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::Pipeline::create() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note stdout of every stage is connected to stdin of the next stage
+  //!     ("producer | filter | consumer") without passing through this process
+  auto variant = cu0::Pipeline{}.
+      then(cu0::Executable{ .binary = "producer" }).
+      then(cu0::Executable{ .binary = "filter" }).
+      then(cu0::Executable{ .binary = "consumer" }).
+      create();
+  if (!std::holds_alternative<std::vector<cu0::Process>>(variant)) {
+    std::cout << "Error: the pipeline was not created" << '\n';
+    return 1;
+  }
+  auto& processes = std::get<std::vector<cu0::Process>>(variant);
+  //! @note stdin is supported by the first process only
+  processes.front().closeStdin();
+  //! @note stdout is supported by the last process only
+  //! @note stderr of every process is a pipe => a process writing much
+  //!     to stderr blocks until it is read (or use Pipeline::mergeStderr())
+  processes.back().stdoutLines([](std::string_view line) {
+    std::cout << "Line of the pipeline: " << line << '\n';
+  });
+  for (auto& process : processes) {
+    process.wait();
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,47 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <string>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::communicate() will not be used in the example
+int main() {}
+#else
+#if \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<fcntl.h>) || \
+  !__has_include(<poll.h>) || \
+  !__has_include(<signal.h>)
+#warning <unistd.h> or <fcntl.h> or <poll.h> or <signal.h> is not found => \
+    cu0::Process::communicate() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto variant = cu0::Process::create(cu0::Executable{
+    .binary = "someFilter"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  const auto input = std::string(1 << 24, 'x');
+  //! @note not supported on all platforms yet
+  //! @note communicate writes the stdin while reading the stdout and the stderr
+  //!     => large inputs do not deadlock on full pipe buffers
+  //! @note the stdin is closed after the input is written
+  const auto [outStr, errStr] = someProcess.communicate(input);
+  std::cout << "Stdout size of the created process: " << outStr.size() << '\n';
+  std::cout << "Stderr size of the created process: " << errStr.size() << '\n';
+  someProcess.wait();
+}
+
+#endif
+#endif
@@ -0,0 +1,45 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>) || !__has_include(<fcntl.h>)
+#warning <unistd.h> or <fcntl.h> is not found => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note only the streams of cu0::Redirection::pipe() (the default)
+  //!     get a pipe => the output goes straight to the file
+  auto variant = cu0::Process::create(
+      cu0::Executable{
+        .binary = "someExecutable"
+      },
+      cu0::Stdio{
+        .in = cu0::Redirection::null(),
+        .out = cu0::Redirection::file("some.log"),
+        .err = cu0::Redirection::toStdout(),
+      }
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  someProcess.wait();
+  std::cout << "The output of the created process is in some.log" << '\n';
+}
+
+#endif
+#endif
@@ -0,0 +1,42 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::Process::create() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note a process can be spawned by vfork (default), fork, posix_spawn or
+  //!     clone
+  const auto variant = cu0::Process::create(
+      cu0::Executable{ .binary = "a.out" },
+      cu0::Process::SpawnStrategy::POSIX_SPAWN
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    //! @note CreateError::NOSYS is returned if the strategy is not supported
+    std::cout << "Error: No processes were created" << '\n';
+  } else {
+    const auto& createdProcess = std::get<cu0::Process>(variant);
+    std::cout << "Pid of the created process: " << createdProcess.pid() << '\n';
+    //! @note pidfd contains a process file descriptor or -1 if not supported
+    std::cout << "Pidfd of the created process: " << createdProcess.pidfd() <<
+        '\n';
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,58 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <list>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::ProcessReactor will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/epoll.h>) || !__has_include(<unistd.h>) || \
+    !__has_include(<sys/types.h>) || !__has_include(<sys/wait.h>)
+#warning <sys/epoll.h> or <unistd.h> or <sys/types.h> or <sys/wait.h> is not \
+    found => cu0::ProcessReactor will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto reactor = cu0::ProcessReactor::create();
+  if (!std::holds_alternative<cu0::ProcessReactor>(reactor)) {
+    std::cout << "Error: the reactor was not created" << '\n';
+    return 1;
+  }
+  //! @note processes must not be moved while they are registered
+  auto processes = std::list<cu0::Process>{};
+  for (auto i = 0; i < 1024; i++) {
+    auto variant = cu0::Process::create(cu0::Executable{
+      .binary = "someExecutable"
+    });
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      continue;
+    }
+    auto& process = processes.emplace_back(
+        std::get<cu0::Process>(std::move(variant))
+    );
+    //! @note stdio and exits of all the processes are dispatched by one thread
+    std::get<cu0::ProcessReactor>(reactor).add(process, {
+      .onStdout = [](cu0::Process& process, std::span<const std::byte> data) {
+        std::cout << process.pid() << ": " << std::string_view{
+          reinterpret_cast<const char*>(data.data()), data.size(),
+        };
+      },
+      .onExit = [](cu0::Process& process) {
+        std::cout << process.pid() << " exited" << '\n';
+      },
+    });
+  }
+  //! @note run dispatches events until all the processes have exited
+  std::get<cu0::ProcessReactor>(reactor).run();
+}
+
+#endif
+#endif
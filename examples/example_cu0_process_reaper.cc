@@ -0,0 +1,52 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::ProcessReaper will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/epoll.h>) || !__has_include(<sys/eventfd.h>)
+#warning <sys/epoll.h> or <sys/eventfd.h> is not found => \
+    cu0::ProcessReaper will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the process-wide reaper is created on the first call
+  auto* reaper = cu0::ProcessReaper::global();
+  if (reaper == nullptr) {
+    std::cout << "Error: the reaper was not created" << '\n';
+    return 1;
+  }
+  for (auto i = 0; i < 1000; i++) {
+    auto variant = cu0::Process::create(cu0::Executable{
+      .binary = "someExecutable"
+    });
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      std::cout << "Error: the process was not created" << '\n';
+      return 1;
+    }
+    //! @note the reaper takes ownership of the process and waits for it
+    //!     on its background thread
+    reaper->adopt(
+        std::get<cu0::Process>(std::move(variant)),
+        [](cu0::Process& process) {
+          //! @note called on the background thread after the process exits
+          std::cout << "Process " << process.pid() << " exited" << '\n';
+        }
+    );
+  }
+  //! @note blocks until all the adopted processes have exited
+  reaper->drain();
+}
+
+#endif
+#endif
@@ -0,0 +1,51 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::resourceUsage() will not be used in the example
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<sys/resource.h>)
+#warning <sys/types.h> or <sys/wait.h> or <sys/resource.h> is not found => \
+    cu0::Process::resourceUsage() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto variant = cu0::Process::create(cu0::Executable{
+    .binary = "someExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  someProcess.wait();
+  //! @note not supported on all platforms yet
+  //! @note resource usage is collected by the kernel and is present
+  //!     after the process has exited and has been waited
+  if (someProcess.resourceUsage().has_value()) {
+    const auto& usage = someProcess.resourceUsage().value();
+    std::cout << "User cpu time: " << usage.userTime.count() << "us" << '\n';
+    std::cout << "System cpu time: " << usage.systemTime.count() << "us" <<
+        '\n';
+    std::cout << "Max resident set size: " << usage.maxResidentSetSize <<
+        "KiB" << '\n';
+    std::cout << "Context switches: " << usage.voluntaryContextSwitches <<
+        " voluntary, " << usage.involuntaryContextSwitches <<
+        " involuntary" << '\n';
+  }
+}
+
+#endif
+#endif
@@ -28,7 +28,7 @@ int main() {
   const auto& someProcess = std::get<cu0::Process>(variant);
   //! @note not supported on all platforms yet
   //! @note stderr returns standard error output of the created process
-  //!     at the moment of call
+  //!     until it closes the stream
   const auto errStr = someProcess.stderr();
   if (errStr.empty()) {
     std::cout << "Stderr of the created process is empty" << '\n';
@@ -28,7 +28,7 @@ int main() {
   const auto& someProcess = std::get<cu0::Process>(variant);
   //! @note not supported on all platforms yet
   //! @note stderr returns standard error output of the created process
-  //!     at the moment of call
+  //!     until it closes the stream
   const auto [errStr, errorCode] = someProcess.stderrCautious();
   if (errorCode != cu0::Process::ReadError::NO_ERROR) {
     std::cout << "Error: data was not fully received from the stderr" << '\n';
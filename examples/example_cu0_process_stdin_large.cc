@@ -0,0 +1,55 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <string>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Redirection::memory() and cu0::Process::stdinSpliced() \
+    will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/mman.h>) || !__has_include(<sys/uio.h>)
+#warning <sys/mman.h> or <sys/uio.h> is not found => \
+    cu0::Redirection::memory() and cu0::Process::stdinSpliced() \
+    will not be used in the example
+int main() {}
+#else
+
+int main() {
+  const auto input = std::string(std::size_t{1} << 30, 'x');
+  //! @note not supported on all platforms yet
+  //! @note the input is copied into a sealed in-memory file once =>
+  //!     the process can seek it and mmap() it as a regular file
+  auto variant = cu0::Process::create(
+      cu0::Executable{ .binary = "someExecutable" },
+      cu0::Stdio{ .in = cu0::Redirection::memory(input) }
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  std::get<cu0::Process>(variant).wait();
+  auto otherVariant = cu0::Process::create(cu0::Executable{
+    .binary = "someOtherExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(otherVariant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someOtherProcess = std::get<cu0::Process>(otherVariant);
+  //! @note the pages of the input are referenced by the stdin pipe
+  //!     instead of being copied by vmsplice() =>
+  //!     the input must not be modified until the process has read it
+  someOtherProcess.stdinSpliced(input);
+  someOtherProcess.closeStdin();
+  someOtherProcess.wait();
+}
+
+#endif
+#endif
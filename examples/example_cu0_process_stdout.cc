@@ -28,7 +28,7 @@ int main() {
   const auto& someProcess = std::get<cu0::Process>(variant);
   //! @note not supported on all platforms yet
   //! @note stdout returns standard output of the created process
-  //!     at the moment of call
+  //!     until it closes the stream
   const auto outStr = someProcess.stdout();
   if (outStr.empty()) {
     std::cout << "Stdout of the created process is empty" << '\n';
@@ -0,0 +1,42 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutLines() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::Process::stdoutLines() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  const auto variant = cu0::Process::create(cu0::Executable{
+    .binary = "someExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  const auto& someProcess = std::get<cu0::Process>(variant);
+  //! @note not supported on all platforms yet
+  //! @note every line of stdout is passed to the callback as soon as it is read
+  //!     until the end of file
+  //! @note stdoutChunks() passes raw chunks as std::span<const std::byte>
+  someProcess.stdoutLines([](std::string_view line) {
+    std::cout << "Line of the created process: " << line << '\n';
+    //! @note returning false stops reading
+    return line != "quit";
+  });
+}
+
+#endif
+#endif
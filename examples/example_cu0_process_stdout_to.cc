@@ -0,0 +1,48 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutTo() will not be used in the example
+int main() {}
+#else
+#if !__has_include(<unistd.h>) || !__has_include(<fcntl.h>)
+#warning <unistd.h> or <fcntl.h> is not found => \
+    cu0::Process::stdoutTo() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto variant = cu0::Process::create(cu0::Executable{
+    .binary = "someExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  const auto fd = ::open(
+      "some.log", O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666
+  );
+  if (fd < 0) {
+    std::cout << "Error: the file was not opened" << '\n';
+    return 1;
+  }
+  //! @note not supported on all platforms yet
+  //! @note the stdout is moved to the file inside the kernel by splice()
+  //!     until the process closes the stream
+  //! @note stdoutTee() passes a copy of the data to a callback as well
+  const auto [bytes, readError, writeError] = someProcess.stdoutTo(fd);
+  ::close(fd);
+  someProcess.wait();
+  std::cout << bytes << " bytes were written to some.log" << '\n';
+}
+
+#endif
+#endif
@@ -0,0 +1,50 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <vector>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::waitAny() will not be used in the example
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<poll.h>)
+#warning <sys/types.h> or <sys/wait.h> or <poll.h> is not found => \
+    cu0::Process::waitAny() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto processes = std::vector<cu0::Process>{};
+  for (const auto& binary : { "someExecutable", "otherExecutable", }) {
+    auto variant = cu0::Process::create(cu0::Executable{
+      .binary = binary
+    });
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      std::cout << "Error: the process was not created" << '\n';
+      return 1;
+    }
+    processes.push_back(std::get<cu0::Process>(std::move(variant)));
+  }
+  //! @note not supported on all platforms yet
+  //! @note waitAny returns the index of the first exited process
+  //!     and skips the processes which have already been waited
+  const auto first = cu0::Process::waitAny(processes);
+  if (std::holds_alternative<std::size_t>(first)) {
+    std::cout << "The first exited process is " <<
+        processes[std::get<std::size_t>(first)].pid() << '\n';
+  }
+  //! @note waitAll (and waitAllUntil) waits for the rest of the processes
+  cu0::Process::waitAll(processes);
+}
+
+#endif
+#endif
@@ -0,0 +1,53 @@
+#include <cu0/proc.hxx>
+#include <chrono>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::Process::waitFor() will not be used in the example
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<poll.h>) || \
+  !__has_include(<signal.h>)
+#warning <sys/types.h> or <sys/wait.h> or <poll.h> or <signal.h> is not found => \
+    cu0::Process::waitFor() will not be used in the example
+int main() {}
+#else
+
+int main() {
+  auto variant = cu0::Process::create(cu0::Executable{
+    .binary = "someExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  //! @note not supported on all platforms yet
+  //! @note waitFor (and waitUntil) sleeps until the process exits
+  //!     or until the timeout expires
+  if (
+      someProcess.waitFor(std::chrono::seconds{10}) ==
+          cu0::Process::WaitError::TIMEDOUT
+  ) {
+    //! @note terminate sends SIGTERM and escalates to SIGKILL
+    //!     if the process is still running after the grace period
+    someProcess.terminate(std::chrono::seconds{1});
+    std::cout << "The created process was terminated by signal " <<
+        someProcess.terminationCode().value() << '\n';
+  } else {
+    std::cout << "The created process exited" << '\n';
+  }
+}
+
+#endif
+#endif
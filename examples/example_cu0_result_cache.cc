@@ -0,0 +1,55 @@
+#include <cu0/proc.hxx>
+#include <filesystem>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::ResultCache will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/mman.h>) || !__has_include(<sys/stat.h>)
+#warning <sys/mman.h> or <sys/stat.h> is not found => \
+    cu0::ResultCache will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! the deterministic executable
+    std::cout << "output of " << argv[1] << '\n';
+    return 0;
+  }
+  //! @note not supported on all platforms yet
+  auto opened = cu0::ResultCache::open(
+      std::filesystem::temp_directory_path() / "example_cu0_result_cache"
+  );
+  if (!std::holds_alternative<cu0::ResultCache>(opened)) {
+    std::cout << "Error: the cache was not opened" << '\n';
+    return 1;
+  }
+  const auto& cache = std::get<cu0::ResultCache>(opened);
+  const auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"someArgument"},
+  };
+  for (auto i = 0; i < 2; i++) {
+    //! @note the first run may execute the process, the second one reads
+    //!     the stored result
+    auto ran = cache.run(executable);
+    if (!std::holds_alternative<cu0::ResultCache::Record>(ran)) {
+      std::cout << "Error: the process was not created" << '\n';
+      return 1;
+    }
+    const auto& record = std::get<cu0::ResultCache::Record>(ran);
+    std::cout << (record.cached() ? "cached: " : "executed: ") <<
+        record.out();
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,70 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::RingBuffer will not be used in the example
+int main() {}
+#else
+#if \
+  !__has_include(<sys/mman.h>) || \
+  !__has_include(<sys/syscall.h>) || \
+  !__has_include(<linux/futex.h>) || \
+  !__has_include(<poll.h>)
+#warning <sys/mman.h> or <sys/syscall.h> or <linux/futex.h> or <poll.h> is not \
+    found => cu0::RingBuffer will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! the created process writes into the ring buffer
+    auto attached = cu0::RingBuffer::attach();
+    if (!std::holds_alternative<cu0::RingBuffer>(attached)) {
+      return 1;
+    }
+    auto& writer = std::get<cu0::RingBuffer>(attached);
+    for (auto i = 0; i < 1024; i++) {
+      writer.write("some data ");
+    }
+    //! @note the reader reads the end of file after the close
+    writer.close();
+    return 0;
+  }
+  auto created = cu0::RingBuffer::create();
+  if (!std::holds_alternative<cu0::RingBuffer>(created)) {
+    std::cout << "Error: the ring buffer was not created" << '\n';
+    return 1;
+  }
+  auto& reader = std::get<cu0::RingBuffer>(created);
+  auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"writer"},
+  };
+  auto stdio = cu0::Stdio{};
+  //! @note the ring buffer is inherited by the process to be created
+  reader.share(executable, stdio);
+  auto variant = cu0::Process::create(executable, stdio);
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& someProcess = std::get<cu0::Process>(variant);
+  auto bytes = std::size_t{0};
+  //! @note the chunks point into the shared memory => no data are copied
+  //! @note the process file descriptor detects the process exiting
+  //!     without closing the ring buffer
+  reader.readChunks([&bytes](std::span<const std::byte> chunk) {
+    bytes += chunk.size();
+  }, someProcess.pidfd());
+  someProcess.wait();
+  std::cout << bytes << " bytes were transferred" << '\n';
+}
+
+#endif
+#endif
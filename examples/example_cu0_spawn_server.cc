@@ -0,0 +1,47 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::SpawnServer will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/socket.h>) || !__has_include(<sys/syscall.h>)
+#warning <sys/socket.h> or <sys/syscall.h> is not found => \
+    cu0::SpawnServer will not be used in the example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the server is forked from this process =>
+  //!     it is created early while this process is small and single-threaded
+  auto created = cu0::SpawnServer::create();
+  if (!std::holds_alternative<cu0::SpawnServer>(created)) {
+    std::cout << "Error: the spawn server was not created" << '\n';
+    return 1;
+  }
+  const auto& server = std::get<cu0::SpawnServer>(created);
+  //! @note later this process may map a lot of memory and run many threads
+  auto variant = server.spawn(cu0::Executable{
+    .binary = "someExecutable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  //! @note the process is a child of this process as if it was created by
+  //!     cu0::Process::create()
+  auto& someProcess = std::get<cu0::Process>(variant);
+  std::cout << someProcess.stdout();
+  someProcess.wait();
+}
+
+#endif
+#endif
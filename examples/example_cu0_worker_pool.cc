@@ -0,0 +1,53 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::WorkerPool will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/uio.h>) || !__has_include(<signal.h>)
+#warning <sys/uio.h> or <signal.h> is not found => \
+    cu0::WorkerPool will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! the worker
+    //! @note expensive initialisation is done once by the worker here
+    static_cast<void>(cu0::WorkerPool::serve(
+        [](std::string_view request) {
+          return "response to " + std::string{request};
+        }
+    ));
+    //! @note the worker pool has been destructed
+    return 0;
+  }
+  //! @note not supported on all platforms yet
+  auto created = cu0::WorkerPool::create(
+      cu0::Executable{ .binary = argv[0], .arguments = {"worker"}, }
+  );
+  if (!std::holds_alternative<cu0::WorkerPool>(created)) {
+    std::cout << "Error: the worker pool was not created" << '\n';
+    return 1;
+  }
+  const auto& pool = std::get<cu0::WorkerPool>(created);
+  //! @note the request is passed to an idle worker through its stdin
+  const auto [response, error] = pool.callCautious("someRequest");
+  if (error != cu0::WorkerPool::CallError::NO_ERROR) {
+    std::cout << "Error: the worker has exited" << '\n';
+    return 1;
+  }
+  std::cout << response << '\n';
+}
+
+#endif
+#endif
@@ -0,0 +1,58 @@
+#include <cu0/proc.hxx>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported ->
+//!         a compile-time warning will be present
+//!     else (if all features are supported) ->
+//!         no feature-related compile-time warnings will be present
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    cu0::ZygotePool will not be used in the example
+int main() {}
+#else
+#if !__has_include(<sys/socket.h>) || !__has_include(<sys/syscall.h>)
+#warning <sys/socket.h> or <sys/syscall.h> is not found => \
+    cu0::ZygotePool will not be used in the example
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  if (argc > 1) { //! the zygote
+    //! @note expensive initialisation is done once by the zygote here
+    auto served = cu0::ZygotePool::serve();
+    if (!std::holds_alternative<cu0::Executable>(served)) {
+      //! @note the zygote pool has been destructed
+      return 0;
+    }
+    //! @note a launched process continues here with the requested arguments
+    const auto& request = std::get<cu0::Executable>(served);
+    std::cout << "launched with " << request.arguments.size() <<
+        " arguments" << '\n';
+    return 0;
+  }
+  //! @note not supported on all platforms yet
+  auto created = cu0::ZygotePool::create(
+      cu0::Executable{ .binary = argv[0], .arguments = {"zygote"}, }
+  );
+  if (!std::holds_alternative<cu0::ZygotePool>(created)) {
+    std::cout << "Error: the zygote pool was not created" << '\n';
+    return 1;
+  }
+  const auto& pool = std::get<cu0::ZygotePool>(created);
+  //! @note the process is forked from a zygote => no binary is executed
+  auto variant = pool.launch(
+      cu0::Executable{ .arguments = {"someArgument"}, },
+      cu0::Stdio{ .out = cu0::Redirection::inherit() }
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not launched" << '\n';
+    return 1;
+  }
+  //! @note the launched process is a child of this process
+  std::get<cu0::Process>(variant).wait();
+}
+
+#endif
+#endif
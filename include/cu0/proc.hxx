@@ -1,7 +1,19 @@
 #ifndef CU0_PROC_HXX_
 #define CU0_PROC_HXX_
 
+#include <cu0/proc/command_graph.hh>
+#include <cu0/proc/command_runner.hh>
+#include <cu0/proc/exec_plan.hh>
 #include <cu0/proc/executable.hh>
+#include <cu0/proc/pipeline.hh>
 #include <cu0/proc/process.hh>
+#include <cu0/proc/process_reactor.hh>
+#include <cu0/proc/process_reaper.hh>
+#include <cu0/proc/result_cache.hh>
+#include <cu0/proc/ring_buffer.hh>
+#include <cu0/proc/spawn_server.hh>
+#include <cu0/proc/stdio.hh>
+#include <cu0/proc/worker_pool.hh>
+#include <cu0/proc/zygote_pool.hh>
 
 #endif /// CU0_PROC_HXX_
@@ -0,0 +1,282 @@
+#ifndef CU0_COMMAND_GRAPH_HH_
+#define CU0_COMMAND_GRAPH_HH_
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <queue>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/command_runner.hh>
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process_reactor.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/epoll.h>) || !__has_include(<signal.h>)
+#warning <sys/epoll.h> or <signal.h> is not found => \
+    cu0::CommandGraph will not be supported
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::CommandGraph will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+/*!
+ * @brief The CommandGraph struct runs executables (nodes) which depend on
+ *     each other
+ * @note a node is started after all its dependencies have exited with 0
+ * @note of the nodes which can be started, the one with the longest
+ *     estimated path to the end of the graph (critical path) is started
+ *     first => the slow chains are not delayed by the short ones
+ * @note estimates are durations of previous runs
+ *     @see CommandGraph::updateEstimates()
+ * @note usage:
+ *     CommandGraph::add() ... -> CommandGraph::run() ->
+ *         CommandGraph::updateEstimates() -> CommandGraph::run() ...
+ */
+struct CommandGraph {
+public:
+  enum struct AddError {
+    NO_ERROR = 0, //! no error
+    INVAL = EINVAL, //! a dependency is not an added node
+  };
+  /*!
+   * @brief adds a node
+   * @note the dependencies have to be added before => the graph is acyclic
+   * @param executable is the executable of the node
+   * @param dependencies are the nodes to be run before the node
+   * @param estimate is the expected duration of the node
+   *     @note an unknown (0) estimate is treated as 1 ns => nodes without
+   *         estimates are ordered by the number of nodes left on the path
+   * @return
+   *     if there were no errors -> index of the node
+   *     if there was an error -> error code
+   */
+  std::variant<std::size_t, AddError> add(
+      const Executable& executable,
+      std::span<const std::size_t> dependencies = {},
+      const std::chrono::nanoseconds& estimate = {}
+  );
+  /*!
+   * @brief sets the estimates of the nodes to the durations of
+   *     the specified results
+   * @param results are results of a previous run of this graph
+   *     @note nodes which have not exited keep their estimates
+   */
+  void updateEstimates(std::span<const CommandRunner::Result> results);
+  /*!
+   * @brief runs the nodes by the specified runner
+   * @see CommandGraph::runCautious()
+   * @param runner runs the processes
+   * @param stdio are the redirections of every process
+   * @return results in the order of the nodes
+   */
+  std::vector<CommandRunner::Result> run(
+      CommandRunner& runner,
+      const Stdio& stdio = Stdio{ .in = Redirection::null(), }
+  ) const;
+  /*!
+   * @brief runs the nodes by the specified runner
+   * @note at most CommandRunner::concurrency() processes run at a time
+   * @note if a node fails (it is not created or it exits with
+   *     a nonzero status code) -> the nodes depending on it are not run =>
+   *     their results are empty (no error and no exit status code)
+   * @param runner runs the processes @see CommandRunner::runCautious()
+   * @param stdio are the redirections of every process
+   * @return @see CommandRunner::runCautious()
+   */
+  std::tuple<
+      std::vector<CommandRunner::Result>,
+      ProcessReactor::RunError
+  > runCautious(
+      CommandRunner& runner,
+      const Stdio& stdio = Stdio{ .in = Redirection::null(), }
+  ) const;
+  /*!
+   * @brief computes the estimated duration of the longest path
+   * @note it is the minimal duration of a run with unlimited concurrency
+   * @return estimated duration of the longest path
+   */
+  std::chrono::nanoseconds criticalPath() const;
+  /*!
+   * @brief accesses the number of nodes
+   * @return number of nodes
+   */
+  std::size_t size() const;
+protected:
+  /*!
+   * @brief The Node struct contains the edges of a node
+   */
+  struct Node {
+    //! nodes depending on this node
+    std::vector<std::size_t> dependents{};
+    //! number of the dependencies of this node
+    std::size_t dependencies = 0;
+    //! expected duration of this node
+    std::chrono::nanoseconds estimate{};
+  };
+  /*!
+   * @brief computes the estimated duration from the start of every node
+   *     to the end of the graph
+   * @return estimated durations in the order of the nodes
+   */
+  std::vector<std::chrono::nanoseconds> paths() const;
+  //! executables of the nodes @note contiguous => passed to the runner
+  std::vector<Executable> executables_{};
+  //! edges of the nodes
+  std::vector<Node> nodes_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+inline std::variant<std::size_t, CommandGraph::AddError> CommandGraph::add(
+    const Executable& executable,
+    std::span<const std::size_t> dependencies,
+    const std::chrono::nanoseconds& estimate
+) {
+  const auto index = this->nodes_.size();
+  for (const auto& dependency : dependencies) {
+    if (dependency >= index) {
+      return AddError::INVAL;
+    }
+  }
+  for (const auto& dependency : dependencies) {
+    this->nodes_[dependency].dependents.push_back(index);
+  }
+  this->nodes_.push_back(
+      Node{ .dependencies = dependencies.size(), .estimate = estimate, }
+  );
+  this->executables_.push_back(executable);
+  return index;
+}
+
+inline void CommandGraph::updateEstimates(
+    std::span<const CommandRunner::Result> results
+) {
+  for (
+      auto i = std::size_t{0};
+      i < std::min(results.size(), this->nodes_.size());
+      i++
+  ) {
+    if (results[i].exitCode.has_value()) {
+      this->nodes_[i].estimate = results[i].duration;
+    }
+  }
+}
+
+inline std::vector<CommandRunner::Result> CommandGraph::run(
+    CommandRunner& runner,
+    const Stdio& stdio
+) const {
+  return std::get<0>(this->runCautious(runner, stdio));
+}
+
+inline std::tuple<
+    std::vector<CommandRunner::Result>,
+    ProcessReactor::RunError
+> CommandGraph::runCautious(
+    CommandRunner& runner,
+    const Stdio& stdio
+) const {
+  const auto paths = this->paths();
+  //! the node with the longest path is on top, then the first added one
+  const auto later = [&paths](const std::size_t& a, const std::size_t& b) {
+    return paths[a] != paths[b] ? paths[a] < paths[b] : a > b;
+  };
+  auto ready = std::priority_queue<
+      std::size_t,
+      std::vector<std::size_t>,
+      decltype(later)
+  >{later};
+  //! numbers of the dependencies which have not succeeded yet
+  auto waiting = std::vector<std::size_t>(this->nodes_.size());
+  for (auto i = std::size_t{0}; i < this->nodes_.size(); i++) {
+    waiting[i] = this->nodes_[i].dependencies;
+    if (waiting[i] == 0) {
+      ready.push(i);
+    }
+  }
+  auto results = std::vector<CommandRunner::Result>(this->nodes_.size());
+  const auto ret = runner.runWith(
+      this->executables_,
+      stdio,
+      results,
+      [&ready]() -> std::optional<std::size_t> {
+        if (ready.empty()) {
+          return std::nullopt;
+        }
+        const auto node = ready.top();
+        ready.pop();
+        return node;
+      },
+      [this, &ready, &waiting, &results](const std::size_t& node) {
+        if (results[node].exitCode != 0) {
+          return;
+        }
+        for (const auto& dependent : this->nodes_[node].dependents) {
+          if (--waiting[dependent] == 0) {
+            ready.push(dependent);
+          }
+        }
+      }
+  );
+  return { std::move(results), ret, };
+}
+
+inline std::chrono::nanoseconds CommandGraph::criticalPath() const {
+  const auto paths = this->paths();
+  if (paths.empty()) {
+    return {};
+  }
+  return *std::max_element(paths.begin(), paths.end());
+}
+
+inline std::size_t CommandGraph::size() const {
+  return this->nodes_.size();
+}
+
+inline std::vector<std::chrono::nanoseconds> CommandGraph::paths() const {
+  auto ret = std::vector<std::chrono::nanoseconds>(this->nodes_.size());
+  //! dependents are added after their dependencies => reverse order
+  for (auto i = this->nodes_.size(); i > 0; i--) {
+    const auto& node = this->nodes_[i - 1];
+    auto longest = std::chrono::nanoseconds{};
+    for (const auto& dependent : node.dependents) {
+      longest = std::max(longest, ret[dependent]);
+    }
+    ret[i - 1] =
+        std::max(node.estimate, std::chrono::nanoseconds{1}) + longest;
+  }
+  return ret;
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_COMMAND_GRAPH_HH_
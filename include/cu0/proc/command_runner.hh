@@ -0,0 +1,373 @@
+#ifndef CU0_COMMAND_RUNNER_HH_
+#define CU0_COMMAND_RUNNER_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+#include <cu0/proc/process_reactor.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/epoll.h>)
+#warning <sys/epoll.h> is not found => \
+    cu0::CommandRunner will not be supported
+#endif
+#if !__has_include(<signal.h>)
+#warning <signal.h> is not found => \
+    cu0::CommandRunner will not be supported
+#else
+#include <signal.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::CommandRunner will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+/*!
+ * @brief The CommandRunner struct runs many executables with a bounded
+ *     number of processes at a time ("xargs -P")
+ * @note the processes are supervised by a ProcessReactor on the calling
+ *     thread => an exit wakes the thread up and the next executable is
+ *     started at once, nothing is polled
+ * @see CommandRunner::run()
+ */
+struct CommandRunner {
+public:
+  friend struct CommandGraph;
+  /*!
+   * @brief The Result struct contains the outcome of an executable
+   */
+  struct Result {
+    //! error of the creation of the process
+    //! @note if not Process::CreateError::NO_ERROR -> the other fields
+    //!     are empty
+    Process::CreateError error = Process::CreateError::NO_ERROR;
+    //! exit status code of the process @see Process::exitCode()
+    //! @note empty if the process has not been waited
+    std::optional<int> exitCode{};
+    //! stdout of the process @note collected for Redirection::Kind::PIPE
+    std::string out{};
+    //! stderr of the process @note collected for Redirection::Kind::PIPE
+    std::string err{};
+    //! time from the creation of the process until its exit has been
+    //!     dispatched
+    std::chrono::nanoseconds duration{};
+  };
+  /*!
+   * @brief creates a command runner
+   * @param concurrency is the maximal number of processes at a time
+   *     @note 0 is treated as 1
+   * @return
+   *     if there were no errors -> created command runner
+   *     if there was an error -> error code @see ProcessReactor::create()
+   */
+  [[nodiscard]] static std::variant<
+      CommandRunner,
+      ProcessReactor::CreateError
+  > create(
+      const std::size_t& concurrency =
+          std::max(std::thread::hardware_concurrency(), 1u)
+  );
+  CommandRunner(const CommandRunner& other) = delete;
+  CommandRunner& operator =(const CommandRunner& other) = delete;
+  /*!
+   * @brief moves the specified command runner resources to this command
+   *     runner
+   * @param other is the command runner to be moved
+   */
+  CommandRunner(CommandRunner&& other) = default;
+  /*!
+   * @brief moves the specified command runner resources to this command
+   *     runner
+   * @param other is the command runner to be moved
+   * @return this command runner as mutable reference
+   */
+  CommandRunner& operator =(CommandRunner&& other) = default;
+  /*!
+   * @brief destructs an instance
+   */
+  virtual ~CommandRunner() = default;
+  /*!
+   * @brief runs the specified executables and waits for all of them
+   * @see CommandRunner::runCautious()
+   * @param executables are the executables to be run
+   * @param stdio are the redirections of every process
+   * @return results in the order of the executables
+   */
+  std::vector<Result> run(
+      std::span<const Executable> executables,
+      const Stdio& stdio = Stdio{ .in = Redirection::null(), }
+  );
+  /*!
+   * @brief runs the specified executables and waits for all of them
+   * @note the executables are started in their order, at most
+   *     CommandRunner::concurrency() processes run at a time
+   * @note blocks the calling thread until the last process is waited,
+   *     the output is read by the calling thread in the meantime
+   * @note not thread-safe
+   * @param executables are the executables to be run
+   * @param stdio are the redirections of every process
+   *     @see Process::create(const ExecPlan&, const Stdio&)
+   *     @note a stdin of Redirection::Kind::PIPE is closed at once
+   *     @note stdout and stderr of Redirection::Kind::PIPE are collected
+   *         into the results, other kinds are not read by this process
+   * @return tuple containing
+   *     results in the order of the executables
+   *     ProcessReactor::RunError::NO_ERROR if all the executables have been
+   *         run, otherwise error code of the reactor
+   *         @note if there was an error -> the running processes are killed
+   *             and waited, the remaining executables are not started
+   */
+  std::tuple<std::vector<Result>, ProcessReactor::RunError> runCautious(
+      std::span<const Executable> executables,
+      const Stdio& stdio = Stdio{ .in = Redirection::null(), }
+  );
+  /*!
+   * @brief accesses the maximal number of processes at a time
+   * @return maximal number of processes at a time
+   */
+  std::size_t concurrency() const;
+protected:
+  /*!
+   * @brief constructs an instance with the specified reactor
+   * @param reactor supervises the processes
+   * @param concurrency is the maximal number of processes at a time
+   */
+  CommandRunner(ProcessReactor reactor, const std::size_t& concurrency);
+  /*!
+   * @brief runs executables in the order chosen by the specified callbacks
+   * @note stops when no process is running and no executable is chosen
+   * @tparam Next is invocable without arguments returning
+   *     std::optional<std::size_t> (the index of the executable to be
+   *     started next or empty if none can be started now)
+   * @tparam Finish is invocable with const std::size_t& (the index of
+   *     the executable whose result is complete)
+   * @param executables are the executables
+   * @param stdio are the redirections of every process
+   * @param results are the results of the executables
+   * @param next chooses the executable to be started in a free slot
+   * @param finish is called after the result of an executable is complete
+   * @return @see CommandRunner::runCautious()
+   */
+  template <class Next, class Finish>
+  ProcessReactor::RunError runWith(
+      std::span<const Executable> executables,
+      const Stdio& stdio,
+      std::vector<Result>& results,
+      Next&& next,
+      Finish&& finish
+  );
+  //! supervises the running processes
+  ProcessReactor reactor_;
+  //! maximal number of processes at a time
+  std::size_t concurrency_ = 1;
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<signal.h>)
+inline std::variant<CommandRunner, ProcessReactor::CreateError>
+CommandRunner::create(const std::size_t& concurrency) {
+  auto created = ProcessReactor::create();
+  if (std::holds_alternative<ProcessReactor::CreateError>(created)) {
+    return std::get<ProcessReactor::CreateError>(created);
+  }
+  return CommandRunner{
+    std::get<ProcessReactor>(std::move(created)),
+    std::max(concurrency, std::size_t{1}),
+  };
+}
+
+inline std::vector<CommandRunner::Result> CommandRunner::run(
+    std::span<const Executable> executables,
+    const Stdio& stdio
+) {
+  return std::get<0>(this->runCautious(executables, stdio));
+}
+
+inline std::tuple<
+    std::vector<CommandRunner::Result>,
+    ProcessReactor::RunError
+> CommandRunner::runCautious(
+    std::span<const Executable> executables,
+    const Stdio& stdio
+) {
+  auto results = std::vector<Result>(executables.size());
+  auto next = std::size_t{0};
+  const auto ret = this->runWith(
+      executables,
+      stdio,
+      results,
+      [&next, &executables]() -> std::optional<std::size_t> {
+        if (next == executables.size()) {
+          return std::nullopt;
+        }
+        return next++;
+      },
+      [](const std::size_t&) {}
+  );
+  return { std::move(results), ret, };
+}
+
+inline std::size_t CommandRunner::concurrency() const {
+  return this->concurrency_;
+}
+
+inline CommandRunner::CommandRunner(
+    ProcessReactor reactor,
+    const std::size_t& concurrency
+) : reactor_{std::move(reactor)}
+  , concurrency_{concurrency}
+{}
+
+template <class Next, class Finish>
+ProcessReactor::RunError CommandRunner::runWith(
+    std::span<const Executable> executables,
+    const Stdio& stdio,
+    std::vector<Result>& results,
+    Next&& next,
+    Finish&& finish
+) {
+  //! a process is kept at a stable address while it is registered
+  auto slots = std::vector<std::optional<Process>>(
+      std::min(this->concurrency_, executables.size())
+  );
+  //! indices of the slots without a running process
+  auto free = std::vector<std::size_t>{};
+  free.reserve(slots.size());
+  for (auto i = slots.size(); i > 0; i--) {
+    free.push_back(i - 1);
+  }
+  //! indices of the executables run in the slots
+  auto jobs = std::vector<std::size_t>(slots.size());
+  //! starts the next executables in the free slots
+  const auto start = [&]() {
+    while (!free.empty()) {
+      const auto nextJob = next();
+      if (!nextJob.has_value()) {
+        break;
+      }
+      const auto job = *nextJob;
+      auto& result = results[job];
+      const auto started = std::chrono::steady_clock::now();
+      auto created = Process::create(executables[job], stdio);
+      if (std::holds_alternative<Process::CreateError>(created)) {
+        result.error = std::get<Process::CreateError>(created);
+        finish(job);
+        continue;
+      }
+      const auto slot = free.back();
+      auto& process = slots[slot].emplace(
+          std::get<Process>(std::move(created))
+      );
+      process.closeStdin();
+      jobs[slot] = job;
+      const auto added = this->reactor_.add(
+          process,
+          ProcessReactor::Handlers{
+            .onStdout = [&result](
+                Process&,
+                std::span<const std::byte> chunk
+            ) {
+              result.out.append(
+                  reinterpret_cast<const char*>(chunk.data()), chunk.size()
+              );
+            },
+            .onStderr = [&result](
+                Process&,
+                std::span<const std::byte> chunk
+            ) {
+              result.err.append(
+                  reinterpret_cast<const char*>(chunk.data()), chunk.size()
+              );
+            },
+            .onExit = [&result, &free, slot, started](Process& process) {
+              result.exitCode = process.exitCode();
+              result.duration = std::chrono::steady_clock::now() - started;
+              free.push_back(slot);
+            },
+          }
+      );
+      if (added != ProcessReactor::AddError::NO_ERROR) {
+        //! not supervised => collected by this thread at once
+        for (const auto& fd : { process.stdoutPipe(), process.stderrPipe(), }) {
+          ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        }
+        result.out = process.stdout();
+        result.err = process.stderr();
+        process.wait();
+        result.exitCode = process.exitCode();
+        result.duration = std::chrono::steady_clock::now() - started;
+        slots[slot].reset();
+        finish(job);
+        continue;
+      }
+      free.pop_back();
+    }
+  };
+  start();
+  auto ret = ProcessReactor::RunError::NO_ERROR;
+  while (this->reactor_.size() != 0) {
+    const auto released = free.size();
+    const auto [_, error] = this->reactor_.runOnce();
+    if (error != ProcessReactor::RunError::NO_ERROR) {
+      if (error == ProcessReactor::RunError::INTR) {
+        continue;
+      }
+      ret = error;
+      break;
+    }
+    //! the exited processes are not referenced by the reactor anymore
+    for (auto i = released; i < free.size(); i++) {
+      slots[free[i]].reset();
+      finish(jobs[free[i]]);
+    }
+    start();
+  }
+  if (ret != ProcessReactor::RunError::NO_ERROR) {
+    for (auto i = std::size_t{0}; i < slots.size(); i++) {
+      auto& slot = slots[i];
+      if (slot.has_value() && slot->exitCode() == std::nullopt) {
+        this->reactor_.remove(*slot);
+        slot->signal(SIGKILL);
+        slot->wait();
+        results[jobs[i]].exitCode = slot->exitCode();
+      }
+    }
+  }
+  return ret;
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_COMMAND_RUNNER_HH_
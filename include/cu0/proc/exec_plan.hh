@@ -0,0 +1,263 @@
+#ifndef CU0_EXEC_PLAN_HH_
+#define CU0_EXEC_PLAN_HH_
+
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <cu0/proc/executable.hh>
+
+namespace cu0 {
+
+/*!
+ * @brief The ExecPlan struct provides argv and envp of an executable packed
+ *     into one contiguous arena
+ * @note an instance can be reused for many spawns of the same binary
+ *     @see Process::create(const ExecPlan&)
+ * @note patching an argument does not allocate memory as long as the arena
+ *     capacity is sufficient @see ExecPlan::reserve()
+ */
+struct ExecPlan {
+public:
+  enum struct PatchError {
+    NO_ERROR = 0, //! no error
+    INVAL = EINVAL, //! the index is not less than ExecPlan::argumentCount()
+  };
+  /*!
+   * @brief constructs an instance from the specified executable
+   * @param executable is the executable to be packed
+   */
+  explicit ExecPlan(const Executable& executable);
+  /*!
+   * @brief copies the arena of the specified plan
+   * @param other is the plan to be copied
+   */
+  ExecPlan(const ExecPlan& other);
+  /*!
+   * @brief copies the arena of the specified plan
+   * @param other is the plan to be copied
+   * @return this plan as mutable reference
+   */
+  ExecPlan& operator =(const ExecPlan& other);
+  ExecPlan(ExecPlan&& other) = default;
+  ExecPlan& operator =(ExecPlan&& other) = default;
+  /*!
+   * @brief destructs an instance
+   */
+  virtual ~ExecPlan() = default;
+  /*!
+   * @brief accesses the NULL-terminated argument list
+   * @note argv()[0] is the path to the binary
+   * @note pointers are invalidated by ExecPlan::argument(index, value)
+   * @return ptr to the first element of the list
+   */
+  char* const* argv() const;
+  /*!
+   * @brief accesses the NULL-terminated environment list
+   * @note elements are in format of "key=value"
+   * @note pointers are invalidated by ExecPlan::argument(index, value)
+   * @return ptr to the first element of the list
+   */
+  char* const* envp() const;
+  /*!
+   * @brief accesses the number of arguments
+   * @note the binary is not counted
+   * @return number of arguments
+   */
+  std::size_t argumentCount() const;
+  /*!
+   * @brief accesses an argument
+   * @param index is the index of the argument @see Executable::arguments
+   * @return
+   *     if the index is less than ExecPlan::argumentCount() ->
+   *         view of the argument valid until the next patch
+   *     else -> empty view
+   */
+  std::string_view argument(const std::size_t& index) const;
+  /*!
+   * @brief patches an argument
+   * @note the tail of the arena is moved in place ->
+   *     no memory is allocated if the arena capacity is sufficient
+   * @param index is the index of the argument @see Executable::arguments
+   * @param value is the new value of the argument
+   * @return error code @see PatchError
+   *     @note if an error is returned -> the plan is left untouched
+   */
+  PatchError argument(const std::size_t& index, std::string_view value);
+  /*!
+   * @brief reserves the arena capacity
+   * @param bytes is the minimal capacity of the arena in bytes
+   */
+  void reserve(const std::size_t& bytes);
+  /*!
+   * @brief accesses the arena size
+   * @return number of bytes used by all the NUL-terminated strings
+   */
+  std::size_t size() const;
+  /*!
+   * @brief accesses the arena capacity
+   * @return number of bytes that can be used without allocation
+   */
+  std::size_t capacity() const;
+protected:
+  /*!
+   * @brief appends a NUL-terminated string to the arena
+   * @param value is the string to be appended
+   */
+  void append(std::string_view value);
+  /*!
+   * @brief points argv and envp at the strings of the arena
+   */
+  void relink();
+  //! NUL-terminated strings: binary, arguments, "key=value" environment
+  std::vector<char> arena_{};
+  //! offset of each string in the arena
+  std::vector<std::size_t> offsets_{};
+  //! argv followed by envp, both NULL-terminated
+  std::vector<char*> pointers_{};
+  //! number of arguments including the binary
+  std::size_t argc_ = 0;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline ExecPlan::ExecPlan(const Executable& executable)
+  : argc_{1 + executable.arguments.size()}
+{
+  auto bytes = executable.binary.string().size() + 1;
+  for (const auto& argument : executable.arguments) {
+    bytes += argument.size() + 1;
+  }
+  for (const auto& [key, value] : executable.environment) {
+    bytes += key.size() + 1 + value.size() + 1;
+  }
+  this->arena_.reserve(bytes);
+  this->offsets_.reserve(this->argc_ + executable.environment.size());
+  this->pointers_.resize(this->argc_ + 1 + executable.environment.size() + 1);
+  this->append(executable.binary.string());
+  for (const auto& argument : executable.arguments) {
+    this->append(argument);
+  }
+  for (const auto& [key, value] : executable.environment) {
+    this->offsets_.push_back(this->arena_.size());
+    this->arena_.insert(this->arena_.end(), key.begin(), key.end());
+    this->arena_.push_back('=');
+    this->arena_.insert(this->arena_.end(), value.begin(), value.end());
+    this->arena_.push_back('\0');
+  }
+  this->relink();
+}
+
+inline ExecPlan::ExecPlan(const ExecPlan& other)
+  : arena_{other.arena_}
+  , offsets_{other.offsets_}
+  , pointers_{other.pointers_}
+  , argc_{other.argc_}
+{
+  this->relink();
+}
+
+inline ExecPlan& ExecPlan::operator =(const ExecPlan& other) {
+  if (this != &other) {
+    this->arena_ = other.arena_;
+    this->offsets_ = other.offsets_;
+    this->pointers_ = other.pointers_;
+    this->argc_ = other.argc_;
+    this->relink();
+  }
+  return *this;
+}
+
+inline char* const* ExecPlan::argv() const {
+  return this->pointers_.data();
+}
+
+inline char* const* ExecPlan::envp() const {
+  return this->pointers_.data() + this->argc_ + 1;
+}
+
+inline std::size_t ExecPlan::argumentCount() const {
+  return this->argc_ - 1;
+}
+
+inline std::string_view ExecPlan::argument(const std::size_t& index) const {
+  if (index >= this->argumentCount()) {
+    return {};
+  }
+  return this->pointers_[1 + index];
+}
+
+inline ExecPlan::PatchError ExecPlan::argument(
+    const std::size_t& index,
+    std::string_view value
+) {
+  //! the offsets of the environment follow the offsets of the arguments
+  if (index >= this->argumentCount()) {
+    return PatchError::INVAL;
+  }
+  const auto i = 1 + index;
+  const auto begin = this->offsets_[i];
+  const auto end = i + 1 < this->offsets_.size() ?
+      this->offsets_[i + 1] : this->arena_.size();
+  const auto oldSize = end - begin;
+  const auto newSize = value.size() + 1;
+  const auto tailSize = this->arena_.size() - end;
+  if (newSize > oldSize) {
+    this->arena_.resize(this->arena_.size() + newSize - oldSize);
+  }
+  std::memmove(
+      this->arena_.data() + begin + newSize,
+      this->arena_.data() + end,
+      tailSize
+  );
+  std::memcpy(this->arena_.data() + begin, value.data(), value.size());
+  this->arena_[begin + value.size()] = '\0';
+  if (newSize < oldSize) {
+    //! shrinking does not free the capacity
+    this->arena_.resize(this->arena_.size() - (oldSize - newSize));
+  }
+  for (auto j = i + 1; j < this->offsets_.size(); j++) {
+    this->offsets_[j] = this->offsets_[j] + newSize - oldSize;
+  }
+  this->relink();
+  return PatchError::NO_ERROR;
+}
+
+inline void ExecPlan::reserve(const std::size_t& bytes) {
+  this->arena_.reserve(bytes);
+  this->relink();
+}
+
+inline std::size_t ExecPlan::size() const {
+  return this->arena_.size();
+}
+
+inline std::size_t ExecPlan::capacity() const {
+  return this->arena_.capacity();
+}
+
+inline void ExecPlan::append(std::string_view value) {
+  this->offsets_.push_back(this->arena_.size());
+  this->arena_.insert(this->arena_.end(), value.begin(), value.end());
+  this->arena_.push_back('\0');
+}
+
+inline void ExecPlan::relink() {
+  auto* const base = this->arena_.data();
+  for (auto i = 0u; i < this->argc_; i++) {
+    this->pointers_[i] = base + this->offsets_[i];
+  }
+  this->pointers_[this->argc_] = NULL;
+  for (auto i = this->argc_; i < this->offsets_.size(); i++) {
+    this->pointers_[i + 1] = base + this->offsets_[i];
+  }
+  this->pointers_[this->offsets_.size() + 1] = NULL;
+}
+
+} /// namespace cu0
+
+#endif /// CU0_EXEC_PLAN_HH_
@@ -0,0 +1,210 @@
+#ifndef CU0_PIPELINE_HH_
+#define CU0_PIPELINE_HH_
+
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/exec_plan.hh>
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<signal.h>) || !__has_include(<sys/types.h>) || \
+    !__has_include(<sys/wait.h>)
+#warning <signal.h> or <sys/types.h> or <sys/wait.h> is not found => \
+    processes of a failed cu0::Pipeline::create() will not be waited
+#else
+#include <signal.h>
+#endif
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The Pipeline struct provides a way to create processes connected
+ *     by pipes the way a shell does for "a | b | c"
+ * @note stdout of every process is connected to stdin of the next process
+ *     before the execution -> data does not pass through this process
+ * @see Pipeline::then()
+ * @see Pipeline::create()
+ */
+struct Pipeline {
+public:
+  /*!
+   * @brief appends a stage to the pipeline
+   * @param executable is the executable to be run by the stage
+   * @return this pipeline as mutable reference
+   */
+  Pipeline& then(const Executable& executable);
+  /*!
+   * @brief sets whether stderr of a stage is merged into its stdout
+   * @note if merged -> Process::stderrPipe() of the created processes is -1
+   * @note if not merged -> every Process::stderrPipe() has to be read
+   *     @see Pipeline::create()
+   * @param merge is true to merge stderr into stdout ("a 2>&1 | b")
+   * @return this pipeline as mutable reference
+   */
+  Pipeline& mergeStderr(const bool& merge = true);
+  /*!
+   * @brief accesses the number of stages
+   * @return number of stages
+   */
+  std::size_t size() const;
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates processes of all the stages
+   * @note all the processes run concurrently
+   * @note Process::stdin() is supported only by the first process,
+   *     Process::stdout() is supported only by the last process
+   * @note if stderr is not merged -> stderr of every process is a pipe
+   *     which has to be read by the caller (e.g. by cu0::ProcessReactor)
+   *     @note a process writing more than the pipe buffer (64 KiB on Linux)
+   *         to an unread stderr blocks => reading only the stdout of
+   *         the last process then never ends
+   * @param strategy is the way to spawn the processes
+   *     @see Process::SpawnStrategy
+   * @return
+   *     if there were no errors -> created processes in the order of stages
+   *     if there was an error -> error code
+   *         @note processes created before the error are killed
+   *             (SIGKILL) and waited
+   *         @note Process::CreateError::INVAL is returned for no stages
+   */
+  [[nodiscard]] std::variant<std::vector<Process>, Process::CreateError>
+  create(
+      const Process::SpawnStrategy& strategy = Process::SpawnStrategy::VFORK
+  ) const;
+#endif
+#endif
+protected:
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief kills and waits the specified processes of a failed creation
+   * @param processes are the processes created before the error
+   */
+  static void stop(std::vector<Process>& processes);
+#endif
+#endif
+  //! packed executables of the stages
+  std::vector<ExecPlan> stages_{};
+  //! true if stderr of a stage is merged into its stdout
+  bool mergeStderr_ = false;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline Pipeline& Pipeline::then(const Executable& executable) {
+  this->stages_.emplace_back(executable);
+  return *this;
+}
+
+inline Pipeline& Pipeline::mergeStderr(const bool& merge) {
+  this->mergeStderr_ = merge;
+  return *this;
+}
+
+inline std::size_t Pipeline::size() const {
+  return this->stages_.size();
+}
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+inline std::variant<std::vector<Process>, Process::CreateError>
+Pipeline::create(const Process::SpawnStrategy& strategy) const {
+  if (this->stages_.empty()) {
+    return Process::CreateError::INVAL;
+  }
+  auto processes = std::vector<Process>{};
+  processes.reserve(this->stages_.size());
+  int inFd[2];
+  if (Process::pipeOf(inFd) != 0) {
+    return static_cast<Process::CreateError>(errno);
+  }
+  //! read end of the pipe to become stdin of the next stage
+  auto previousFd = inFd[0];
+  for (auto i = 0u; i < this->stages_.size(); i++) {
+    int outFd[2] = { -1, -1, };
+    int errFd[2] = { -1, -1, };
+    if (
+        Process::pipeOf(outFd) != 0 ||
+        (!this->mergeStderr_ && Process::pipeOf(errFd) != 0)
+    ) {
+      const auto ret = static_cast<Process::CreateError>(errno);
+      //! only the created pipe ends are closed
+      for (const auto& fd : { outFd[0], outFd[1], errFd[0], errFd[1], }) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+      }
+      ::close(previousFd);
+      if (i == 0) {
+        ::close(inFd[1]);
+      }
+      Pipeline::stop(processes);
+      return ret;
+    }
+    const auto spawned = Process::spawn(
+        this->stages_[i].argv(),
+        this->stages_[i].envp(),
+        { previousFd, outFd[1], this->mergeStderr_ ? outFd[1] : errFd[1], },
+        strategy
+    );
+    ::close(previousFd);
+    ::close(outFd[1]);
+    if (!this->mergeStderr_) {
+      ::close(errFd[1]);
+    }
+    if (std::holds_alternative<Process::CreateError>(spawned)) {
+      ::close(outFd[0]);
+      if (!this->mergeStderr_) {
+        ::close(errFd[0]);
+      }
+      if (i == 0) {
+        ::close(inFd[1]);
+      }
+      Pipeline::stop(processes);
+      return std::get<Process::CreateError>(spawned);
+    }
+    const auto [pid, pidfd] = std::get<std::tuple<pid_t, int>>(spawned);
+    auto& process = processes.emplace_back(Process{});
+    process.pid_ = pid;
+    process.pidfd_ = pidfd;
+    process.stderrPipe_ = errFd[0];
+    if (i == 0) {
+      process.stdinPipe_ = inFd[1];
+    }
+    if (i + 1 == this->stages_.size()) {
+      process.stdoutPipe_ = outFd[0];
+    } else {
+      previousFd = outFd[0];
+    }
+  }
+  return processes;
+}
+
+inline void Pipeline::stop(std::vector<Process>& processes) {
+#if __has_include(<signal.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+  //! all the processes are signalled first => they exit concurrently
+  for (auto& process : processes) {
+    process.signal(SIGKILL);
+  }
+  for (auto& process : processes) {
+    process.wait();
+  }
+#endif
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_PIPELINE_HH_
@@ -1,11 +1,25 @@
 #ifndef CU0_PROCESS_HH_
 #define CU0_PROCESS_HH_
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
-#include <sstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
+#include <cu0/proc/exec_plan.hh>
 #include <cu0/proc/executable.hh>
+#include <cu0/proc/stdio.hh>
 
 /*!
  * @brief checks software compatibility during compile-time
@@ -20,6 +34,8 @@
     cu0::Process::stdin() will not be supported
 #warning <unistd.h> is not found => \
     cu0::Process::stdinCautious() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::closeStdin() will not be supported
 #warning <unistd.h> is not found => \
     cu0::Process::stdout() will not be supported
 #warning <unistd.h> is not found => \
@@ -28,9 +44,60 @@
     cu0::Process::stderr() will not be supported
 #warning <unistd.h> is not found => \
     cu0::Process::stderrCautious() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdoutChunks() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stderrChunks() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdoutLines() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stderrLines() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdoutTo() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stderrTo() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdoutTee() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stderrTee() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdinSpliced() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::Process::stdinSplicedCautious() will not be supported
 #else
 #include <unistd.h>
 #endif
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::Process::create() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stdoutTo() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stderrTo() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stdoutTee() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stderrTee() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stdinSpliced() will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::Process::stdinSplicedCautious() will not be supported
+#else
+#include <fcntl.h>
+#endif
+#if !__has_include(<spawn.h>)
+#warning <spawn.h> is not found => \
+    cu0::Process::SpawnStrategy::POSIX_SPAWN will not be supported
+#else
+#include <spawn.h>
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 39)) && \
+    __has_include(<sys/pidfd.h>)
+//! pidfd_spawn() and pidfd_getpid() are provided by glibc 2.39+
+#define CU0_PIDFD_SPAWN_ 1
+#include <sys/pidfd.h>
+#endif
+#endif
 #if !__has_include(<sys/types.h>)
 #warning <sys/types.h> is not found => \
     cu0::Process::wait() will not be supported
@@ -63,6 +130,84 @@
 #else
 #include <signal.h>
 #endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::Process::pidfd() will not be supported
+#else
+#include <sys/syscall.h>
+#endif
+#if !__has_include(<sys/uio.h>)
+#warning <sys/uio.h> is not found => \
+    cu0::Process::stdin(std::span<const std::string_view>) will not be supported
+#warning <sys/uio.h> is not found => \
+    cu0::Process::stdinCautious(std::span<const std::string_view>) will not be \
+    supported
+#warning <sys/uio.h> is not found => \
+    cu0::Process::stdinSpliced() will not be supported
+#warning <sys/uio.h> is not found => \
+    cu0::Process::stdinSplicedCautious() will not be supported
+#else
+#include <sys/uio.h>
+#endif
+#if !__has_include(<sys/ioctl.h>)
+#warning <sys/ioctl.h> is not found => \
+    cu0::Process::stdout() will not use the pending size hint
+#warning <sys/ioctl.h> is not found => \
+    cu0::Process::stderr() will not use the pending size hint
+#else
+#include <sys/ioctl.h>
+#endif
+#if !__has_include(<poll.h>)
+#warning <poll.h> is not found => \
+    cu0::Process::communicate() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::communicateCautious() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::waitFor() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::waitUntil() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::terminate() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::terminateCautious() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::waitAny() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::waitAll() will not be supported
+#warning <poll.h> is not found => \
+    cu0::Process::waitAllUntil() will not be supported
+#else
+#include <poll.h>
+#endif
+#if !__has_include(<sys/resource.h>)
+#warning <sys/resource.h> is not found => \
+    cu0::Process::resourceUsage() will not be supported
+#else
+#include <sys/resource.h>
+#endif
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::Process::stdoutTee() will not be supported
+#warning <sys/stat.h> is not found => \
+    cu0::Process::stderrTee() will not be supported
+#else
+#include <sys/stat.h>
+#endif
+#if !__has_include(<sys/mman.h>)
+#warning <sys/mman.h> is not found => \
+    cu0::Redirection::Kind::MEMORY will not be supported
+#else
+#include <sys/mman.h>
+#endif
+#if !__has_include(<sched.h>) || !__has_include(<sys/mman.h>)
+#warning <sched.h> or <sys/mman.h> is not found => \
+    cu0::Process::SpawnStrategy::CLONE will not be supported
+#else
+#include <sched.h>
+#endif
+#if __has_include(<linux/sched.h>)
+#include <linux/sched.h>
+#endif
 #else
 #warning __unix__ is not defined => \
     cu0::Process::current() will not be supported
@@ -72,14 +217,32 @@
     cu0::Process::wait() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::waitCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::waitFor() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::waitUntil() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::terminate() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::terminateCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::waitAny() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::waitAll() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::waitAllUntil() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::exitCode() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::terminationCode() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::resourceUsage() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::stdin() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::stdinCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::closeStdin() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::stdout() will not be supported
 #warning __unix__ is not defined => \
@@ -88,10 +251,36 @@
     cu0::Process::stderr() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::stderrCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutChunks() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stderrChunks() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutLines() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stderrLines() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutTo() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stderrTo() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdoutTee() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stderrTee() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdinSpliced() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::stdinSplicedCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::communicate() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::communicateCautious() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::signal() will not be supported
 #warning __unix__ is not defined => \
     cu0::Process::signalCautious() will not be supported
+#warning __unix__ is not defined => \
+    cu0::Process::pidfd() will not be supported
 #endif
 
 namespace cu0 {
@@ -101,6 +290,18 @@ namespace cu0 {
  */
 struct Process {
 public:
+  friend struct Pipeline;
+  friend struct ProcessReactor;
+  friend struct SpawnServer;
+  friend struct ResultCache;
+  friend struct WorkerPool;
+  friend struct ZygotePool;
+  //! default maximal number of bytes passed to one write() by Process::stdin()
+  //! @see measurements/measurement_cu0_process_pipe_io.cc
+  static constexpr std::size_t WRITE_SIZE = std::size_t{1} << 20;
+  //! default size of one read() by Process::stdout()
+  //! @see measurements/measurement_cu0_process_pipe_io.cc
+  static constexpr std::size_t READ_SIZE = std::size_t{1} << 16;
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   enum struct CreateError {
@@ -111,6 +312,44 @@ public:
     INVAL = EINVAL, //! @see EINVAL
     MFILE = EMFILE, //! @see EMFILE
     NFILE = ENFILE, //! @see ENFILE
+    NOSYS = ENOSYS, //! @see ENOSYS
+    PIPE = EPIPE, //! @see EPIPE
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::posix_spawn()
+  };
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief The SpawnStrategy enum lists the ways to spawn a process
+   * @note if a strategy is not supported by the platform ->
+   *     Process::create() returns CreateError::NOSYS
+   */
+  enum struct SpawnStrategy {
+    //! vfork() + execve()
+    //! @note the parent is suspended until the child calls execve()
+    //! @note the process file descriptor is opened from the pid after
+    //!     the spawn @see Process::pidfdOf()
+    VFORK = 0,
+    //! fork() + execve()
+    //! @note page tables of the parent are copied
+    //! @note the process file descriptor is opened from the pid after
+    //!     the spawn @see Process::pidfdOf()
+    FORK,
+    //! posix_spawn() or pidfd_spawn() if provided by the C library
+    //! @note errors of execve() are returned by Process::create()
+    //!     instead of being the exit status code of the created process
+    //! @note the process file descriptor is obtained atomically with the pid
+    //!     by pidfd_spawn(), otherwise it is opened from the pid after
+    //!     the spawn @see Process::pidfdOf()
+    POSIX_SPAWN,
+    //! clone(CLONE_VM | CLONE_VFORK | CLONE_PIDFD) + execve()
+    //! @note page tables are shared as for vfork() and the parent is
+    //!     suspended until the child calls execve(), the child runs on
+    //!     a dedicated stack with signal handlers reset to SIG_DFL
+    //! @note the process file descriptor is obtained atomically with the pid
+    CLONE,
   };
 #endif
 #endif
@@ -121,6 +360,33 @@ public:
     CHILD = ECHILD, //! @see ECHILD
     INVAL = EINVAL, //! @see EINVAL
     INTR = EINTR, //! @see EINTR
+    TIMEDOUT = ETIMEDOUT, //! the deadline passed before the process exited
+  };
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+  /*!
+   * @brief The ResourceUsage struct contains resources used by a waited
+   *     process as accounted by the kernel @see getrusage()
+   */
+  struct ResourceUsage {
+    //! cpu time spent in the user mode
+    std::chrono::microseconds userTime{};
+    //! cpu time spent in the kernel mode
+    std::chrono::microseconds systemTime{};
+    //! maximal resident set size in kilobytes
+    long maxResidentSetSize = 0;
+    //! page faults serviced without any i/o
+    long minorPageFaults = 0;
+    //! page faults serviced with i/o
+    long majorPageFaults = 0;
+    //! context switches because the process waited for a resource
+    long voluntaryContextSwitches = 0;
+    //! context switches because the time slice of the process expired or
+    //!     a process with a higher priority became runnable
+    long involuntaryContextSwitches = 0;
   };
 #endif
 #endif
@@ -202,12 +468,77 @@ public:
   /*!
    * @brief creates a process using the specified executable
    * @param executable is the excutable to be run by the process
+   * @param strategy is the way to spawn the process @see SpawnStrategy
+   * @return
+   *     if there were no errors -> created process
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<Process, CreateError> create(
+      const Executable& executable,
+      const SpawnStrategy& strategy = SpawnStrategy::VFORK
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process using the specified plan
+   * @note no memory is allocated for argv and envp @see ExecPlan
+   * @param plan is the packed executable to be run by the process
+   * @param strategy is the way to spawn the process @see SpawnStrategy
+   * @return
+   *     if there were no errors -> created process
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<Process, CreateError> create(
+      const ExecPlan& plan,
+      const SpawnStrategy& strategy = SpawnStrategy::VFORK
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process using the specified executable and stdio
+   * @param executable is the excutable to be run by the process
+   * @param stdio are the redirections of the process @see Stdio
+   * @param strategy is the way to spawn the process @see SpawnStrategy
+   * @return
+   *     if there were no errors -> created process
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<Process, CreateError> create(
+      const Executable& executable,
+      const Stdio& stdio,
+      const SpawnStrategy& strategy = SpawnStrategy::VFORK
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process using the specified plan and stdio
+   * @note pipes are created only for streams of Redirection::Kind::PIPE,
+   *     other pipe file descriptors of the created process are -1
+   *     @see Process::stdinPipe()
+   * @note files of Redirection::Kind::PATH and Redirection::Kind::NUL are
+   *     opened by this process and closed after the spawn =>
+   *     the written data do not pass through this process
+   * @param plan is the packed executable to be run by the process
+   * @param stdio are the redirections of the process @see Stdio
+   * @param strategy is the way to spawn the process @see SpawnStrategy
    * @return
    *     if there were no errors -> created process
    *     if there was an error -> error code
+   *         @note CreateError::INVAL is returned for Redirection::Kind::STDOUT
+   *             of stdin or stdout, for Redirection::Kind::MEMORY of stdout
+   *             or stderr and for negative file descriptors
+   *         @note errors of ::open() are returned as they are
    */
   [[nodiscard]] static std::variant<Process, CreateError> create(
-      const Executable& executable
+      const ExecPlan& plan,
+      const Stdio& stdio,
+      const SpawnStrategy& strategy = SpawnStrategy::VFORK
   );
 #endif
 #endif
@@ -233,6 +564,31 @@ public:
    * @return process identifier as a const reference
    */
   constexpr const unsigned& pid() const;
+  /*!
+   * @brief accesses process file descriptor value
+   * @note process file descriptor is -1 if it is not supported by the system or
+   *     if the process has not been created by Process::create()
+   * @return process file descriptor as a const reference
+   */
+  constexpr const int& pidfd() const;
+  /*!
+   * @brief accesses stdin file descriptor value
+   * @note the file descriptor is the write end of a pipe or -1
+   * @return stdin file descriptor as a const reference
+   */
+  constexpr const int& stdinPipe() const;
+  /*!
+   * @brief accesses stdout file descriptor value
+   * @note the file descriptor is the read end of a pipe or -1
+   * @return stdout file descriptor as a const reference
+   */
+  constexpr const int& stdoutPipe() const;
+  /*!
+   * @brief accesses stderr file descriptor value
+   * @note the file descriptor is the read end of a pipe or -1
+   * @return stderr file descriptor as a const reference
+   */
+  constexpr const int& stderrPipe() const;
 #ifdef __unix__
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
   /*!
@@ -253,6 +609,145 @@ public:
 #endif
 #endif
 #ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief waitFor waits for the process to exit or to be terminated
+   *     at most for the specified duration
+   * @see Process::waitUntil()
+   * @tparam Rep is the representation of the duration
+   * @tparam Period is the period of the duration
+   * @param duration is the maximal duration of the wait
+   * @return result of Process::waitUntil()
+   */
+  template <class Rep, class Period>
+  WaitError waitFor(const std::chrono::duration<Rep, Period>& duration);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief waitUntil waits for the process to exit or to be terminated
+   *     until the specified deadline
+   * @note blocks without consuming cpu time:
+   *     if the process file descriptor is present ->
+   *         polls the process file descriptor
+   *     else -> polls waitpid(WNOHANG) with exponentially growing sleeps
+   * @tparam Clock is the clock of the deadline
+   * @tparam Duration is the duration type of the deadline
+   * @param deadline is the time point until which to wait
+   * @return
+   *     if the process has been waited -> WaitError::NO_ERROR
+   *     if the deadline passed first -> WaitError::TIMEDOUT
+   *     if there was an error -> error code
+   */
+  template <class Clock, class Duration>
+  WaitError waitUntil(
+      const std::chrono::time_point<Clock, Duration>& deadline
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+  /*!
+   * @brief terminate sends SIGTERM to the process, waits for it at most for
+   *     the specified grace period and sends SIGKILL if it is still running
+   * @note the process is waited when the function returns
+   * @tparam Rep is the representation of the duration
+   * @tparam Period is the period of the duration
+   * @param grace is the time given to the process to exit after SIGTERM
+   */
+  template <class Rep, class Period>
+  void terminate(const std::chrono::duration<Rep, Period>& grace);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+  /*!
+   * @brief terminate sends SIGTERM to the process, waits for it at most for
+   *     the specified grace period and sends SIGKILL if it is still running
+   * @see Process::terminate()
+   * @note no signal is sent to a process which has already been waited =>
+   *     a reused pid is not signalled
+   * @tparam Rep is the representation of the duration
+   * @tparam Period is the period of the duration
+   * @param grace is the time given to the process to exit after SIGTERM
+   * @return
+   *     if the process has been waited -> WaitError::NO_ERROR
+   *     if there is no process (default constructed or moved from) ->
+   *         WaitError::CHILD
+   *     if there was an error -> error code
+   */
+  template <class Rep, class Period>
+  WaitError terminateCautious(const std::chrono::duration<Rep, Period>& grace);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief waitAny waits for any of the specified processes to exit or to be
+   *     terminated
+   * @note processes which have already been waited are skipped =>
+   *     repeated calls return every process once
+   * @note one poll() is done over all the process file descriptors;
+   *     processes without it are polled by waitpid(WNOHANG)
+   * @param processes are the processes to wait for
+   * @return
+   *     if a process has been waited -> index of the process
+   *     if all the processes have already been waited -> WaitError::CHILD
+   *     if there was an error -> error code
+   */
+  static std::variant<std::size_t, WaitError> waitAny(
+      std::span<Process> processes
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief waitAll waits for all the specified processes to exit or to be
+   *     terminated
+   * @note processes which have already been waited are skipped
+   * @note one poll() is done over the process file descriptors which are
+   *     not ready yet => every wakeup waits all the exited processes
+   * @param processes are the processes to wait for
+   * @return
+   *     if all the processes have been waited -> WaitError::NO_ERROR
+   *     if there was an error -> the first error code
+   */
+  static WaitError waitAll(std::span<Process> processes);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief waitAllUntil waits for all the specified processes to exit or to be
+   *     terminated until the specified deadline
+   * @see Process::waitAll()
+   * @tparam Clock is the clock of the deadline
+   * @tparam Duration is the duration type of the deadline
+   * @param processes are the processes to wait for
+   * @param deadline is the time point until which to wait
+   * @return
+   *     if all the processes have been waited -> WaitError::NO_ERROR
+   *     if the deadline passed first -> WaitError::TIMEDOUT
+   *         @note processes which exited before are waited
+   *     if there was an error -> the first error code
+   */
+  template <class Clock, class Duration>
+  static WaitError waitAllUntil(
+      std::span<Process> processes,
+      const std::chrono::time_point<Clock, Duration>& deadline
+  );
+#endif
+#endif
+#ifdef __unix__
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
   /*!
    * @brief accesses exit status code
@@ -286,117 +781,516 @@ public:
 #endif
 #endif
 #ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+  /*!
+   * @brief accesses resource usage
+   * @note resource usage will be empty until the process has exited or has
+   *     been terminated and has been waited @see Process::wait()
+   * @return const reference to resource usage
+   */
+  constexpr const std::optional<ResourceUsage>& resourceUsage() const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief stdin passes the specified input to the stdin
+   * @note the input is written directly from the specified memory
+   * @tparam BUFFER_SIZE is the maximal number of bytes passed to one write()
+   * @param input is the input value
+   */
+  template <std::size_t BUFFER_SIZE = WRITE_SIZE>
+  void stdin(std::string_view input) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief stdin passes the specified input to the stdin
+   * @note the input is written directly from the specified memory
+   * @tparam BUFFER_SIZE is the maximal number of bytes passed to one write()
+   * @param input is the input value
+   */
+  template <std::size_t BUFFER_SIZE = WRITE_SIZE>
+  void stdin(std::span<const std::byte> input) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdin passes the concatenation of the specified inputs to the stdin
+   * @note the inputs are written by writev() without being concatenated
+   * @param inputs are the input values
+   */
+  void stdin(std::span<const std::string_view> inputs) const;
+#endif
+#endif
+#ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
    * @brief stdin passes the specified input to the stdin
+   * @note the input is written directly from the specified memory
+   * @tparam BUFFER_SIZE is the maximal number of bytes passed to one write()
    * @param input is the input value
+   * @return result of Process::writeInto() @see Process::writeInto()
    */
-  void stdin(const std::string& input) const;
+  template <std::size_t BUFFER_SIZE = WRITE_SIZE>
+  std::tuple<WriteError, std::size_t> stdinCautious(
+      std::string_view input
+  ) const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
    * @brief stdin passes the specified input to the stdin
+   * @note the input is written directly from the specified memory
+   * @tparam BUFFER_SIZE is the maximal number of bytes passed to one write()
    * @param input is the input value
    * @return result of Process::writeInto() @see Process::writeInto()
    */
+  template <std::size_t BUFFER_SIZE = WRITE_SIZE>
+  std::tuple<WriteError, std::size_t> stdinCautious(
+      std::span<const std::byte> input
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdin passes the concatenation of the specified inputs to the stdin
+   * @note the inputs are written by writev() without being concatenated
+   * @param inputs are the input values
+   * @return result of Process::writeVectorInto()
+   *     @see Process::writeVectorInto()
+   */
   std::tuple<WriteError, std::size_t> stdinCautious(
-      const std::string& input
+      std::span<const std::string_view> inputs
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdinSpliced passes the specified input to the stdin
+   *     without copying it
+   * @note pages of the input are referenced by the pipe (vmsplice()) =>
+   *     the input must not be modified or freed until the process has read it
+   *     (e.g. until the process has been waited)
+   *     @note write() is used if vmsplice() is not supported
+   * @note blocks until all the input is in the pipe
+   * @param input is the input to be passed to the stdin
+   */
+  void stdinSpliced(std::span<const std::byte> input) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdinSpliced passes the specified input to the stdin
+   *     without copying it
+   * @see Process::stdinSpliced(std::span<const std::byte>)
+   */
+  void stdinSpliced(std::string_view input) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdinSplicedCautious passes the specified input to the stdin
+   *     without copying it
+   * @see Process::stdinSpliced(std::span<const std::byte>)
+   * @return result of Process::spliceInto() @see Process::spliceInto()
+   */
+  std::tuple<WriteError, std::size_t> stdinSplicedCautious(
+      std::span<const std::byte> input
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  /*!
+   * @brief stdinSplicedCautious passes the specified input to the stdin
+   *     without copying it
+   * @see Process::stdinSplicedCautious(std::span<const std::byte>)
+   */
+  std::tuple<WriteError, std::size_t> stdinSplicedCautious(
+      std::string_view input
   ) const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief stdout returns the value of the stdout
+   * @brief closes the stdin so that the process reads the end of file
+   * @note the stdin file descriptor is set to -1
+   */
+  void closeStdin();
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief stdout reads the stdout until the end of file
+   * @note blocks until the process closes its stdout
+   * @tparam BUFFER_SIZE is the maximal size of a read() of not yet pending data
    * @return string containing stdout value
    */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
   std::string stdout() const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief stdout returns the value of the stdout
+   * @brief stdout reads the stdout until the end of file
+   * @note blocks until the process closes its stdout
+   * @tparam BUFFER_SIZE is the maximal size of a read() of not yet pending data
    * @return result of Process::readFrom() @see Process::readFrom()
    */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
   std::tuple<std::string, ReadError> stdoutCautious() const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief stderr returns the value of the stderr
+   * @brief stderr reads the stderr until the end of file
+   * @note blocks until the process closes its stderr
+   * @tparam BUFFER_SIZE is the maximal size of a read() of not yet pending data
    * @return string containing stderr value
    */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
   std::string stderr() const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief stderr returns the value of the stderr
+   * @brief stderr reads the stderr until the end of file
+   * @note blocks until the process closes its stderr
+   * @tparam BUFFER_SIZE is the maximal size of a read() of not yet pending data
    * @return result of Process::readFrom() @see Process::readFrom()
    */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
   std::tuple<std::string, ReadError> stderrCautious() const;
 #endif
 #endif
 #ifdef __unix__
-#if __has_include(<signal.h>)
+#if __has_include(<unistd.h>)
   /*!
-   * @brief signal sends the specified code as a signal to the process
-   * @param code is the signal to be sent
+   * @brief stdoutChunks passes the stdout to the callback chunk by chunk
+   *     until the end of file
+   * @note memory usage does not depend on the amount of output
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Callback is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops reading
+   * @param callback is called with every read chunk
+   *     @note the chunk is valid only during the call
+   * @return result of Process::readChunksFrom() @see Process::readChunksFrom()
    */
-  void signal(const int& code) const;
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Callback>
+  ReadError stdoutChunks(Callback&& callback) const;
 #endif
 #endif
 #ifdef __unix__
-#if __has_include(<signal.h>)
+#if __has_include(<unistd.h>)
   /*!
-   * @brief signal sends the specified code as a signal to the process
-   * @param code is the signal to be sent
-   * @return
-   *     if there were no errors -> SignalError::NO_ERROR
-   *     if there was an error -> error code (not SignalError::NO_ERROR)
+   * @brief stderrChunks passes the stderr to the callback chunk by chunk
+   *     until the end of file
+   * @note memory usage does not depend on the amount of output
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Callback is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops reading
+   * @param callback is called with every read chunk
+   *     @note the chunk is valid only during the call
+   * @return result of Process::readChunksFrom() @see Process::readChunksFrom()
    */
-  SignalError signalCautious(const int& code) const;
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Callback>
+  ReadError stderrChunks(Callback&& callback) const;
 #endif
 #endif
-protected:
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief writeInto writes the specified input into the specified pipe
-   * @tparam BUFFER_SIZE is the buffer size for writing into the pipe
-   * @tparam Return is the type to be returned by this function
-   * @param pipe is the pipe to write into
-   * @param input is the data to write
-   * @return
-   *     if Return == std::tuple<WriteError, std::size_t> ->
-   *         tuple containing
-   *             error code
-   *                 if there were no errors -> WriteError::NO_ERROR
-   *                 if there was an error -> errno (not WriteError::NO_ERROR)
-   *             number of bytes written
-   *                 if there were no errors -> it should be equal to input size
-   *                 if there was an error -> it should be equal to
-   *                     the number of bytes that had already
-   *                     been written before an error occured
-   *     if Return == void -> nothing
+   * @brief stdoutLines passes the stdout to the callback line by line
+   *     until the end of file
+   * @tparam BUFFER_SIZE is the maximal size of a read chunk
+   * @tparam Callback is invocable with std::string_view
+   *     @note if it returns bool -> false stops reading
+   * @param callback is called with every line without '\n'
+   *     @note the last line is passed even if it is not terminated by '\n'
+   *     @note the line is valid only during the call
+   * @return result of Process::readLinesFrom() @see Process::readLinesFrom()
    */
-  template <std::size_t BUFFER_SIZE, class Return>
-  static Return writeInto(
-      const int& pipe,
-      const std::string& input
-  );
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Callback>
+  ReadError stdoutLines(Callback&& callback) const;
 #endif
 #endif
 #ifdef __unix__
 #if __has_include(<unistd.h>)
   /*!
-   * @brief readFrom reads from the specified pipe
-   * @tparam BUFFER_SIZE is the buffer size for reading from the pipe
+   * @brief stderrLines passes the stderr to the callback line by line
+   *     until the end of file
+   * @tparam BUFFER_SIZE is the maximal size of a read chunk
+   * @tparam Callback is invocable with std::string_view
+   *     @note if it returns bool -> false stops reading
+   * @param callback is called with every line without '\n'
+   *     @note the last line is passed even if it is not terminated by '\n'
+   *     @note the line is valid only during the call
+   * @return result of Process::readLinesFrom() @see Process::readLinesFrom()
+   */
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Callback>
+  ReadError stderrLines(Callback&& callback) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief stdoutTo moves the stdout to the specified file descriptor
+   *     until the end of file
+   * @note the data are moved by splice() inside the kernel => they are not
+   *     copied to this process
+   *     @note read() + write() are used if splice() is not supported
+   *         for the file descriptor (e.g. O_APPEND on older kernels)
+   * @tparam BUFFER_SIZE is the maximal size of a single transfer
+   * @param fd is the file descriptor to write into (a file, a socket, ...)
+   * @return result of Process::spliceFrom() @see Process::spliceFrom()
+   */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
+  std::tuple<std::size_t, ReadError, WriteError> stdoutTo(
+      const int& fd
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief stderrTo moves the stderr to the specified file descriptor
+   *     until the end of file
+   * @note the data are moved by splice() inside the kernel => they are not
+   *     copied to this process
+   *     @note read() + write() are used if splice() is not supported
+   *         for the file descriptor (e.g. O_APPEND on older kernels)
+   * @tparam BUFFER_SIZE is the maximal size of a single transfer
+   * @param fd is the file descriptor to write into (a file, a socket, ...)
+   * @return result of Process::spliceFrom() @see Process::spliceFrom()
+   */
+  template <std::size_t BUFFER_SIZE = READ_SIZE>
+  std::tuple<std::size_t, ReadError, WriteError> stderrTo(
+      const int& fd
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+  /*!
+   * @brief stdoutTee moves the stdout to the specified file descriptor
+   *     and passes a copy of it to the sink until the end of file
+   * @note the data are duplicated by tee() and moved to the file descriptor
+   *     by splice() => only the copy for the sink is read by this process
+   *     @note read() + write() are used if tee() or splice() is
+   *         not supported for the file descriptor
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Sink is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops the transfer
+   * @param fd is the file descriptor to write into (a file, a socket, ...)
+   * @param sink is called with every chunk after it has been written
+   *     @note the chunk is valid only during the call
+   * @return result of Process::teeFrom() @see Process::teeFrom()
+   */
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Sink>
+  std::tuple<std::size_t, ReadError, WriteError> stdoutTee(
+      const int& fd,
+      Sink&& sink
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+  /*!
+   * @brief stderrTee moves the stderr to the specified file descriptor
+   *     and passes a copy of it to the sink until the end of file
+   * @note the data are duplicated by tee() and moved to the file descriptor
+   *     by splice() => only the copy for the sink is read by this process
+   *     @note read() + write() are used if tee() or splice() is
+   *         not supported for the file descriptor
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Sink is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops the transfer
+   * @param fd is the file descriptor to write into (a file, a socket, ...)
+   * @param sink is called with every chunk after it has been written
+   *     @note the chunk is valid only during the call
+   * @return result of Process::teeFrom() @see Process::teeFrom()
+   */
+  template <std::size_t BUFFER_SIZE = READ_SIZE, class Sink>
+  std::tuple<std::size_t, ReadError, WriteError> stderrTee(
+      const int& fd,
+      Sink&& sink
+  ) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+  /*!
+   * @brief communicate writes the specified input to the stdin while reading
+   *     the stdout and the stderr until the end of file
+   * @note the pipes are multiplexed by poll() in the calling thread =>
+   *     neither side blocks when a pipe buffer becomes full
+   * @note the stdin is closed after the input is written
+   * @note SIGPIPE is blocked for the calling thread during the call =>
+   *     the process may exit without reading the whole input
+   * @param input is the input value
+   * @return tuple of the stdout value and the stderr value
+   */
+  std::tuple<std::string, std::string> communicate(std::string_view input = {});
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+  /*!
+   * @brief communicate writes the specified input to the stdin while reading
+   *     the stdout and the stderr until the end of file
+   * @see Process::communicate()
+   * @param input is the input value
+   * @return tuple containing
+   *     the stdout value read before the end of file or an error
+   *     the stderr value read before the end of file or an error
+   *     WriteError::NO_ERROR if the whole input was written
+   *         otherwise error code of the write (e.g. WriteError::PIPE if the
+   *         process closed its stdin early or WriteError::BADF if the input
+   *         is not empty and the stdin is not a pipe)
+   *     ReadError::NO_ERROR if both outputs were read until the end of file
+   *         otherwise error code of the read or of poll()
+   */
+  std::tuple<std::string, std::string, WriteError, ReadError>
+  communicateCautious(std::string_view input = {});
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<signal.h>)
+  /*!
+   * @brief signal sends the specified code as a signal to the process
+   * @note the signal is sent through the process file descriptor if opened
+   * @param code is the signal to be sent
+   */
+  void signal(const int& code) const;
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<signal.h>)
+  /*!
+   * @brief signal sends the specified code as a signal to the process
+   * @note the signal is sent through the process file descriptor if opened
+   * @param code is the signal to be sent
+   * @return
+   *     if there were no errors -> SignalError::NO_ERROR
+   *     if there was an error -> error code (not SignalError::NO_ERROR)
+   */
+  SignalError signalCautious(const int& code) const;
+#endif
+#endif
+protected:
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief writeInto writes the specified input into the specified pipe
+   * @note the input is written directly from the specified memory,
+   *     interrupted writes are restarted
+   * @tparam BUFFER_SIZE is the maximal number of bytes passed to one write()
+   * @tparam Return is the type to be returned by this function
+   * @param pipe is the pipe to write into
+   * @param input is the data to write
+   * @return
+   *     if Return == std::tuple<WriteError, std::size_t> ->
+   *         tuple containing
+   *             error code
+   *                 if there were no errors -> WriteError::NO_ERROR
+   *                 if there was an error -> errno (not WriteError::NO_ERROR)
+   *             number of bytes written
+   *                 if there were no errors -> it should be equal to input size
+   *                 if there was an error -> it should be equal to
+   *                     the number of bytes that had already
+   *                     been written before an error occured
+   *     if Return == void -> nothing
+   */
+  template <std::size_t BUFFER_SIZE, class Return>
+  static Return writeInto(
+      const int& pipe,
+      std::span<const std::byte> input
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief writeInto writes the specified input into the specified pipe
+   * @see Process::writeInto(const int&, std::span<const std::byte>)
+   */
+  template <std::size_t BUFFER_SIZE, class Return>
+  static Return writeInto(
+      const int& pipe,
+      std::string_view input
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+  /*!
+   * @brief writeVectorInto writes the concatenation of the specified inputs
+   *     into the specified pipe by writev()
+   * @note interrupted and partial writes are continued
+   * @tparam Return is the type to be returned by this function
+   * @param pipe is the pipe to write into
+   * @param inputs are the data to write
+   * @return @see Process::writeInto()
+   */
+  template <class Return>
+  static Return writeVectorInto(
+      const int& pipe,
+      std::span<const std::string_view> inputs
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+  /*!
+   * @brief spliceInto passes the specified input into the specified pipe
+   *     by vmsplice()
+   * @note interrupted and partial transfers are continued
+   * @note if vmsplice() is not supported -> the rest is written by write()
+   * @tparam Return is the type to be returned by this function
+   * @param pipe is the pipe to pass the input into
+   * @param input are the data to pass
+   * @return @see Process::writeInto()
+   */
+  template <class Return>
+  static Return spliceInto(
+      const int& pipe,
+      std::span<const std::byte> input
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief readFrom reads from the specified pipe until the end of file
+   * @note the result grows geometrically and the pipe's pending byte count
+   *     is used as a size hint => large outputs are read with few copies
+   * @note small outputs are read through the stack => the result does not
+   *     keep a whole read buffer as its capacity
+   * @note the read is binary-safe => embedded '\0' bytes are preserved
+   * @tparam BUFFER_SIZE is the maximal size of a read() of not yet pending data
    * @tparam Return is the type to be returned by this function
    * @param pipe is the pipe to read from
    * @return
@@ -414,6 +1308,327 @@ protected:
   template <std::size_t BUFFER_SIZE, class Return>
   static Return readFrom(const int& pipe);
 #endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief readSomeInto performs a single read from the specified pipe
+   *     appending to the specified buffer
+   * @note if the pipe holds more than fits into a stack chunk ->
+   *     the buffer grows geometrically and all the pending bytes are read
+   *     into it at once
+   *     else -> the read goes through a stack chunk and only the read bytes
+   *         are appended => no spare space is allocated and zero-filled
+   *         ahead of the data
+   * @tparam BUFFER_SIZE is the maximal size of the stack chunk
+   *     @note it is capped by Process::STACK_READ_SIZE_
+   * @param pipe is the pipe to read from
+   * @param buffer is the buffer to append to
+   * @return result of ::read()
+   */
+  template <std::size_t BUFFER_SIZE>
+  static ssize_t readSomeInto(const int& pipe, std::string& buffer);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief readChunksFrom reads from the specified pipe until the end of file
+   *     and passes every read chunk to the callback
+   * @note interrupted reads are restarted
+   * @tparam BUFFER_SIZE is the buffer size for reading from the pipe
+   * @tparam Callback is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops reading
+   * @param pipe is the pipe to read from
+   * @param callback is called with every read chunk
+   * @return
+   *     if there were no errors -> ReadError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  template <std::size_t BUFFER_SIZE, class Callback>
+  static ReadError readChunksFrom(const int& pipe, Callback&& callback);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief readLinesFrom reads from the specified pipe until the end of file
+   *     and passes every line to the callback
+   * @tparam BUFFER_SIZE is the buffer size for reading from the pipe
+   * @tparam Callback is invocable with std::string_view
+   *     @note if it returns bool -> false stops reading
+   * @param pipe is the pipe to read from
+   * @param callback is called with every line without '\n'
+   * @return result of Process::readChunksFrom()
+   */
+  template <std::size_t BUFFER_SIZE, class Callback>
+  static ReadError readLinesFrom(const int& pipe, Callback&& callback);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief spliceFrom moves data from the specified pipe to the specified
+   *     file descriptor until the end of file
+   * @note interrupted transfers are restarted
+   * @note if a side is non-blocking -> it is waited by poll()
+   * @tparam BUFFER_SIZE is the maximal size of a single transfer
+   * @param pipe is the pipe to read from
+   * @param fd is the file descriptor to write into
+   * @return tuple containing
+   *     number of moved bytes
+   *     error code of reading the pipe (ReadError::BADF if it is not present)
+   *     error code of writing the file descriptor
+   */
+  template <std::size_t BUFFER_SIZE>
+  static std::tuple<std::size_t, ReadError, WriteError> spliceFrom(
+      const int& pipe,
+      const int& fd
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+  /*!
+   * @brief teeFrom moves data from the specified pipe to the specified
+   *     file descriptor and passes them to the sink until the end of file
+   * @note if the file descriptor is not a pipe -> tee() duplicates the data
+   *     into an intermediate pipe which is spliced to the file descriptor
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Sink is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops the transfer
+   * @param pipe is the pipe to read from
+   * @param fd is the file descriptor to write into
+   * @param sink is called with every chunk after it has been written
+   * @return @see Process::spliceFrom()
+   */
+  template <std::size_t BUFFER_SIZE, class Sink>
+  static std::tuple<std::size_t, ReadError, WriteError> teeFrom(
+      const int& pipe,
+      const int& fd,
+      Sink&& sink
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief copyFrom copies data from the specified pipe to the specified
+   *     file descriptor by read() + write() and passes them to the sink
+   *     until the end of file
+   * @note used if splice() or tee() is not supported
+   * @tparam BUFFER_SIZE is the maximal size of a chunk
+   * @tparam Sink is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops the transfer
+   * @param pipe is the pipe to read from
+   * @param fd is the file descriptor to write into
+   * @param sink is called with every chunk after it has been written
+   * @param moved is the number of bytes moved before the call
+   * @return @see Process::spliceFrom()
+   */
+  template <std::size_t BUFFER_SIZE, class Sink>
+  static std::tuple<std::size_t, ReadError, WriteError> copyFrom(
+      const int& pipe,
+      const int& fd,
+      Sink&& sink,
+      std::size_t moved
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief spawns a process executing the specified arguments
+   * @param argv is the NULL-terminated argument list,
+   *     argv[0] is the path to the binary
+   * @param envp is the NULL-terminated environment list
+   * @param fds are the file descriptors to become stdin, stdout and stderr of
+   *     the spawned process
+   *     @note other file descriptors opened with FD_CLOEXEC are not inherited
+   * @param strategy is the way to spawn the process @see SpawnStrategy
+   * @return
+   *     if there were no errors -> tuple containing
+   *         process identifier
+   *         process file descriptor (-1 if it is not supported)
+   *     if there was an error -> error code
+   */
+  static std::variant<std::tuple<pid_t, int>, CreateError> spawn(
+      char* const* argv,
+      char* const* envp,
+      const std::array<int, 3>& fds,
+      const SpawnStrategy& strategy
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief spawns a process executing the specified arguments
+   * @param argv is the NULL-terminated argument list,
+   *     argv[0] is the path to the binary
+   * @param envp is the NULL-terminated environment list
+   * @param fds are pairs of
+   *     a file descriptor in the spawned process and
+   *     a file descriptor of this process to become it
+   *     @note sources may overlap targets,
+   *         e.g. { { 1, 2, }, { 2, 1, }, } swaps stdout and stderr
+   *     @note other file descriptors opened with FD_CLOEXEC are not inherited
+   * @param strategy is the way to spawn the process @see SpawnStrategy
+   * @return
+   *     if there were no errors -> tuple containing
+   *         process identifier
+   *         process file descriptor (-1 if it is not supported)
+   *     if there was an error -> error code
+   */
+  static std::variant<std::tuple<pid_t, int>, CreateError> spawn(
+      char* const* argv,
+      char* const* envp,
+      std::span<const std::pair<int, int>> fds,
+      const SpawnStrategy& strategy
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief opens the file descriptors of the specified redirections of
+   *     stdin, stdout and stderr
+   * @param stdio are the redirections @see Process::create()
+   *     @note Stdio::fds are not opened
+   * @param pipes are the ends of the pipes kept by this process
+   *     (-1 if the redirection is not Redirection::Kind::PIPE)
+   * @param sources are the file descriptors to become stdin, stdout and
+   *     stderr (-1 if inherited)
+   * @param owned are true for the sources opened by this function
+   * @return
+   *     if there were no errors -> CreateError::NO_ERROR
+   *     if there was an error -> error code @see Process::create()
+   *         @note nothing is left opened
+   */
+  static CreateError openStdio(
+      const Stdio& stdio,
+      int (&pipes)[3],
+      int (&sources)[3],
+      bool (&owned)[3]
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a pipe with FD_CLOEXEC set on both ends
+   * @param fds are the read and the write ends of the created pipe
+   * @return
+   *     if there were no errors -> 0
+   *     if there was an error -> -1 and errno is set
+   */
+  static int pipeOf(int (&fds)[2]);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief creates a sealed in-memory file containing the specified data
+   * @note the file offset is at the beginning, F_SEAL_SHRINK, F_SEAL_GROW,
+   *     F_SEAL_WRITE and F_SEAL_SEAL are set
+   * @param data are the data of the file
+   * @return
+   *     if there were no errors -> file descriptor with FD_CLOEXEC set
+   *     if there was an error -> -1 and errno is set
+   *         @note errno is ENOSYS if memfd is not supported
+   */
+  static int memoryFileOf(std::span<const std::byte> data);
+#endif
+#endif
+  /*!
+   * @brief checks whether a source file descriptor is replaced by a target of
+   *     a preceding pair before it is duplicated
+   * @param fds are pairs of a target and a source file descriptor
+   * @param index is the index of the checked pair
+   * @return true if the source has to be duplicated in advance
+   */
+  static constexpr bool isOverwritten(
+      std::span<const std::pair<int, int>> fds,
+      const std::size_t& index
+  );
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief duplicates the sources onto the targets of the specified pairs
+   * @note only async-signal-safe functions are called
+   * @note FD_CLOEXEC is cleared for the targets
+   * @param fds are pairs of a target and a source file descriptor
+   *     @see Process::spawn()
+   * @param scratch is memory for the sources which are overwritten by
+   *     another target before being duplicated
+   *     @note a source which has been duplicated in advance is left opened
+   *         with FD_CLOEXEC in scratch, other elements are equal to
+   *         the sources (-1 if the duplication failed)
+   * @return
+   *     if there were no errors -> 0
+   *     if there was an error -> -1 and errno is set, the targets may be
+   *         partially redirected => the process is not to be executed
+   */
+  static int redirect(
+      std::span<const std::pair<int, int>> fds,
+      std::span<int> scratch
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief replaces the current process image, used by the spawned process
+   * @note only async-signal-safe functions are called
+   * @note does not return
+   * @param argv is the NULL-terminated argument list
+   * @param envp is the NULL-terminated environment list
+   * @param fds are pairs of a target and a source file descriptor
+   *     @see Process::spawn()
+   * @param scratch is memory for the sources which are overwritten by
+   *     another target before being duplicated
+   *     @note allocated before the spawn => the spawned process allocates
+   *         nothing
+   */
+  [[noreturn]] static void execute(
+      char* const* argv,
+      char* const* envp,
+      std::span<const std::pair<int, int>> fds,
+      std::span<int> scratch
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sched.h>) && \
+    __has_include(<sys/mman.h>) && __has_include(<signal.h>)
+  /*!
+   * @brief The Cloned struct contains the arguments of a process spawned by
+   *     SpawnStrategy::CLONE @see Process::cloned()
+   */
+  struct Cloned {
+    char* const* argv;
+    char* const* envp;
+    std::span<const std::pair<int, int>> fds;
+    std::span<int> scratch;
+    //! signal mask of the spawning thread to be restored before execve()
+    const sigset_t* mask;
+  };
+  /*!
+   * @brief entry point of a process spawned by SpawnStrategy::CLONE
+   * @note runs on the dedicated stack in the memory of the parent =>
+   *     only async-signal-safe functions are called
+   * @note signal handlers of the parent are reset to SIG_DFL before
+   *     the signals are unblocked => a handler does not run in the memory of
+   *     the suspended parent
+   * @note does not return
+   * @param arguments is a pointer to Cloned
+   * @return never
+   */
+  static int cloned(void* arguments);
+  //! size of the dedicated stack of a process spawned by SpawnStrategy::CLONE
+  static constexpr std::size_t CLONE_STACK_SIZE = std::size_t{1} << 16;
+#endif
 #endif
   /*!
    * @brief constructs an instance with default values
@@ -428,38 +1643,176 @@ protected:
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
   /*!
    * @brief loop to wait for process exit
+   * @note blocks without consuming cpu time until the process exits:
+   *     if the process file descriptor is present ->
+   *         waits by waitid(P_PIDFD) on the process file descriptor
+   *     else -> waits by a blocking wait4()
    * @tparam Return is the return type
    *     if Return == void -> no errors are returned and handled
+   *         @note interrupted waits are restarted
    *     else -> the first encountered error is returned
    */
   template <class Return>
   Return waitExitLoop();
 #endif
 #endif
-  //! process identifier
-  unsigned pid_ = 0;
-  //! stdin file descriptor
-  int stdinPipe_ = -1;
-  //! stdout file descriptor
-  int stdoutPipe_ = -1;
-  //! stderr file descriptor
-  int stderrPipe_ = -1;
 #ifdef __unix__
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-  //! if waited -> actual exit status code value if present @see Process::wait()
-  //! else -> empty exit status code value
-  std::optional<int> exitCode_ = {};
-  //! if waited -> actual termination signal code value if present
-  //!     @see Process::wait()
-  //! else -> empty termination signal code value
-  std::optional<int> terminationCode_ = {};
-  //! if waited -> actual stop signal code value if present @see Process::wait()
-  //! else -> empty stop signal code value
-  std::optional<int> stopCode_ = {};
+  /*!
+   * @brief stores the status of a waited process @see waitpid()
+   * @param status is the status reported by waitpid()
+   */
+  void storeStatus(const int& status);
 #endif
 #endif
-private:
-};
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  /*!
+   * @brief waits for the process by waitpid() (or by wait4() to collect
+   *     the resource usage) and stores the results
+   * @param options are the options of waitpid()
+   * @return result of waitpid()
+   */
+  pid_t waitStatus(const int& options);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+  /*!
+   * @brief stores the resource usage of a waited process
+   * @param usage is the resource usage reported by wait4() or waitid()
+   */
+  void storeUsage(const rusage& usage);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  /*!
+   * @brief checks whether the process has exited or has been terminated
+   *     and has been waited
+   * @return true if the exit or the termination has been stored
+   */
+  constexpr bool waited() const;
+#endif
+#endif
+#ifdef __unix__
+  /*!
+   * @brief converts the specified deadline to a poll() timeout
+   * @tparam Clock is the clock of the deadline
+   * @tparam Duration is the duration type of the deadline
+   * @param deadline is the time point to convert
+   * @return remaining milliseconds rounded up (0 if the deadline passed)
+   */
+  template <class Clock, class Duration>
+  static int timeoutUntil(
+      const std::chrono::time_point<Clock, Duration>& deadline
+  );
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+  /*!
+   * @brief loop to wait for all the specified processes
+   * @tparam Timeout is invocable without arguments returning the poll()
+   *     timeout in milliseconds (-1 is infinite, 0 is the passed deadline)
+   * @param processes are the processes to wait for
+   * @param timeout returns the remaining time
+   * @return @see Process::waitAllUntil()
+   */
+  template <class Timeout>
+  static WaitError waitAllLoop(
+      std::span<Process> processes,
+      Timeout&& timeout
+  );
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/syscall.h>)
+  /*!
+   * @brief opens a process file descriptor referring to the specified process
+   * @warning not atomic with the spawn: if the child has already exited and
+   *     it has been reaped by something else (e.g. waitid(P_ALL),
+   *     SIGCHLD set to SIG_IGN) -> the pid may have been reused and
+   *     the file descriptor refers to an unrelated process => used only if
+   *     the spawn cannot return a process file descriptor itself
+   *     (CLONE_PIDFD, pidfd_spawn())
+   * @param pid is the process identifier
+   * @return
+   *     if the process file descriptor was opened -> the file descriptor
+   *     else -> -1
+   */
+  static int pidfdOf(const pid_t& pid);
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<signal.h>)
+  /*!
+   * @brief sends the specified signal to the process
+   * @note if the process file descriptor is opened -> pidfd_send_signal()
+   *     is used => the signal cannot reach a process which reused the pid
+   *     else -> kill()
+   * @param code is the signal to be sent
+   * @return 0 on success, else -1 and errno is set
+   */
+  int sendSignal(const int& code) const;
+#endif
+#endif
+  //! P_PIDFD value of idtype_t @see waitid()
+  static constexpr int P_PIDFD_ = 3;
+  //! maximal size of a read() buffer placed on the stack
+  static constexpr std::size_t STACK_READ_SIZE_ = std::size_t{1} << 14;
+  /*!
+   * @brief buffer for read() of the specified size
+   * @note if SIZE > Process::STACK_READ_SIZE_ -> the buffer is allocated =>
+   *     a large caller-chosen size does not overflow a small thread stack
+   * @tparam SIZE is the size of the buffer
+   */
+  template <std::size_t SIZE, bool ON_STACK = SIZE <= STACK_READ_SIZE_>
+  struct ReadBuffer {
+    std::byte* data() { return this->bytes; }
+    std::byte bytes[SIZE];
+  };
+  template <std::size_t SIZE>
+  struct ReadBuffer<SIZE, false> {
+    std::byte* data() { return this->bytes.get(); }
+    std::unique_ptr<std::byte[]> bytes =
+        std::make_unique_for_overwrite<std::byte[]>(SIZE);
+  };
+  //! process identifier
+  unsigned pid_ = 0;
+  //! process file descriptor @see pidfd_open()
+  int pidfd_ = -1;
+  //! stdin file descriptor
+  int stdinPipe_ = -1;
+  //! stdout file descriptor
+  int stdoutPipe_ = -1;
+  //! stderr file descriptor
+  int stderrPipe_ = -1;
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  //! if waited -> actual exit status code value if present @see Process::wait()
+  //! else -> empty exit status code value
+  std::optional<int> exitCode_ = {};
+  //! if waited -> actual termination signal code value if present
+  //!     @see Process::wait()
+  //! else -> empty termination signal code value
+  std::optional<int> terminationCode_ = {};
+  //! if waited -> actual stop signal code value if present @see Process::wait()
+  //! else -> empty stop signal code value
+  std::optional<int> stopCode_ = {};
+#endif
+#endif
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+  //! if waited -> resources used by the process @see Process::wait()
+  //! else -> empty resource usage
+  std::optional<ResourceUsage> resourceUsage_ = {};
+#endif
+#endif
+private:
+};
 
 } /// namespace cu0
 
@@ -494,346 +1847,2057 @@ inline Process Process::current() {
 #endif
 
 #ifdef __unix__
-#if __has_include(<unistd.h>)
-inline std::variant<Process, Process::CreateError> Process::create(
-    const Executable& executable
-) {
-  const auto [argv, argvSize] = util::argvOf(executable);
-  const auto [envp, envpSize] = util::envpOf(executable);
-  auto argvRaw = std::make_unique<char*[]>(argvSize);
-  for (auto i = 0u; i < argvSize; i++) {
-    argvRaw[i] = argv[i].get();
-  }
-  auto envpRaw = std::make_unique<char*[]>(envpSize);
-  for (auto i = 0u; i < envpSize; i++) {
-    envpRaw[i] = envp[i].get();
-  }
-  int inFd[2];
-  int outFd[2];
-  int errFd[2];
-  if (::pipe(inFd) != 0) {
-    return static_cast<CreateError>(errno);
-  }
-  if (::pipe(outFd) != 0) {
-    const auto ret = static_cast<CreateError>(errno);
-    ::close(inFd[0]);
-    ::close(inFd[1]);
-    return ret;
-  }
-  if (::pipe(errFd) != 0) {
-    const auto ret = static_cast<CreateError>(errno);
-    ::close(inFd[0]);
-    ::close(inFd[1]);
-    ::close(outFd[0]);
-    ::close(outFd[1]);
-    return ret;
-  }
-  const auto pid = ::vfork();
-  if (pid == 0) { //! forked process
-    ::close(inFd[1]);
-    ::close(outFd[0]);
-    ::close(errFd[0]);
-    ::dup2(inFd[0], STDIN_FILENO);
-    ::dup2(outFd[1], STDOUT_FILENO);
-    ::dup2(errFd[1], STDERR_FILENO);
-    ::close(inFd[0]);
-    ::close(outFd[1]);
-    ::close(errFd[1]);
-    const auto execRet = ::execve(argvRaw[0], argvRaw.get(), envpRaw.get());
-    if (execRet != 0) {
-      //! fail
-      exit(errno);
-    }
-  }
-  ::close(inFd[0]);
-  ::close(outFd[1]);
-  ::close(errFd[1]);
-  if (pid < 0) { //! fork failed
-    return static_cast<CreateError>(errno);
+#if __has_include(<unistd.h>)
+inline std::variant<Process, Process::CreateError> Process::create(
+    const Executable& executable,
+    const SpawnStrategy& strategy
+) {
+  return Process::create(ExecPlan{executable}, strategy);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+inline std::variant<Process, Process::CreateError> Process::create(
+    const ExecPlan& plan,
+    const SpawnStrategy& strategy
+) {
+  return Process::create(plan, Stdio{}, strategy);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+inline std::variant<Process, Process::CreateError> Process::create(
+    const Executable& executable,
+    const Stdio& stdio,
+    const SpawnStrategy& strategy
+) {
+  return Process::create(ExecPlan{executable}, stdio, strategy);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+inline std::variant<Process, Process::CreateError> Process::create(
+    const ExecPlan& plan,
+    const Stdio& stdio,
+    const SpawnStrategy& strategy
+) {
+  //! ends of the pipes kept by this process
+  int pipes[3];
+  //! file descriptors to become stdin, stdout and stderr (-1 if inherited)
+  int sources[3];
+  //! true if a source is owned by this function
+  bool owned[3];
+  if (
+      const auto ret = Process::openStdio(stdio, pipes, sources, owned);
+      ret != CreateError::NO_ERROR
+  ) {
+    return ret;
+  }
+  const auto release = [&pipes, &sources, &owned]() {
+    for (auto i = 0; i < 3; i++) {
+      if (owned[i]) {
+        ::close(sources[i]);
+      }
+      if (pipes[i] >= 0) {
+        ::close(pipes[i]);
+      }
+    }
+  };
+  //! no memory is allocated unless extra file descriptors are inherited
+  std::array<std::pair<int, int>, 3> standard;
+  auto extended = std::vector<std::pair<int, int>>{};
+  auto count = std::size_t{0};
+  auto fds = std::span<std::pair<int, int>>{standard};
+  if (!stdio.fds.empty()) {
+    extended.resize(3 + stdio.fds.size());
+    fds = extended;
+  }
+  for (auto i = 0; i < 3; i++) {
+    if (sources[i] >= 0) {
+      fds[count++] = { i, sources[i], };
+    }
+  }
+  for (const auto& [target, source] : stdio.fds) {
+    if (target < 0 || source < 0) {
+      release();
+      return CreateError::INVAL;
+    }
+    fds[count++] = { target, source, };
+  }
+  const auto spawned = Process::spawn(
+      plan.argv(), plan.envp(), fds.first(count), strategy
+  );
+  //! the created process has its own copies => close the ends of this process
+  for (auto i = 0; i < 3; i++) {
+    if (owned[i]) {
+      ::close(sources[i]);
+      owned[i] = false;
+    }
+  }
+  if (std::holds_alternative<CreateError>(spawned)) { //! spawn failed
+    release();
+    return std::get<CreateError>(spawned);
+  }
+  const auto [pid, pidfd] = std::get<std::tuple<pid_t, int>>(spawned);
+  auto process = Process{};
+  process.pid_ = pid;
+  process.pidfd_ = pidfd;
+  process.stdinPipe_ = pipes[0];
+  process.stdoutPipe_ = pipes[1];
+  process.stderrPipe_ = pipes[2];
+  return process;
+}
+#endif
+#endif
+
+inline Process::~Process() {
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+  ::close(this->stdinPipe_);
+  ::close(this->stdoutPipe_);
+  ::close(this->stderrPipe_);
+  ::close(this->pidfd_);
+#endif
+#endif
+}
+
+constexpr Process::Process(Process&& other) {
+  this->swap(std::move(other));
+}
+
+constexpr Process& Process::operator =(Process&& other) {
+  if (this != &other) {
+    this->swap(std::move(other));
+  }
+  return *this;
+}
+
+constexpr const unsigned& Process::pid() const {
+  return this->pid_;
+}
+
+constexpr const int& Process::pidfd() const {
+  return this->pidfd_;
+}
+
+constexpr const int& Process::stdinPipe() const {
+  return this->stdinPipe_;
+}
+
+constexpr const int& Process::stdoutPipe() const {
+  return this->stdoutPipe_;
+}
+
+constexpr const int& Process::stderrPipe() const {
+  return this->stderrPipe_;
+}
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+inline void Process::wait() {
+  this->waitExitLoop<void>();
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+inline typename Process::WaitError Process::waitCautious() {
+  return this->waitExitLoop<WaitError>();
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+template <class Rep, class Period>
+inline typename Process::WaitError Process::waitFor(
+    const std::chrono::duration<Rep, Period>& duration
+) {
+  return this->waitUntil(std::chrono::steady_clock::now() + duration);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+template <class Clock, class Duration>
+inline typename Process::WaitError Process::waitUntil(
+    const std::chrono::time_point<Clock, Duration>& deadline
+) {
+  const auto remaining = [&deadline]() {
+    return Process::timeoutUntil(deadline);
+  };
+  if (this->pidfd_ >= 0) {
+    //! the process file descriptor becomes readable when the process exits
+    auto fd = pollfd{ this->pidfd_, POLLIN, 0, };
+    while (true) {
+      const auto ret = ::poll(&fd, 1, remaining());
+      if (ret > 0) {
+        return this->waitExitLoop<WaitError>();
+      }
+      if (ret == 0) {
+        if (remaining() > 0) { //! the clock of the deadline is not steady
+          continue;
+        }
+        return WaitError::TIMEDOUT;
+      }
+      if (errno != EINTR) {
+        return static_cast<WaitError>(errno);
+      }
+    }
+  }
+  //! no process file descriptor -> poll the process state
+  constexpr auto MIN_SLEEP = std::chrono::microseconds{50};
+  constexpr auto MAX_SLEEP = std::chrono::microseconds{20000};
+  auto sleep = MIN_SLEEP;
+  while (true) {
+    const auto pid = this->waitStatus(WNOHANG);
+    if (pid > 0) {
+      return WaitError::NO_ERROR;
+    }
+    if (pid < 0 && errno != EINTR) {
+      return static_cast<WaitError>(errno);
+    }
+    const auto now = Clock::now();
+    if (now >= deadline) {
+      return WaitError::TIMEDOUT;
+    }
+    const auto left = std::chrono::ceil<std::chrono::microseconds>(
+        deadline - now
+    );
+    const auto pause = std::min(
+        sleep, std::chrono::duration_cast<std::chrono::microseconds>(left)
+    );
+    auto request = timespec{
+      static_cast<time_t>(pause.count() / 1000000),
+      static_cast<long>(pause.count() % 1000000 * 1000),
+    };
+    ::nanosleep(&request, nullptr);
+    sleep = std::min(sleep * 2, MAX_SLEEP);
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+template <class Rep, class Period>
+inline void Process::terminate(
+    const std::chrono::duration<Rep, Period>& grace
+) {
+  this->terminateCautious(grace);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+template <class Rep, class Period>
+inline typename Process::WaitError Process::terminateCautious(
+    const std::chrono::duration<Rep, Period>& grace
+) {
+  if (this->waited()) { //! the pid may have been reused -> no signal
+    return WaitError::NO_ERROR;
+  }
+  if (this->pid_ == 0) { //! kill(0) would signal the whole process group
+    return WaitError::CHILD;
+  }
+  this->signal(SIGTERM);
+  const auto ret = this->waitFor(grace);
+  if (ret != WaitError::TIMEDOUT) {
+    return ret;
+  }
+  //! the process ignored SIGTERM -> escalate
+  this->signal(SIGKILL);
+  return this->waitExitLoop<WaitError>();
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+inline std::variant<std::size_t, typename Process::WaitError>
+Process::waitAny(std::span<Process> processes) {
+  auto fds = std::vector<pollfd>{};
+  auto indices = std::vector<std::size_t>{};
+  auto withoutPidfd = std::vector<std::size_t>{};
+  for (auto i = std::size_t{0}; i < processes.size(); i++) {
+    if (processes[i].waited()) {
+      continue;
+    }
+    if (processes[i].pidfd_ >= 0) {
+      fds.push_back({ processes[i].pidfd_, POLLIN, 0, });
+      indices.push_back(i);
+    } else {
+      withoutPidfd.push_back(i);
+    }
+  }
+  if (fds.empty() && withoutPidfd.empty()) {
+    return WaitError::CHILD;
+  }
+  //! processes without the process file descriptor are checked
+  //!     between polls with exponentially growing timeouts
+  constexpr auto MAX_TIMEOUT = 20; //! [ms]
+  auto timeout = withoutPidfd.empty() ? -1 : 0;
+  while (true) {
+    const auto ret = ::poll(fds.data(), fds.size(), timeout);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return static_cast<WaitError>(errno);
+    }
+    for (auto j = std::size_t{0}; ret > 0 && j < fds.size(); j++) {
+      if (fds[j].revents != 0) {
+        const auto error = processes[indices[j]].waitExitLoop<WaitError>();
+        if (error != WaitError::NO_ERROR) {
+          return error;
+        }
+        return indices[j];
+      }
+    }
+    for (const auto& i : withoutPidfd) {
+      const auto pid = processes[i].waitStatus(WNOHANG);
+      if (pid > 0) {
+        return i;
+      }
+      if (pid < 0 && errno != EINTR) {
+        return static_cast<WaitError>(errno);
+      }
+    }
+    if (!withoutPidfd.empty()) {
+      timeout = std::min(std::max(timeout * 2, 1), MAX_TIMEOUT);
+    }
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+inline typename Process::WaitError Process::waitAll(
+    std::span<Process> processes
+) {
+  return Process::waitAllLoop(processes, []() { return -1; });
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+template <class Clock, class Duration>
+inline typename Process::WaitError Process::waitAllUntil(
+    std::span<Process> processes,
+    const std::chrono::time_point<Clock, Duration>& deadline
+) {
+  return Process::waitAllLoop(processes, [&deadline]() {
+    return Process::timeoutUntil(deadline);
+  });
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+constexpr const std::optional<int>& Process::exitCode() const {
+  return this->exitCode_;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+constexpr const std::optional<int>& Process::terminationCode() const {
+  return this->terminationCode_;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+constexpr const std::optional<int>& Process::stopCode() const {
+  return this->stopCode_;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+constexpr const std::optional<typename Process::ResourceUsage>&
+Process::resourceUsage() const {
+  return this->resourceUsage_;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline void Process::stdin(std::string_view input) const {
+  return Process::writeInto<BUFFER_SIZE, void>(this->stdinPipe_, input);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline void Process::stdin(std::span<const std::byte> input) const {
+  return Process::writeInto<BUFFER_SIZE, void>(this->stdinPipe_, input);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+inline void Process::stdin(std::span<const std::string_view> inputs) const {
+  return Process::writeVectorInto<void>(this->stdinPipe_, inputs);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::tuple<typename Process::WriteError, std::size_t>
+Process::stdinCautious(
+    std::string_view input
+) const {
+  return Process::writeInto<BUFFER_SIZE, std::tuple<WriteError, std::size_t>>(
+      this->stdinPipe_, input
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::tuple<typename Process::WriteError, std::size_t>
+Process::stdinCautious(
+    std::span<const std::byte> input
+) const {
+  return Process::writeInto<BUFFER_SIZE, std::tuple<WriteError, std::size_t>>(
+      this->stdinPipe_, input
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+inline std::tuple<typename Process::WriteError, std::size_t>
+Process::stdinCautious(
+    std::span<const std::string_view> inputs
+) const {
+  return Process::writeVectorInto<std::tuple<WriteError, std::size_t>>(
+      this->stdinPipe_, inputs
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+inline void Process::stdinSpliced(std::span<const std::byte> input) const {
+  return Process::spliceInto<void>(this->stdinPipe_, input);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+inline void Process::stdinSpliced(std::string_view input) const {
+  return this->stdinSpliced(std::as_bytes(std::span<const char>{input}));
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+inline std::tuple<typename Process::WriteError, std::size_t>
+Process::stdinSplicedCautious(std::span<const std::byte> input) const {
+  return Process::spliceInto<std::tuple<WriteError, std::size_t>>(
+      this->stdinPipe_, input
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+inline std::tuple<typename Process::WriteError, std::size_t>
+Process::stdinSplicedCautious(std::string_view input) const {
+  return this->stdinSplicedCautious(
+      std::as_bytes(std::span<const char>{input})
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+inline void Process::closeStdin() {
+  if (this->stdinPipe_ >= 0) {
+    ::close(this->stdinPipe_);
+    this->stdinPipe_ = -1;
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::string Process::stdout() const {
+  return Process::readFrom<BUFFER_SIZE, std::string>(this->stdoutPipe_);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::tuple<std::string, typename Process::ReadError>
+Process::stdoutCautious() const {
+  return Process::readFrom<BUFFER_SIZE, std::tuple<std::string, ReadError>>(
+      this->stdoutPipe_
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::string Process::stderr() const {
+  return Process::readFrom<BUFFER_SIZE, std::string>(this->stderrPipe_);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline std::tuple<std::string, typename Process::ReadError>
+Process::stderrCautious() const {
+  return Process::readFrom<BUFFER_SIZE, std::tuple<std::string, ReadError>>(
+      this->stderrPipe_
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::stdoutChunks(Callback&& callback) const {
+  return Process::readChunksFrom<BUFFER_SIZE>(
+      this->stdoutPipe_, std::forward<Callback>(callback)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::stderrChunks(Callback&& callback) const {
+  return Process::readChunksFrom<BUFFER_SIZE>(
+      this->stderrPipe_, std::forward<Callback>(callback)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::stdoutLines(Callback&& callback) const {
+  return Process::readLinesFrom<BUFFER_SIZE>(
+      this->stdoutPipe_, std::forward<Callback>(callback)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::stderrLines(Callback&& callback) const {
+  return Process::readLinesFrom<BUFFER_SIZE>(
+      this->stderrPipe_, std::forward<Callback>(callback)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+template <std::size_t BUFFER_SIZE>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::stdoutTo(const int& fd) const {
+  return Process::spliceFrom<BUFFER_SIZE>(this->stdoutPipe_, fd);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+template <std::size_t BUFFER_SIZE>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::stderrTo(const int& fd) const {
+  return Process::spliceFrom<BUFFER_SIZE>(this->stderrPipe_, fd);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+template <std::size_t BUFFER_SIZE, class Sink>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::stdoutTee(const int& fd, Sink&& sink) const {
+  return Process::teeFrom<BUFFER_SIZE>(
+      this->stdoutPipe_, fd, std::forward<Sink>(sink)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+template <std::size_t BUFFER_SIZE, class Sink>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::stderrTee(const int& fd, Sink&& sink) const {
+  return Process::teeFrom<BUFFER_SIZE>(
+      this->stderrPipe_, fd, std::forward<Sink>(sink)
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+inline std::tuple<std::string, std::string>
+Process::communicate(std::string_view input) {
+  auto [out, err, writeError, readError] = this->communicateCautious(input);
+  return { std::move(out), std::move(err), };
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<poll.h>) && __has_include(<signal.h>)
+inline std::tuple<
+    std::string,
+    std::string,
+    typename Process::WriteError,
+    typename Process::ReadError
+> Process::communicateCautious(std::string_view input) {
+  auto writeError = WriteError::NO_ERROR;
+  auto readError = ReadError::NO_ERROR;
+  //! block SIGPIPE so that a process closing its stdin early
+  //!     is reported as WriteError::PIPE instead of killing the caller
+  sigset_t pipeSignal;
+  sigset_t previousSignals;
+  ::sigemptyset(&pipeSignal);
+  ::sigaddset(&pipeSignal, SIGPIPE);
+  ::pthread_sigmask(SIG_BLOCK, &pipeSignal, &previousSignals);
+  sigset_t pendingSignals;
+  ::sigpending(&pendingSignals);
+  const auto pipeSignalWasPending = ::sigismember(&pendingSignals, SIGPIPE);
+  if (this->stdinPipe_ >= 0 && !input.empty()) {
+    //! a blocking write could wait for the process reading its stdin
+    //!     while the process waits for the caller reading its stdout
+    const auto flags = ::fcntl(this->stdinPipe_, F_GETFL);
+    ::fcntl(this->stdinPipe_, F_SETFL, flags | O_NONBLOCK);
+  } else {
+    if (this->stdinPipe_ < 0 && !input.empty()) {
+      //! the input cannot be passed => the outputs are read anyway
+      writeError = WriteError::BADF;
+    }
+    this->closeStdin();
+  }
+  std::string outputs[2];
+  pollfd fds[3] = {
+    { this->stdinPipe_, POLLOUT, 0, },
+    { this->stdoutPipe_, POLLIN, 0, },
+    { this->stderrPipe_, POLLIN, 0, },
+  };
+  auto written = std::size_t{0};
+  while (fds[0].fd >= 0 || fds[1].fd >= 0 || fds[2].fd >= 0) {
+    //! negative file descriptors are ignored by poll()
+    if (::poll(fds, 3, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      readError = static_cast<ReadError>(errno);
+      break;
+    }
+    if (fds[0].revents != 0) { //! writable or the reader is gone
+      const auto bytes = ::write(
+          fds[0].fd,
+          input.data() + written,
+          std::min(input.size() - written, Process::WRITE_SIZE)
+      );
+      if (bytes >= 0) {
+        written += static_cast<std::size_t>(bytes);
+      } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+        writeError = static_cast<WriteError>(errno);
+      }
+      if (written == input.size() || writeError != WriteError::NO_ERROR) {
+        this->closeStdin();
+        fds[0].fd = -1;
+      }
+    }
+    for (auto i = 1; i < 3; i++) {
+      if (fds[i].revents == 0) {
+        continue;
+      }
+      const auto bytes =
+          Process::readSomeInto<READ_SIZE>(fds[i].fd, outputs[i - 1]);
+      if (bytes == 0) { //! end of file
+        fds[i].fd = -1;
+      } else if (bytes < 0 && errno != EINTR && errno != EAGAIN) {
+        readError = static_cast<ReadError>(errno);
+        fds[i].fd = -1;
+      }
+    }
+  }
+  if (fds[0].fd >= 0) { //! stopped by a poll() error
+    this->closeStdin();
+  }
+  if (writeError == WriteError::PIPE && !pipeSignalWasPending) {
+    //! consume SIGPIPE generated by this call before unblocking it
+    const auto noWait = timespec{};
+    ::sigtimedwait(&pipeSignal, nullptr, &noWait);
+  }
+  ::pthread_sigmask(SIG_SETMASK, &previousSignals, nullptr);
+  for (auto& output : outputs) {
+    if (output.capacity() / 2 > output.size()) {
+      //! release the spare space left by the geometric growth
+      output.shrink_to_fit();
+    }
+  }
+  return {
+    std::move(outputs[0]),
+    std::move(outputs[1]),
+    writeError,
+    readError,
+  };
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<signal.h>)
+inline void Process::signal(const int& code) const {
+  this->sendSignal(code);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<signal.h>)
+inline typename Process::SignalError Process::signalCautious(
+    const int& code
+) const {
+  if (this->sendSignal(code) != 0) {
+    return static_cast<SignalError>(errno);
+  }
+  return SignalError::NO_ERROR;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<signal.h>)
+inline int Process::sendSignal(const int& code) const {
+#if __has_include(<sys/syscall.h>) && defined(SYS_pidfd_send_signal)
+  if (this->pidfd_ >= 0) {
+    //! the raw system call is used because the wrapper may be not declared
+    const auto ret = ::syscall(
+        SYS_pidfd_send_signal, this->pidfd_, code, NULL, 0
+    );
+    if (ret == 0 || errno != ENOSYS) {
+      return ret == 0 ? 0 : -1;
+    }
+  }
+#endif
+  return ::kill(this->pid_, code);
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Return>
+Return Process::writeInto(
+    const int& pipe,
+    std::span<const std::byte> input
+) {
+  static_assert(
+      std::is_same_v<Return, void> ||
+      std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+  );
+  static_assert(BUFFER_SIZE > 0, "BUFFER_SIZE needs to have space for data");
+  auto bytesWritten = std::size_t{0};
+  while (bytesWritten < input.size()) {
+    const auto writeResult = ::write(
+        pipe,
+        input.data() + bytesWritten,
+        std::min(input.size() - bytesWritten, BUFFER_SIZE)
+    );
+    if (writeResult < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if constexpr (std::is_same_v<Return, void>) {
+        return;
+      } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+        return { static_cast<WriteError>(errno), bytesWritten, };
+      }
+    }
+    bytesWritten += writeResult;
+  }
+  if constexpr (std::is_same_v<Return, void>) {
+    return;
+  } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+    return { WriteError::NO_ERROR, bytesWritten, };
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Return>
+Return Process::writeInto(
+    const int& pipe,
+    std::string_view input
+) {
+  return Process::writeInto<BUFFER_SIZE, Return>(
+      pipe, std::as_bytes(std::span<const char>{input})
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+template <class Return>
+Return Process::writeVectorInto(
+    const int& pipe,
+    std::span<const std::string_view> inputs
+) {
+  static_assert(
+      std::is_same_v<Return, void> ||
+      std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+  );
+  //! maximal number of buffers passed to one writev() @see IOV_MAX
+  constexpr auto VECTOR_SIZE = std::size_t{64};
+  iovec vector[VECTOR_SIZE];
+  auto bytesWritten = std::size_t{0};
+  //! index of the first input which has not been written completely
+  auto first = std::size_t{0};
+  //! number of bytes of the first input which have been written
+  auto offset = std::size_t{0};
+  while (first < inputs.size()) {
+    auto count = std::size_t{0};
+    for (
+        auto i = first;
+        i < inputs.size() && count < VECTOR_SIZE;
+        i++
+    ) {
+      const auto skip = i == first ? offset : 0;
+      if (inputs[i].size() == skip) {
+        continue;
+      }
+      vector[count].iov_base = const_cast<char*>(inputs[i].data() + skip);
+      vector[count].iov_len = inputs[i].size() - skip;
+      count++;
+    }
+    if (count == 0) { //! only empty inputs are left
+      break;
+    }
+    auto writeResult = ::writev(pipe, vector, count);
+    if (writeResult < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if constexpr (std::is_same_v<Return, void>) {
+        return;
+      } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+        return { static_cast<WriteError>(errno), bytesWritten, };
+      }
+    }
+    bytesWritten += writeResult;
+    //! skip the written inputs
+    while (first < inputs.size()) {
+      const auto left = static_cast<ssize_t>(inputs[first].size() - offset);
+      if (writeResult < left) {
+        offset += writeResult;
+        break;
+      }
+      writeResult -= left;
+      offset = 0;
+      first++;
+    }
+  }
+  if constexpr (std::is_same_v<Return, void>) {
+    return;
+  } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+    return { WriteError::NO_ERROR, bytesWritten, };
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/uio.h>)
+template <class Return>
+Return Process::spliceInto(
+    const int& pipe,
+    std::span<const std::byte> input
+) {
+  static_assert(
+      std::is_same_v<Return, void> ||
+      std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+  );
+  auto bytesWritten = std::size_t{0};
+#ifdef SPLICE_F_MOVE
+  while (bytesWritten < input.size()) {
+    auto vector = iovec{
+      .iov_base = const_cast<std::byte*>(input.data() + bytesWritten),
+      .iov_len = input.size() - bytesWritten,
+    };
+    const auto spliceResult = ::vmsplice(pipe, &vector, 1, 0);
+    if (spliceResult < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EINVAL || errno == ENOSYS) {
+        //! vmsplice() is not supported for the pipe -> write the rest
+        break;
+      }
+      if constexpr (std::is_same_v<Return, void>) {
+        return;
+      } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+        return { static_cast<WriteError>(errno), bytesWritten, };
+      }
+    }
+    bytesWritten += spliceResult;
+  }
+#endif
+  if constexpr (std::is_same_v<Return, void>) {
+    Process::writeInto<WRITE_SIZE, void>(pipe, input.subspan(bytesWritten));
+  } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
+    const auto [error, bytes] =
+        Process::writeInto<WRITE_SIZE, Return>(
+            pipe, input.subspan(bytesWritten)
+        );
+    return { error, bytesWritten + bytes, };
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Return>
+inline Return Process::readFrom(const int& pipe) {
+  static_assert(
+      std::is_same_v<Return, std::string> ||
+      std::is_same_v<Return, std::tuple<std::string, ReadError>>
+  );
+  auto ret = std::string{};
+  auto error = ReadError::NO_ERROR;
+  while (true) {
+    const auto bytes = Process::readSomeInto<BUFFER_SIZE>(pipe, ret);
+    if (bytes < 0) { //! read failed
+      if (errno == EINTR) {
+        continue;
+      }
+      error = static_cast<ReadError>(errno);
+      break;
+    }
+    if (bytes == 0) { //! end of file
+      break;
+    }
+  }
+  if (ret.capacity() / 2 > ret.size()) {
+    //! release the spare space left by the geometric growth
+    ret.shrink_to_fit();
+  }
+  if constexpr (std::is_same_v<Return, std::string>) {
+    return ret;
+  } else { //! std::is_same_v<Return, std::tuple<std::string, ReadError>>
+    return { std::move(ret), error, };
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE>
+inline ssize_t Process::readSomeInto(const int& pipe, std::string& buffer) {
+  static_assert(BUFFER_SIZE > 0, "BUFFER_SIZE needs to have space for data");
+  constexpr auto CHUNK_SIZE = std::min(BUFFER_SIZE, STACK_READ_SIZE_);
+  auto available = std::size_t{0};
+#if __has_include(<sys/ioctl.h>) && defined(FIONREAD)
+  int pending = 0;
+  if (::ioctl(pipe, FIONREAD, &pending) == 0 && pending > 0) {
+    available = static_cast<std::size_t>(pending);
+  }
+#endif
+  if (available <= CHUNK_SIZE) { //! little or nothing pending -> stack chunk
+    char chunk[CHUNK_SIZE];
+    const auto bytes = ::read(pipe, chunk, CHUNK_SIZE);
+    if (bytes > 0) {
+      buffer.append(chunk, static_cast<std::size_t>(bytes));
+    }
+    return bytes;
+  }
+  const auto size = buffer.size();
+  if (buffer.capacity() - size < available) {
+    //! grow geometrically to keep the number of copies logarithmic
+    buffer.reserve(std::max(size + available, buffer.capacity() * 2));
+  }
+  //! only the pending bytes are exposed => they are overwritten by the read
+  buffer.resize(size + available);
+  const auto bytes = ::read(pipe, buffer.data() + size, available);
+  buffer.resize(size + static_cast<std::size_t>(std::max(bytes, ssize_t{0})));
+  return bytes;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::readChunksFrom(
+    const int& pipe,
+    Callback&& callback
+) {
+  static_assert(BUFFER_SIZE > 0, "BUFFER_SIZE needs to have space for data");
+  auto storage = ReadBuffer<BUFFER_SIZE>{};
+  auto* const buffer = storage.data();
+  while (true) {
+    const auto bytes = ::read(pipe, buffer, BUFFER_SIZE);
+    if (bytes < 0) { //! read failed
+      if (errno == EINTR) {
+        continue;
+      }
+      return static_cast<ReadError>(errno);
+    }
+    if (bytes == 0) { //! end of file
+      return ReadError::NO_ERROR;
+    }
+    const auto chunk = std::span<const std::byte>{
+      buffer, static_cast<std::size_t>(bytes)
+    };
+    if constexpr (
+        std::is_same_v<
+            std::invoke_result_t<Callback, std::span<const std::byte>>, bool
+        >
+    ) {
+      if (!callback(chunk)) {
+        return ReadError::NO_ERROR;
+      }
+    } else {
+      callback(chunk);
+    }
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Callback>
+typename Process::ReadError Process::readLinesFrom(
+    const int& pipe,
+    Callback&& callback
+) {
+  //! calls the callback and converts the result to "continue reading"
+  const auto call = [&callback](std::string_view line) {
+    if constexpr (
+        std::is_same_v<std::invoke_result_t<Callback, std::string_view>, bool>
+    ) {
+      return callback(line);
+    } else {
+      callback(line);
+      return true;
+    }
+  };
+  //! incomplete line left from the previous chunks
+  auto partial = std::string{};
+  auto stopped = false;
+  const auto ret = Process::readChunksFrom<BUFFER_SIZE>(
+      pipe,
+      [&call, &partial, &stopped](std::span<const std::byte> chunk) {
+        auto data = std::string_view{
+          reinterpret_cast<const char*>(chunk.data()), chunk.size()
+        };
+        for (
+            auto pos = data.find('\n');
+            pos != std::string_view::npos;
+            pos = data.find('\n')
+        ) {
+          auto completed = true;
+          if (partial.empty()) {
+            completed = call(data.substr(0, pos));
+          } else {
+            partial.append(data.substr(0, pos));
+            completed = call(partial);
+            partial.clear();
+          }
+          data.remove_prefix(pos + 1);
+          if (!completed) {
+            stopped = true;
+            return false;
+          }
+        }
+        partial.append(data);
+        return true;
+      }
+  );
+  if (!stopped && !partial.empty()) {
+    call(partial);
+  }
+  return ret;
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+template <std::size_t BUFFER_SIZE>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::spliceFrom(const int& pipe, const int& fd) {
+  if (pipe < 0) {
+    return { 0, ReadError::BADF, WriteError::NO_ERROR, };
+  }
+  auto moved = std::size_t{0};
+#ifdef SPLICE_F_MOVE
+  while (true) {
+    const auto bytes =
+        ::splice(pipe, NULL, fd, NULL, BUFFER_SIZE, SPLICE_F_MOVE);
+    if (bytes > 0) {
+      moved += bytes;
+      continue;
+    }
+    if (bytes == 0) { //! end of file
+      return { moved, ReadError::NO_ERROR, WriteError::NO_ERROR, };
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EINVAL || errno == ENOSYS) {
+      //! splice() is not supported for the file descriptor -> copy the rest
+      break;
+    }
+#if __has_include(<poll.h>)
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      //! a side is non-blocking -> wait for data in the pipe first,
+      //!     then for space in the file descriptor
+      pollfd descriptors[2] = { { pipe, POLLIN, 0, }, { fd, POLLOUT, 0, }, };
+      for (auto& descriptor : descriptors) {
+        while (::poll(&descriptor, 1, -1) < 0 && errno == EINTR) {}
+      }
+      continue;
+    }
+#endif
+    //! the pipe fails only if it is not a readable file descriptor =>
+    //!     other errors are errors of the file descriptor
+    const auto error = errno;
+    const auto flags = ::fcntl(pipe, F_GETFL);
+    if (flags < 0 || (flags & O_ACCMODE) == O_WRONLY) {
+      return { moved, static_cast<ReadError>(error), WriteError::NO_ERROR, };
+    }
+    return { moved, ReadError::NO_ERROR, static_cast<WriteError>(error), };
+  }
+#endif
+  return Process::copyFrom<BUFFER_SIZE>(
+      pipe, fd, [](std::span<const std::byte>) {}, moved
+  );
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>)
+template <std::size_t BUFFER_SIZE, class Sink>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::teeFrom(const int& pipe, const int& fd, Sink&& sink) {
+  if (pipe < 0) {
+    return { 0, ReadError::BADF, WriteError::NO_ERROR, };
+  }
+#if defined(SPLICE_F_MOVE) && defined(F_GETPIPE_SZ)
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    return { 0, ReadError::NO_ERROR, static_cast<WriteError>(errno), };
+  }
+  //! tee() duplicates into a pipe only => if the file descriptor is not
+  //!     a pipe -> the duplicate is spliced from an intermediate pipe
+  int intermediate[2] = { -1, -1, };
+  auto size = BUFFER_SIZE;
+  if (!S_ISFIFO(status.st_mode)) {
+    if (Process::pipeOf(intermediate) != 0) {
+      return { 0, ReadError::NO_ERROR, static_cast<WriteError>(errno), };
+    }
+    //! the whole duplicate has to fit into the intermediate pipe
+    const auto capacity = ::fcntl(intermediate[1], F_GETPIPE_SZ);
+    if (capacity > 0) {
+      size = std::min(size, static_cast<std::size_t>(capacity));
+    }
+  }
+  const auto target = intermediate[1] < 0 ? fd : intermediate[1];
+  auto storage = ReadBuffer<BUFFER_SIZE>{};
+  auto* const buffer = storage.data();
+  auto moved = std::size_t{0};
+  auto readError = ReadError::NO_ERROR;
+  auto writeError = WriteError::NO_ERROR;
+  auto fallback = false;
+  while (true) {
+    const auto duplicated = ::tee(pipe, target, size, 0);
+    if (duplicated < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EINVAL) { //! tee() is not supported -> copy the rest
+        fallback = true;
+      } else {
+        writeError = static_cast<WriteError>(errno);
+      }
+      break;
+    }
+    if (duplicated == 0) { //! end of file
+      break;
+    }
+    auto spliced = ssize_t{0};
+    while (intermediate[0] >= 0 && spliced < duplicated) {
+      const auto bytes = ::splice(
+          intermediate[0], NULL, fd, NULL, duplicated - spliced, SPLICE_F_MOVE
+      );
+      if (bytes < 0 && errno != EINTR) {
+        break;
+      }
+      spliced += std::max(bytes, ssize_t{0});
+    }
+    if (intermediate[0] >= 0 && spliced < duplicated) {
+      if (spliced == 0 && (errno == EINVAL || errno == ENOSYS)) {
+        //! the duplicate is dropped with the intermediate pipe and
+        //!     the data are still in the pipe -> copy the rest
+        fallback = true;
+      } else {
+        writeError = static_cast<WriteError>(errno);
+      }
+      break;
+    }
+    //! the duplicate has been written => consume the data for the sink
+    auto consumed = ssize_t{0};
+    while (consumed < duplicated) {
+      const auto bytes =
+          ::read(pipe, buffer + consumed, duplicated - consumed);
+      if (bytes < 0 && errno != EINTR) {
+        readError = static_cast<ReadError>(errno);
+        break;
+      }
+      consumed += std::max(bytes, ssize_t{0});
+    }
+    moved += duplicated;
+    if (readError != ReadError::NO_ERROR) {
+      break;
+    }
+    const auto chunk = std::span<const std::byte>{
+      buffer, static_cast<std::size_t>(duplicated)
+    };
+    if constexpr (
+        std::is_same_v<
+            std::invoke_result_t<Sink, std::span<const std::byte>>, bool
+        >
+    ) {
+      if (!sink(chunk)) {
+        break;
+      }
+    } else {
+      sink(chunk);
+    }
+  }
+  if (intermediate[0] >= 0) {
+    ::close(intermediate[0]);
+    ::close(intermediate[1]);
+  }
+  if (!fallback) {
+    return { moved, readError, writeError, };
+  }
+  return Process::copyFrom<BUFFER_SIZE>(
+      pipe, fd, std::forward<Sink>(sink), moved
+  );
+#else
+  return Process::copyFrom<BUFFER_SIZE>(
+      pipe, fd, std::forward<Sink>(sink), 0
+  );
+#endif
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+template <std::size_t BUFFER_SIZE, class Sink>
+std::tuple<std::size_t, Process::ReadError, Process::WriteError>
+Process::copyFrom(
+    const int& pipe,
+    const int& fd,
+    Sink&& sink,
+    std::size_t moved
+) {
+  auto writeError = WriteError::NO_ERROR;
+  const auto readError = Process::readChunksFrom<BUFFER_SIZE>(
+      pipe,
+      [&fd, &sink, &moved, &writeError](std::span<const std::byte> chunk) {
+        const auto [error, bytes] = Process::writeInto<
+            BUFFER_SIZE, std::tuple<WriteError, std::size_t>
+        >(fd, chunk);
+        moved += bytes;
+        if (error != WriteError::NO_ERROR) {
+          writeError = error;
+          return false;
+        }
+        if constexpr (
+            std::is_same_v<
+                std::invoke_result_t<Sink, std::span<const std::byte>>, bool
+            >
+        ) {
+          return sink(chunk);
+        } else {
+          sink(chunk);
+          return true;
+        }
+      }
+  );
+  return { moved, readError, writeError, };
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+template <class Return>
+inline Return Process::waitExitLoop() {
+  static_assert(
+      std::is_same_v<Return, void> ||
+      std::is_same_v<Return, WaitError>
+  );
+  while (true) {
+#if __has_include(<sys/syscall.h>) && defined(SYS_waitid)
+    if (this->pidfd_ >= 0) {
+      auto info = siginfo_t{};
+#if __has_include(<sys/resource.h>)
+      //! the system call reports the resource usage unlike ::waitid()
+      auto usage = rusage{};
+      auto* const usagePointer = &usage;
+#else
+      void* const usagePointer = NULL;
+#endif
+      //! the raw system call is used because P_PIDFD may be not declared
+      const auto ret = ::syscall(
+          SYS_waitid,
+          Process::P_PIDFD_,
+          this->pidfd_,
+          &info,
+          WEXITED,
+          usagePointer
+      );
+      if (ret == 0) {
+#if __has_include(<sys/resource.h>)
+        this->storeUsage(usage);
+#endif
+        switch (info.si_code) {
+        case CLD_EXITED:
+          this->exitCode_ = info.si_status;
+          break;
+        case CLD_KILLED:
+        case CLD_DUMPED:
+          //! no error handling is needed because the process has been waited
+          //!     even if it was terminated
+          this->terminationCode_ = info.si_status;
+          break;
+        case CLD_STOPPED:
+        case CLD_TRAPPED:
+          //! no error handling is needed because the process has been waited
+          //!     even if it was stopped
+          this->stopCode_ = info.si_status;
+          break;
+        }
+        break;
+      }
+      if (errno == EINTR && std::is_same_v<Return, void>) {
+        continue;
+      }
+      //! EINVAL means that P_PIDFD is not supported by the kernel ->
+      //!     fall back to waitpid()
+      if (errno != EINVAL) {
+        if constexpr (std::is_same_v<Return, WaitError>) {
+          return static_cast<WaitError>(errno);
+        } else { //! std::is_same_v<Return, void>
+          //! no error handling
+          return;
+        }
+      }
+    }
+#endif
+    const auto pid = this->waitStatus(0);
+    if (pid == -1) {
+      if (errno == EINTR && std::is_same_v<Return, void>) {
+        continue;
+      }
+      if constexpr (std::is_same_v<Return, WaitError>) {
+        return static_cast<WaitError>(errno);
+      } else { //! std::is_same_v<Return, void>
+        //! no error handling
+        return;
+      }
+    }
+    break;
+  }
+  if constexpr (std::is_same_v<Return, WaitError>) {
+    return WaitError::NO_ERROR;
+  } else { //! std::is_same_v<Return, void>
+    return;
+  }
+}
+#endif
+#endif
+
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+inline void Process::storeStatus(const int& status) {
+  if (WIFEXITED(status) == 0) {
+    if (WIFSIGNALED(status) != 0) {
+      this->terminationCode_ = WTERMSIG(status);
+      //! no error handling is needed because the process has been waited
+      //!     even if it was terminated
+    }
+    if (WIFSTOPPED(status) != 0) {
+      this->stopCode_ = WSTOPSIG(status);
+      //! no error handling is needed because the process has been waited
+      //!     even if it was stopped
+    }
+    return;
   }
-  auto process = Process{};
-  process.pid_ = pid;
-  process.stdinPipe_ = inFd[1];
-  process.stdoutPipe_ = outFd[0];
-  process.stderrPipe_ = errFd[0];
-  return process;
+  this->exitCode_ = WEXITSTATUS(status);
 }
 #endif
 #endif
 
-inline Process::~Process() {
 #ifdef __unix__
-#if __has_include(<unistd.h>)
-  ::close(this->stdinPipe_);
-  ::close(this->stdoutPipe_);
-  ::close(this->stderrPipe_);
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+inline pid_t Process::waitStatus(const int& options) {
+  int status;
+#if __has_include(<sys/resource.h>)
+  auto usage = rusage{};
+  const auto ret = ::wait4(this->pid_, &status, options, &usage);
+#else
+  const auto ret = ::waitpid(this->pid_, &status, options);
 #endif
+  if (ret > 0) {
+    this->storeStatus(status);
+#if __has_include(<sys/resource.h>)
+    this->storeUsage(usage);
 #endif
-}
-
-constexpr Process::Process(Process&& other) {
-  this->swap(std::move(other));
-}
-
-constexpr Process& Process::operator =(Process&& other) {
-  if (this != &other) {
-    this->swap(std::move(other));
   }
-  return *this;
-}
-
-constexpr const unsigned& Process::pid() const {
-  return this->pid_;
-}
-
-#ifdef __unix__
-#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-inline void Process::wait() {
-  this->waitExitLoop<void>();
+  return ret;
 }
 #endif
 #endif
 
 #ifdef __unix__
-#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-inline typename Process::WaitError Process::waitCautious() {
-  return this->waitExitLoop<WaitError>();
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+inline void Process::storeUsage(const rusage& usage) {
+  const auto microsecondsOf = [](const timeval& time) {
+    return std::chrono::seconds{time.tv_sec} +
+        std::chrono::microseconds{time.tv_usec};
+  };
+  this->resourceUsage_ = ResourceUsage{
+    .userTime = microsecondsOf(usage.ru_utime),
+    .systemTime = microsecondsOf(usage.ru_stime),
+    .maxResidentSetSize = usage.ru_maxrss,
+    .minorPageFaults = usage.ru_minflt,
+    .majorPageFaults = usage.ru_majflt,
+    .voluntaryContextSwitches = usage.ru_nvcsw,
+    .involuntaryContextSwitches = usage.ru_nivcsw,
+  };
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-constexpr const std::optional<int>& Process::exitCode() const {
-  return this->exitCode_;
+constexpr bool Process::waited() const {
+  return this->exitCode_.has_value() || this->terminationCode_.has_value();
 }
 #endif
 #endif
 
 #ifdef __unix__
-#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-constexpr const std::optional<int>& Process::terminationCode() const {
-  return this->terminationCode_;
+template <class Clock, class Duration>
+inline int Process::timeoutUntil(
+    const std::chrono::time_point<Clock, Duration>& deadline
+) {
+  //! rounded up to never wake up too early
+  const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+      deadline - Clock::now()
+  ).count();
+  return static_cast<int>(std::clamp<decltype(left)>(
+      left, 0, std::numeric_limits<int>::max()
+  ));
 }
 #endif
-#endif
 
 #ifdef __unix__
-#if __has_include(<unistd.h>)
-inline void Process::stdin(const std::string& input) const {
-  return Process::writeInto<1024, void>(this->stdinPipe_, input);
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<poll.h>)
+template <class Timeout>
+inline typename Process::WaitError Process::waitAllLoop(
+    std::span<Process> processes,
+    Timeout&& timeout
+) {
+  auto fds = std::vector<pollfd>{};
+  auto indices = std::vector<std::size_t>{};
+  auto withoutPidfd = std::vector<std::size_t>{};
+  for (auto i = std::size_t{0}; i < processes.size(); i++) {
+    if (processes[i].waited()) {
+      continue;
+    }
+    if (processes[i].pidfd_ >= 0) {
+      fds.push_back({ processes[i].pidfd_, POLLIN, 0, });
+      indices.push_back(i);
+    } else {
+      withoutPidfd.push_back(i);
+    }
+  }
+  while (!fds.empty()) {
+    const auto left = timeout();
+    const auto ret = ::poll(fds.data(), fds.size(), left);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return static_cast<WaitError>(errno);
+    }
+    if (ret == 0) {
+      if (timeout() != 0) { //! the clock of the deadline is not steady
+        continue;
+      }
+      return WaitError::TIMEDOUT;
+    }
+    //! wait every exited process and stop polling its file descriptor
+    for (auto j = fds.size(); j-- > 0;) {
+      if (fds[j].revents == 0) {
+        continue;
+      }
+      const auto error = processes[indices[j]].waitExitLoop<WaitError>();
+      if (error != WaitError::NO_ERROR) {
+        return error;
+      }
+      fds[j] = fds.back();
+      fds.pop_back();
+      indices[j] = indices.back();
+      indices.pop_back();
+    }
+  }
+  for (const auto& i : withoutPidfd) {
+    const auto left = timeout();
+    const auto error = left < 0 ?
+        processes[i].waitExitLoop<WaitError>() :
+        processes[i].waitFor(std::chrono::milliseconds{left});
+    if (error != WaitError::NO_ERROR) {
+      return error;
+    }
+  }
+  return WaitError::NO_ERROR;
 }
 #endif
 #endif
 
 #ifdef __unix__
-#if __has_include(<unistd.h>)
-inline std::tuple<typename Process::WriteError, std::size_t>
-Process::stdinCautious(
-    const std::string& input
-) const {
-  return Process::writeInto<1024, std::tuple<WriteError, std::size_t>>(
-      this->stdinPipe_, input
-  );
+#if __has_include(<sys/syscall.h>)
+inline int Process::pidfdOf(const pid_t& pid) {
+#ifdef SYS_pidfd_open
+  const auto pidfd = ::syscall(SYS_pidfd_open, pid, 0);
+  if (pidfd >= 0) {
+    return static_cast<int>(pidfd);
+  }
+#endif
+  return -1;
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-inline std::string
-Process::stdout() const {
-  return Process::readFrom<1024, std::string>(this->stdoutPipe_);
+inline std::variant<std::tuple<pid_t, int>, Process::CreateError>
+Process::spawn(
+    char* const* argv,
+    char* const* envp,
+    const std::array<int, 3>& fds,
+    const SpawnStrategy& strategy
+) {
+  const auto pairs = std::array<std::pair<int, int>, 3>{
+    std::pair{ 0, fds[0], }, std::pair{ 1, fds[1], }, std::pair{ 2, fds[2], },
+  };
+  return Process::spawn(argv, envp, pairs, strategy);
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-inline std::tuple<std::string, typename Process::ReadError>
-Process::stdoutCautious() const {
-  return Process::readFrom<1024, std::tuple<std::string, ReadError>>(
-      this->stdoutPipe_
-  );
+inline std::variant<std::tuple<pid_t, int>, Process::CreateError>
+Process::spawn(
+    char* const* argv,
+    char* const* envp,
+    std::span<const std::pair<int, int>> fds,
+    const SpawnStrategy& strategy
+) {
+  //! allocated before the spawn => the spawned process allocates nothing
+  std::array<int, 8> buffer;
+  auto allocated = std::vector<int>{};
+  auto scratch = std::span<int>{buffer};
+  if (fds.size() > buffer.size()) {
+    allocated.resize(fds.size());
+    scratch = allocated;
+  }
+  scratch = scratch.first(fds.size());
+  switch (strategy) {
+  case SpawnStrategy::VFORK: {
+    const auto pid = ::vfork();
+    if (pid == 0) { //! forked process
+      Process::execute(argv, envp, fds, scratch);
+    }
+    if (pid < 0) { //! fork failed
+      return static_cast<CreateError>(errno);
+    }
+#if __has_include(<sys/syscall.h>)
+    return std::make_tuple(pid, Process::pidfdOf(pid));
+#else
+    return std::make_tuple(pid, -1);
+#endif
+  }
+  case SpawnStrategy::FORK: {
+    const auto pid = ::fork();
+    if (pid == 0) { //! forked process
+      Process::execute(argv, envp, fds, scratch);
+    }
+    if (pid < 0) { //! fork failed
+      return static_cast<CreateError>(errno);
+    }
+#if __has_include(<sys/syscall.h>)
+    return std::make_tuple(pid, Process::pidfdOf(pid));
+#else
+    return std::make_tuple(pid, -1);
+#endif
+  }
+  case SpawnStrategy::POSIX_SPAWN: {
+#if __has_include(<spawn.h>)
+    posix_spawn_file_actions_t actions;
+    if (const auto ret = ::posix_spawn_file_actions_init(&actions); ret != 0) {
+      return static_cast<CreateError>(ret);
+    }
+    posix_spawnattr_t attributes;
+    if (const auto ret = ::posix_spawnattr_init(&attributes); ret != 0) {
+      ::posix_spawn_file_actions_destroy(&actions);
+      return static_cast<CreateError>(ret);
+    }
+#ifdef POSIX_SPAWN_USEVFORK
+    ::posix_spawnattr_setflags(&attributes, POSIX_SPAWN_USEVFORK);
+#endif
+    auto ret = 0;
+    //! sources overwritten by another target are duplicated by this process
+    //!     with FD_CLOEXEC => the duplicates are closed by the spawn
+    auto lowest = 0;
+    for (const auto& [target, source] : fds) {
+      lowest = std::max(lowest, target + 1);
+    }
+    for (auto i = std::size_t{0}; i < fds.size(); i++) {
+      scratch[i] = Process::isOverwritten(fds, i) ?
+          ::fcntl(fds[i].second, F_DUPFD_CLOEXEC, lowest) :
+          fds[i].second;
+      if (scratch[i] < 0) {
+        ret = errno;
+        std::fill(scratch.begin() + i, scratch.end(), -1);
+        break;
+      }
+    }
+    for (auto i = std::size_t{0}; i < fds.size() && ret == 0; i++) {
+      //! duplicating a file descriptor onto itself clears FD_CLOEXEC
+      ret = ::posix_spawn_file_actions_adddup2(
+          &actions, scratch[i], fds[i].first
+      );
+    }
+    pid_t pid = 0;
+    auto pidfd = -1;
+#ifdef CU0_PIDFD_SPAWN_
+    if (ret == 0) {
+      ret = ::pidfd_spawn(&pidfd, argv[0], &actions, &attributes, argv, envp);
+      if (ret == 0) {
+        pid = ::pidfd_getpid(pidfd);
+      } else if (ret == ENOSYS) { //! the kernel does not support CLONE_PIDFD
+        ret = ::posix_spawn(&pid, argv[0], &actions, &attributes, argv, envp);
+      }
+    }
+#else
+    if (ret == 0) {
+      ret = ::posix_spawn(&pid, argv[0], &actions, &attributes, argv, envp);
+    }
+#endif
+    for (auto i = std::size_t{0}; i < fds.size(); i++) {
+      if (scratch[i] >= 0 && scratch[i] != fds[i].second) {
+        ::close(scratch[i]);
+      }
+    }
+    ::posix_spawnattr_destroy(&attributes);
+    ::posix_spawn_file_actions_destroy(&actions);
+    if (ret != 0) { //! spawn failed
+      return static_cast<CreateError>(ret);
+    }
+#if __has_include(<sys/syscall.h>)
+    if (pidfd < 0) {
+      pidfd = Process::pidfdOf(pid);
+    }
+#endif
+    return std::make_tuple(pid, pidfd);
+#else
+    return CreateError::NOSYS;
+#endif
+  }
+  case SpawnStrategy::CLONE: {
+#if __has_include(<sched.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<signal.h>) && defined(CLONE_VM) && defined(CLONE_PIDFD)
+    //! the memory is shared => the child needs a stack of its own
+    //!     instead of the frames of the suspended parent
+    auto* const stack = ::mmap(
+        nullptr,
+        CLONE_STACK_SIZE,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK,
+        -1,
+        0
+    );
+    if (stack == MAP_FAILED) {
+      return static_cast<CreateError>(errno);
+    }
+    //! all the signals are blocked until the child has reset the handlers
+    sigset_t all;
+    sigset_t previous;
+    ::sigfillset(&all);
+    ::pthread_sigmask(SIG_SETMASK, &all, &previous);
+    auto arguments = Cloned{
+      .argv = argv,
+      .envp = envp,
+      .fds = fds,
+      .scratch = scratch,
+      .mask = &previous,
+    };
+    auto pidfd = -1;
+    //! the stack grows down on the supported platforms
+    const auto pid = ::clone(
+        &Process::cloned,
+        static_cast<char*>(stack) + CLONE_STACK_SIZE,
+        CLONE_VM | CLONE_VFORK | CLONE_PIDFD | SIGCHLD,
+        &arguments,
+        &pidfd
+    );
+    const auto error = errno;
+    //! the child has called execve() or exited => the stack is unused
+    ::pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    ::munmap(stack, CLONE_STACK_SIZE);
+    if (pid < 0) { //! clone failed
+      return static_cast<CreateError>(error);
+    }
+    return std::make_tuple(static_cast<pid_t>(pid), pidfd);
+#else
+    return CreateError::NOSYS;
+#endif
+  }
+  }
+  return CreateError::INVAL;
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-inline std::string Process::stderr() const {
-  return Process::readFrom<1024, std::string>(this->stderrPipe_);
+inline Process::CreateError Process::openStdio(
+    const Stdio& stdio,
+    int (&pipes)[3],
+    int (&sources)[3],
+    bool (&owned)[3]
+) {
+  const Redirection* redirections[] = { &stdio.in, &stdio.out, &stdio.err, };
+  for (auto i = 0; i < 3; i++) {
+    pipes[i] = -1;
+    sources[i] = -1;
+    owned[i] = false;
+  }
+  const auto release = [&pipes, &sources, &owned]() {
+    for (auto i = 0; i < 3; i++) {
+      if (owned[i]) {
+        ::close(sources[i]);
+      }
+      if (pipes[i] >= 0) {
+        ::close(pipes[i]);
+      }
+    }
+  };
+  for (auto i = 0; i < 3; i++) {
+    const auto& redirection = *redirections[i];
+    switch (redirection.kind) {
+    case Redirection::Kind::PIPE: {
+      int fds[2];
+      if (Process::pipeOf(fds) != 0) {
+        const auto ret = static_cast<CreateError>(errno);
+        release();
+        return ret;
+      }
+      //! stdin is read by the created process, stdout and stderr are written
+      pipes[i] = fds[i == 0 ? 1 : 0];
+      sources[i] = fds[i == 0 ? 0 : 1];
+      owned[i] = true;
+      break;
+    }
+    case Redirection::Kind::INHERIT:
+      break;
+    case Redirection::Kind::NUL:
+    case Redirection::Kind::PATH: {
+      const auto nul = redirection.kind == Redirection::Kind::NUL;
+      const auto flags = !nul && redirection.flags.has_value() ?
+          *redirection.flags :
+          i == 0 ? O_RDONLY : O_WRONLY | (nul ? 0 : O_CREAT | O_TRUNC);
+      sources[i] = ::open(
+          nul ? "/dev/null" : redirection.path.c_str(), flags | O_CLOEXEC, 0666
+      );
+      if (sources[i] < 0) {
+        const auto ret = static_cast<CreateError>(errno);
+        release();
+        return ret;
+      }
+      owned[i] = true;
+      break;
+    }
+    case Redirection::Kind::FD:
+      if (redirection.descriptor < 0) {
+        release();
+        return CreateError::INVAL;
+      }
+      sources[i] = redirection.descriptor;
+      break;
+    case Redirection::Kind::STDOUT:
+      if (i != 2) {
+        release();
+        return CreateError::INVAL;
+      }
+      //! stdout of the created process is stdout of this process if inherited
+      sources[i] = sources[1] < 0 ? 1 : sources[1];
+      break;
+    case Redirection::Kind::MEMORY:
+      if (i != 0) {
+        release();
+        return CreateError::INVAL;
+      }
+      sources[i] = Process::memoryFileOf(redirection.data);
+      if (sources[i] < 0) {
+        const auto ret = static_cast<CreateError>(errno);
+        release();
+        return ret;
+      }
+      owned[i] = true;
+      break;
+    }
+  }
+  return CreateError::NO_ERROR;
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-inline std::tuple<std::string, typename Process::ReadError>
-Process::stderrCautious() const {
-  return Process::readFrom<1024, std::tuple<std::string, ReadError>>(
-      this->stderrPipe_
-  );
+inline int Process::pipeOf(int (&fds)[2]) {
+#ifdef __linux__
+  return ::pipe2(fds, O_CLOEXEC);
+#else
+  if (::pipe(fds) != 0) {
+    return -1;
+  }
+  ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+  return 0;
+#endif
 }
 #endif
 #endif
 
 #ifdef __unix__
-#if __has_include(<signal.h>)
-inline void Process::signal(const int& code) const {
-  ::kill(this->pid_, code);
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+inline int Process::memoryFileOf(std::span<const std::byte> data) {
+#if __has_include(<sys/mman.h>) && defined(MFD_ALLOW_SEALING) && \
+    defined(F_ADD_SEALS)
+  const auto fd = ::memfd_create("cu0-stdin", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    return -1;
+  }
+  //! sized in advance => the file does not grow write by write
+  auto failed = ::ftruncate(fd, data.size()) != 0;
+  //! pwrite() keeps the offset at the beginning for the created process
+  for (auto written = std::size_t{0}; !failed && written < data.size();) {
+    const auto bytes = ::pwrite(
+        fd, data.data() + written, data.size() - written, written
+    );
+    if (bytes < 0 && errno != EINTR) {
+      failed = true;
+    }
+    written += std::max(bytes, ssize_t{0});
+  }
+  if (
+      failed ||
+      ::fcntl(
+          fd,
+          F_ADD_SEALS,
+          F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL
+      ) != 0
+  ) {
+    const auto error = errno;
+    ::close(fd);
+    errno = error;
+    return -1;
+  }
+  return fd;
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
 }
 #endif
 #endif
 
-#ifdef __unix__
-#if __has_include(<signal.h>)
-inline typename Process::SignalError Process::signalCautious(
-    const int& code
-) const {
-  if (::kill(this->pid_, code) != 0) {
-    return static_cast<SignalError>(errno);
+constexpr bool Process::isOverwritten(
+    std::span<const std::pair<int, int>> fds,
+    const std::size_t& index
+) {
+  const auto source = fds[index].second;
+  for (auto i = std::size_t{0}; i < index; i++) {
+    //! a pair duplicating the source onto itself does not replace it
+    if (fds[i].first == source && fds[i].second != source) {
+      return true;
+    }
   }
-  return SignalError::NO_ERROR;
+  return false;
 }
-#endif
-#endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-template <std::size_t BUFFER_SIZE, class Return>
-Return Process::writeInto(
-    const int& pipe,
-    const std::string& input
+inline int Process::redirect(
+    std::span<const std::pair<int, int>> fds,
+    std::span<int> scratch
 ) {
-  static_assert(
-      std::is_same_v<Return, void> ||
-      std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
-  );
-  [[maybe_unused]] std::size_t bytesWritten;
-  if constexpr (std::is_same_v<Return, std::tuple<WriteError, std::size_t>>) {
-    bytesWritten = std::size_t{0};
+  //! the duplicates are placed above all the targets => not overwritten
+  auto lowest = 0;
+  for (const auto& [target, source] : fds) {
+    lowest = std::max(lowest, target + 1);
   }
-  char buffer[BUFFER_SIZE];
-  for (auto i = 0u; i <= input.size() / BUFFER_SIZE; i++) {
-    const auto data = input.substr(i * BUFFER_SIZE, BUFFER_SIZE);
-    std::size_t end;
-    if (data.size() != BUFFER_SIZE) {
-      end = data.size();
-    } else {
-      end = BUFFER_SIZE;
-    }
-    for (auto j = 0u; j < end; j++) {
-      buffer[j] = data[j];
-    }
-    auto bytes = 0;
-    for (
-        auto writeResult = ::write(pipe, buffer, end);
-        ;
-        writeResult = ::write(pipe, buffer + bytes, end - bytes)
-    ) {
-      if (writeResult < 0) {
-        if constexpr (std::is_same_v<Return, void>) {
-          return;
-        } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
-          bytesWritten += bytes;
-          return { static_cast<WriteError>(errno), bytesWritten, };
-        }
-      }
-      bytes += writeResult;
-      if (bytes >= static_cast<ssize_t>(end)) {
-        break;
-      }
-    }
-    if constexpr (std::is_same_v<Return, std::tuple<WriteError, std::size_t>>) {
-      bytesWritten += bytes;
+  for (auto i = std::size_t{0}; i < fds.size(); i++) {
+    scratch[i] = Process::isOverwritten(fds, i) ?
+        ::fcntl(fds[i].second, F_DUPFD_CLOEXEC, lowest) :
+        fds[i].second;
+    if (scratch[i] < 0) {
+      return -1;
     }
   }
-  if constexpr (std::is_same_v<Return, void>) {
-    return;
-  } else { //! std::is_same_v<Return, std::tuple<WriteError, std::size_t>>
-    return { WriteError::NO_ERROR, bytesWritten, };
+  for (auto i = std::size_t{0}; i < fds.size(); i++) {
+    const auto target = fds[i].first;
+    //! dup2() does nothing if the file descriptors are equal ->
+    //!     clear FD_CLOEXEC to inherit the file descriptor
+    const auto ret = scratch[i] == target ?
+        ::fcntl(target, F_SETFD, 0) : ::dup2(scratch[i], target);
+    if (ret < 0) {
+      return -1;
+    }
   }
+  return 0;
 }
 #endif
 #endif
 
 #ifdef __unix__
 #if __has_include(<unistd.h>)
-template <std::size_t BUFFER_SIZE, class Return>
-inline Return Process::readFrom(const int& pipe) {
-  static_assert(
-      std::is_same_v<Return, std::string> ||
-      std::is_same_v<Return, std::tuple<std::string, ReadError>>
-  );
-  auto oss = std::ostringstream{};
-  ssize_t bytes;
-  do {
-    char buffer[BUFFER_SIZE];
-    static_assert(BUFFER_SIZE > 1, "BUFFER_SIZE needs to have space for '\0'");
-    bytes = ::read(pipe, buffer, BUFFER_SIZE - 1);
-    if (bytes < 0) { //! read failed
-      if constexpr (std::is_same_v<Return, std::string>) {
-        return oss.str();
-      } else { //! std::is_same_v<Return, std::tuple<std::string, ReadError>>
-        return { oss.str(), static_cast<ReadError>(errno), };
-      }
-    }
-    buffer[bytes] = '\0';
-    oss << std::move(buffer);
-  } while (bytes == BUFFER_SIZE - 1);
-  if constexpr (std::is_same_v<Return, std::string>) {
-    return oss.str();
-  } else { //! std::is_same_v<Return, std::tuple<std::string, ReadError>>
-    return { oss.str(), ReadError::NO_ERROR, };
+inline void Process::execute(
+    char* const* argv,
+    char* const* envp,
+    std::span<const std::pair<int, int>> fds,
+    std::span<int> scratch
+) {
+  if (Process::redirect(fds, scratch) == 0) {
+    ::execve(argv[0], argv, envp);
   }
+  //! fail
+  //! @note _exit() is used because exit() would run the handlers of
+  //!     the parent process in the shared memory of vfork()
+  ::_exit(errno);
 }
 #endif
 #endif
 
 #ifdef __unix__
-#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
-template <class Return>
-inline Return Process::waitExitLoop() {
-  static_assert(
-      std::is_same_v<Return, void> ||
-      std::is_same_v<Return, WaitError>
-  );
-  int status;
-  while (true) {
-    auto pid = ::waitpid(this->pid_, &status, WNOHANG);
-    if (pid == 0) {
-      continue;
-    }
-    if (pid == -1) {
-      if constexpr (std::is_same_v<Return, WaitError>) {
-        return static_cast<WaitError>(errno);
-      } else { //! std::is_same_v<Return, void>
-        //! no error handling
-        return;
-      }
-    }
-    if (WIFEXITED(status) == 0) {
-      if (WIFSIGNALED(status) != 0) {
-        this->terminationCode_ = WTERMSIG(status);
-        //! no error handling is needed because the process has been waited
-        //!     even if it was terminated
-      }
-      if (WIFSTOPPED(status) != 0) {
-        this->stopCode_ = WSTOPSIG(status);
-        //! no error handling is needed because the process has been waited
-        //!     even if it was stopped
-      }
-      break;
+#if __has_include(<unistd.h>) && __has_include(<sched.h>) && \
+    __has_include(<sys/mman.h>) && __has_include(<signal.h>)
+inline int Process::cloned(void* arguments) {
+  const auto& cloned = *static_cast<const Cloned*>(arguments);
+  //! the handler table is a copy without CLONE_SIGHAND =>
+  //!     the handlers of the parent are untouched
+  for (auto signal = 1; signal < NSIG; signal++) {
+    struct sigaction action;
+    if (
+        ::sigaction(signal, nullptr, &action) == 0 &&
+        action.sa_handler != SIG_IGN &&
+        action.sa_handler != SIG_DFL
+    ) {
+      action = {};
+      action.sa_handler = SIG_DFL;
+      ::sigaction(signal, &action, nullptr);
     }
-    this->exitCode_ = WEXITSTATUS(status);
-    break;
-  }
-  if constexpr (std::is_same_v<Return, WaitError>) {
-    return WaitError::NO_ERROR;
-  } else { //! std::is_same_v<Return, void>
-    return;
   }
+  ::sigprocmask(SIG_SETMASK, cloned.mask, nullptr);
+  Process::execute(cloned.argv, cloned.envp, cloned.fds, cloned.scratch);
 }
 #endif
 #endif
@@ -843,7 +3907,16 @@ constexpr void Process::swap(Process&& other) {
   std::swap(this->stdinPipe_, other.stdinPipe_);
   std::swap(this->stdoutPipe_, other.stdoutPipe_);
   std::swap(this->stderrPipe_, other.stderrPipe_);
+  std::swap(this->pidfd_, other.pidfd_);
   std::swap(this->exitCode_, other.exitCode_);
+  std::swap(this->terminationCode_, other.terminationCode_);
+  std::swap(this->stopCode_, other.stopCode_);
+#ifdef __unix__
+#if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<sys/resource.h>)
+  std::swap(this->resourceUsage_, other.resourceUsage_);
+#endif
+#endif
 }
 
 } /// namespace cu0
@@ -0,0 +1,576 @@
+#ifndef CU0_PROCESS_REACTOR_HH_
+#define CU0_PROCESS_REACTOR_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/process.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/epoll.h>)
+#warning <sys/epoll.h> is not found => \
+    cu0::ProcessReactor will not be supported
+#else
+#include <sys/epoll.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::ProcessReactor will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+/*!
+ * @brief The ProcessReactor struct multiplexes stdio and exits of
+ *     many processes on one thread using a single epoll set
+ * @note registered pipes are switched to the non-blocking mode ->
+ *     Process::stdout() and Process::stderr() may return ReadError::AGAIN
+ * @note one read buffer is shared by all the registered processes ->
+ *     memory usage does not depend on the amount of output
+ * @see ProcessReactor::add()
+ * @see ProcessReactor::run()
+ */
+struct ProcessReactor {
+public:
+  enum struct CreateError {
+    NO_ERROR = 0, //! no error
+    INVAL = EINVAL, //! @see EINVAL
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NOMEM = ENOMEM, //! @see ENOMEM
+  };
+  enum struct AddError {
+    NO_ERROR = 0, //! no error
+    BADF = EBADF, //! @see EBADF @note also if the exit cannot be detected
+    EXIST = EEXIST, //! @see EEXIST
+    INVAL = EINVAL, //! @see EINVAL
+    NOMEM = ENOMEM, //! @see ENOMEM
+    NOSPC = ENOSPC, //! @see ENOSPC
+    PERM = EPERM, //! @see EPERM
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::epoll_ctl()
+  };
+  enum struct RunError {
+    NO_ERROR = 0, //! no error
+    BADF = EBADF, //! @see EBADF
+    FAULT = EFAULT, //! @see EFAULT
+    INTR = EINTR, //! @see EINTR
+    INVAL = EINVAL, //! @see EINVAL
+  };
+  /*!
+   * @brief The Handlers struct contains callbacks of a registered process
+   * @note an empty callback is not called
+   */
+  struct Handlers {
+    //! called with a chunk of stdout data
+    //! @note the chunk is valid only during the call
+    std::function<void(Process&, std::span<const std::byte>)> onStdout{};
+    //! called with a chunk of stderr data
+    //! @note the chunk is valid only during the call
+    std::function<void(Process&, std::span<const std::byte>)> onStderr{};
+    //! called when stdin can be written without blocking
+    //! @note stdin is watched until the callback returns false
+    //! @note if empty -> stdin is not watched
+    std::function<bool(Process&)> onStdinWritable{};
+    //! called after the process has exited, has been waited and
+    //!     its stdout and stderr have ended
+    //! @note a descendant keeping stdout or stderr opened delays the call
+    //! @note the process is not referenced by the reactor anymore
+    std::function<void(Process&)> onExit{};
+  };
+  /*!
+   * @brief creates a reactor
+   * @param bufferSize is the size of the buffer shared by all reads
+   * @return
+   *     if there were no errors -> created reactor
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<ProcessReactor, CreateError> create(
+      const std::size_t& bufferSize = Process::READ_SIZE
+  );
+  ProcessReactor(const ProcessReactor& other) = delete;
+  ProcessReactor& operator =(const ProcessReactor& other) = delete;
+  /*!
+   * @brief moves the specified reactor resources to this reactor
+   * @param other is the reactor to be moved
+   */
+  ProcessReactor(ProcessReactor&& other);
+  /*!
+   * @brief moves the specified reactor resources to this reactor
+   * @param other is the reactor to be moved
+   * @return this reactor as mutable reference
+   */
+  ProcessReactor& operator =(ProcessReactor&& other);
+  /*!
+   * @brief destructs an instance
+   * @note registered processes are neither waited nor signalled
+   */
+  virtual ~ProcessReactor();
+  /*!
+   * @brief registers the specified process
+   * @note the process must be neither moved nor destructed until
+   *     it is removed or its exit is dispatched
+   * @note if the process file descriptor is not present ->
+   *     the exit is detected by the end of both stdout and stderr
+   *     followed by waitpid(WNOHANG) repeated every
+   *     ProcessReactor::UNREAPED_PERIOD_ milliseconds
+   *     @note if neither of them is a pipe either -> AddError::BADF is
+   *         returned => the process has to be waited by the caller
+   * @param process is the process to be registered
+   * @param handlers are the callbacks of the process
+   * @return error code @see AddError
+   */
+  AddError add(Process& process, Handlers handlers);
+  /*!
+   * @brief deregisters the specified process
+   * @note the process is not waited
+   * @param process is the process to be deregistered
+   */
+  void remove(Process& process);
+  /*!
+   * @brief waits for events and dispatches them
+   * @param timeout is the maximal time to wait in milliseconds (-1 is infinite)
+   * @return tuple containing
+   *     the number of dispatched events
+   *     error code @see RunError
+   */
+  std::tuple<std::size_t, RunError> runOnce(const int& timeout = -1);
+  /*!
+   * @brief dispatches events until no processes are registered
+   * @return error code @see RunError
+   */
+  RunError run();
+  /*!
+   * @brief accesses the number of registered processes
+   * @return number of registered processes
+   */
+  std::size_t size() const;
+protected:
+  //! kinds of watched file descriptors
+  enum struct Channel {
+    STDIN = 0,
+    STDOUT = 1,
+    STDERR = 2,
+    PIDFD = 3,
+  };
+  struct Entry;
+  /*!
+   * @brief The Watch struct identifies a watched file descriptor
+   */
+  struct Watch {
+    //! registration the file descriptor belongs to
+    Entry* entry = nullptr;
+    //! kind of the file descriptor
+    Channel channel = Channel::STDIN;
+    //! true if the file descriptor is in the epoll set
+    bool watched = false;
+  };
+  /*!
+   * @brief The Entry struct represents a registered process
+   */
+  struct Entry {
+    //! registered process
+    Process* process = nullptr;
+    //! callbacks of the process
+    Handlers handlers{};
+    //! watched file descriptors of the process
+    std::array<Watch, 4> watches{};
+    //! false if the entry has been removed during dispatching
+    bool alive = true;
+    //! true if the process has been waited
+    bool exited = false;
+  };
+  //! maximal number of reads of an output channel when the exit is detected
+  //!     @note the rest is dispatched by the watch of the channel =>
+  //!         a descendant writing into an inherited pipe does not hold
+  //!         the event loop
+  static constexpr std::size_t EXIT_READS_ = 16;
+  //! period in milliseconds of waitpid(WNOHANG) for a process without
+  //!     the process file descriptor whose output has ended before its exit
+  static constexpr int UNREAPED_PERIOD_ = 10;
+  /*!
+   * @brief constructs an instance with the specified epoll file descriptor
+   * @param epoll is the epoll file descriptor
+   * @param bufferSize is the size of the buffer shared by all reads
+   */
+  ProcessReactor(const int& epoll, const std::size_t& bufferSize);
+  /*!
+   * @brief accesses the file descriptor of the specified channel
+   * @param entry is the registration
+   * @param channel is the kind of the file descriptor
+   * @return file descriptor
+   */
+  static int fdOf(const Entry& entry, const Channel& channel);
+  /*!
+   * @brief stops watching the specified channel
+   * @param entry is the registration
+   * @param channel is the kind of the file descriptor
+   */
+  void unwatch(Entry& entry, const Channel& channel);
+  /*!
+   * @brief reads once from the specified output channel and dispatches data
+   * @param entry is the registration
+   * @param channel is Channel::STDOUT or Channel::STDERR
+   * @return false if the channel has no more data available now
+   */
+  bool readOnce(Entry& entry, const Channel& channel);
+  /*!
+   * @brief drains output, waits the process and dispatches its exit
+   * @note never blocks: the process is waited by the process file descriptor
+   *     only after it has become readable, otherwise by waitpid(WNOHANG)
+   * @note if the process has not exited yet -> it is waited again by
+   *     ProcessReactor::reap()
+   * @note if output is left after ProcessReactor::EXIT_READS_ reads ->
+   *     the exit is dispatched after the end of the output
+   * @param entry is the registration
+   */
+  void exit(Entry& entry);
+  /*!
+   * @brief waits the processes whose output has ended before their exit
+   *     and dispatches the exits
+   */
+  void reap();
+  /*!
+   * @brief removes the specified entry
+   * @note the entry is destructed after the dispatching is finished
+   * @param entry is the registration
+   */
+  void erase(Entry& entry);
+  //! epoll file descriptor
+  int epoll_ = -1;
+  //! buffer shared by all reads
+  std::vector<std::byte> buffer_{};
+  //! registered processes
+  std::unordered_map<Process*, std::unique_ptr<Entry>> entries_{};
+  //! entries removed during dispatching
+  std::vector<std::unique_ptr<Entry>> removed_{};
+  //! entries whose output has ended but whose process has not been waited
+  std::vector<Entry*> unreaped_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<unistd.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+inline std::variant<ProcessReactor, ProcessReactor::CreateError>
+ProcessReactor::create(
+    const std::size_t& bufferSize
+) {
+  const auto epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll < 0) {
+    return static_cast<CreateError>(errno);
+  }
+  return ProcessReactor{epoll, bufferSize};
+}
+
+inline ProcessReactor::ProcessReactor(ProcessReactor&& other)
+  : epoll_{other.epoll_}
+  , buffer_{std::move(other.buffer_)}
+  , entries_{std::move(other.entries_)}
+  , removed_{std::move(other.removed_)}
+  , unreaped_{std::move(other.unreaped_)}
+{
+  other.epoll_ = -1;
+}
+
+inline ProcessReactor& ProcessReactor::operator =(ProcessReactor&& other) {
+  if (this != &other) {
+    std::swap(this->epoll_, other.epoll_);
+    std::swap(this->buffer_, other.buffer_);
+    std::swap(this->entries_, other.entries_);
+    std::swap(this->removed_, other.removed_);
+    std::swap(this->unreaped_, other.unreaped_);
+  }
+  return *this;
+}
+
+inline ProcessReactor::~ProcessReactor() {
+  if (this->epoll_ >= 0) {
+    ::close(this->epoll_);
+  }
+}
+
+inline typename ProcessReactor::AddError ProcessReactor::add(
+    Process& process,
+    Handlers handlers
+) {
+  if (this->entries_.contains(&process)) {
+    return AddError::EXIST;
+  }
+  auto entry = std::make_unique<Entry>();
+  entry->process = &process;
+  entry->handlers = std::move(handlers);
+  for (auto i = 0u; i < entry->watches.size(); i++) {
+    entry->watches[i].entry = entry.get();
+    entry->watches[i].channel = static_cast<Channel>(i);
+  }
+  for (auto& watch : entry->watches) {
+    const auto fd = ProcessReactor::fdOf(*entry, watch.channel);
+    if (
+        fd < 0 ||
+        (watch.channel == Channel::STDIN && !entry->handlers.onStdinWritable)
+    ) {
+      continue;
+    }
+    if (watch.channel != Channel::PIDFD) {
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+    auto event = epoll_event{};
+    event.events = watch.channel == Channel::STDIN ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = &watch;
+    if (::epoll_ctl(this->epoll_, EPOLL_CTL_ADD, fd, &event) != 0) {
+      const auto ret = static_cast<AddError>(errno);
+      for (auto& added : entry->watches) {
+        this->unwatch(*entry, added.channel);
+      }
+      return ret;
+    }
+    watch.watched = true;
+  }
+  const auto watched = [&entry](const Channel& channel) {
+    return entry->watches[static_cast<int>(channel)].watched;
+  };
+  if (
+      !watched(Channel::PIDFD) &&
+      !watched(Channel::STDOUT) &&
+      !watched(Channel::STDERR)
+  ) {
+    //! no event would report the exit => ProcessReactor::run() would block
+    this->unwatch(*entry, Channel::STDIN);
+    return AddError::BADF;
+  }
+  this->entries_.emplace(&process, std::move(entry));
+  return AddError::NO_ERROR;
+}
+
+inline void ProcessReactor::remove(Process& process) {
+  const auto it = this->entries_.find(&process);
+  if (it != this->entries_.end()) {
+    this->erase(*it->second);
+  }
+}
+
+inline std::tuple<std::size_t, typename ProcessReactor::RunError>
+ProcessReactor::runOnce(const int& timeout) {
+  std::array<epoll_event, 256> events;
+  //! no event reports the exit of an unreaped process => it is polled
+  const auto wait = this->unreaped_.empty() ? timeout :
+      timeout < 0 ? UNREAPED_PERIOD_ : std::min(timeout, UNREAPED_PERIOD_);
+  const auto count =
+      ::epoll_wait(this->epoll_, events.data(), events.size(), wait);
+  if (count < 0) {
+    return { 0, static_cast<RunError>(errno), };
+  }
+  for (auto i = 0; i < count; i++) {
+    auto& watch = *static_cast<Watch*>(events[i].data.ptr);
+    auto& entry = *watch.entry;
+    if (!entry.alive || !watch.watched) {
+      continue;
+    }
+    switch (watch.channel) {
+    case Channel::STDIN:
+      if (
+          (events[i].events & (EPOLLERR | EPOLLHUP)) != 0 ||
+          !entry.handlers.onStdinWritable(*entry.process)
+      ) {
+        this->unwatch(entry, Channel::STDIN);
+      }
+      break;
+    case Channel::STDOUT:
+    case Channel::STDERR:
+      //! read once per event so that all the processes are served fairly
+      this->readOnce(entry, watch.channel);
+      if (
+          entry.alive &&
+          (entry.exited || entry.process->pidfd() < 0) &&
+          !entry.watches[static_cast<int>(Channel::STDOUT)].watched &&
+          !entry.watches[static_cast<int>(Channel::STDERR)].watched
+      ) {
+        //! the output left after the exit has ended or
+        //!     no process file descriptor -> the end of output means exit
+        this->exit(entry);
+      }
+      break;
+    case Channel::PIDFD:
+      this->exit(entry);
+      break;
+    }
+  }
+  this->reap();
+  this->removed_.clear();
+  return { static_cast<std::size_t>(count), RunError::NO_ERROR, };
+}
+
+inline typename ProcessReactor::RunError ProcessReactor::run() {
+  while (!this->entries_.empty()) {
+    const auto [count, error] = this->runOnce();
+    if (error != RunError::NO_ERROR && error != RunError::INTR) {
+      return error;
+    }
+  }
+  return RunError::NO_ERROR;
+}
+
+inline std::size_t ProcessReactor::size() const {
+  return this->entries_.size();
+}
+
+inline ProcessReactor::ProcessReactor(
+    const int& epoll,
+    const std::size_t& bufferSize
+) : epoll_{epoll}
+  , buffer_(bufferSize)
+{}
+
+inline int ProcessReactor::fdOf(const Entry& entry, const Channel& channel) {
+  switch (channel) {
+  case Channel::STDIN:
+    return entry.process->stdinPipe();
+  case Channel::STDOUT:
+    return entry.process->stdoutPipe();
+  case Channel::STDERR:
+    return entry.process->stderrPipe();
+  case Channel::PIDFD:
+    return entry.process->pidfd();
+  }
+  return -1;
+}
+
+inline void ProcessReactor::unwatch(Entry& entry, const Channel& channel) {
+  auto& watch = entry.watches[static_cast<int>(channel)];
+  if (watch.watched) {
+    ::epoll_ctl(
+        this->epoll_,
+        EPOLL_CTL_DEL,
+        ProcessReactor::fdOf(entry, channel),
+        NULL
+    );
+    watch.watched = false;
+  }
+}
+
+inline bool ProcessReactor::readOnce(Entry& entry, const Channel& channel) {
+  if (!entry.watches[static_cast<int>(channel)].watched) {
+    return false;
+  }
+  const auto bytes = ::read(
+      ProcessReactor::fdOf(entry, channel),
+      this->buffer_.data(),
+      this->buffer_.size()
+  );
+  if (bytes < 0) {
+    if (errno == EINTR) {
+      return true;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      this->unwatch(entry, channel);
+    }
+    return false;
+  }
+  if (bytes == 0) { //! end of file
+    this->unwatch(entry, channel);
+    return false;
+  }
+  const auto& callback = channel == Channel::STDOUT ?
+      entry.handlers.onStdout : entry.handlers.onStderr;
+  if (callback) {
+    callback(
+        *entry.process,
+        std::span<const std::byte>{
+          this->buffer_.data(), static_cast<std::size_t>(bytes)
+        }
+    );
+  }
+  return entry.alive;
+}
+
+inline void ProcessReactor::exit(Entry& entry) {
+  //! the process has exited -> dispatch the output left in the pipes
+  for (
+      auto i = std::size_t{0};
+      i < EXIT_READS_ && this->readOnce(entry, Channel::STDOUT);
+      i++
+  ) {}
+  for (
+      auto i = std::size_t{0};
+      i < EXIT_READS_ && this->readOnce(entry, Channel::STDERR);
+      i++
+  ) {}
+  if (!entry.alive) {
+    return;
+  }
+  auto& process = *entry.process;
+  if (!entry.exited) {
+    this->unwatch(entry, Channel::PIDFD);
+    if (process.pidfd() >= 0) {
+      //! the process file descriptor is readable => the wait does not block
+      process.wait();
+      entry.exited = true;
+    } else if (process.waitStatus(WNOHANG) == 0) {
+      //! the output has ended before the exit
+      this->unreaped_.push_back(&entry);
+      return;
+    } else {
+      entry.exited = true;
+    }
+  }
+  if (
+      entry.watches[static_cast<int>(Channel::STDOUT)].watched ||
+      entry.watches[static_cast<int>(Channel::STDERR)].watched
+  ) {
+    //! the rest of the output is dispatched by the watches
+    return;
+  }
+  auto onExit = std::move(entry.handlers.onExit);
+  this->erase(entry);
+  if (onExit) {
+    onExit(process);
+  }
+}
+
+inline void ProcessReactor::reap() {
+  //! exchanged => the exits dispatched below may add new unreaped entries
+  auto unreaped = std::exchange(this->unreaped_, {});
+  for (auto* entry : unreaped) {
+    if (entry->alive) {
+      this->exit(*entry);
+    }
+  }
+}
+
+inline void ProcessReactor::erase(Entry& entry) {
+  for (const auto& watch : entry.watches) {
+    this->unwatch(entry, watch.channel);
+  }
+  entry.alive = false;
+  std::erase(this->unreaped_, &entry);
+  const auto it = this->entries_.find(entry.process);
+  this->removed_.push_back(std::move(it->second));
+  this->entries_.erase(it);
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_PROCESS_REACTOR_HH_
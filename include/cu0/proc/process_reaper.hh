@@ -0,0 +1,375 @@
+#ifndef CU0_PROCESS_REAPER_HH_
+#define CU0_PROCESS_REAPER_HH_
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+#include <cu0/proc/process.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/epoll.h>)
+#warning <sys/epoll.h> is not found => \
+    cu0::ProcessReaper will not be supported
+#else
+#include <sys/epoll.h>
+#endif
+#if !__has_include(<sys/eventfd.h>)
+#warning <sys/eventfd.h> is not found => \
+    cu0::ProcessReaper will not be supported
+#else
+#include <sys/eventfd.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::ProcessReaper will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<sys/eventfd.h>) && \
+    __has_include(<unistd.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+/*!
+ * @brief The ProcessReaper struct takes ownership of processes and waits for
+ *     all of them on one background thread
+ * @note exits are detected by a single epoll set over process file
+ *     descriptors => every exit costs O(1) regardless of the number of
+ *     adopted processes
+ * @note callbacks are called on the background thread
+ * @see ProcessReaper::adopt()
+ * @see ProcessReaper::global()
+ */
+struct ProcessReaper {
+public:
+  enum struct CreateError {
+    NO_ERROR = 0, //! no error
+    AGAIN = EAGAIN, //! @see EAGAIN
+    INVAL = EINVAL, //! @see EINVAL
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NODEV = ENODEV, //! @see ENODEV
+    NOMEM = ENOMEM, //! @see ENOMEM
+  };
+  enum struct AdoptError {
+    NO_ERROR = 0, //! no error
+    BADF = EBADF, //! the process file descriptor is not present
+    INVAL = EINVAL, //! the reaper has been moved from
+    NOMEM = ENOMEM, //! @see ENOMEM
+    NOSPC = ENOSPC, //! @see ENOSPC
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::epoll_ctl()
+  };
+  //! called after the adopted process has been waited
+  //! @note the process is destructed after the call
+  using Callback = std::function<void(Process&)>;
+  /*!
+   * @brief creates a reaper and starts its background thread
+   * @return
+   *     if there were no errors -> created reaper
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<ProcessReaper, CreateError> create();
+  /*!
+   * @brief accesses the process-wide reaper
+   * @note the reaper is created on the first call
+   * @return
+   *     if the reaper was created -> pointer to the process-wide reaper
+   *     else -> nullptr
+   */
+  static ProcessReaper* global();
+  ProcessReaper(const ProcessReaper& other) = delete;
+  ProcessReaper& operator =(const ProcessReaper& other) = delete;
+  /*!
+   * @brief moves the specified reaper resources to this reaper
+   * @param other is the reaper to be moved
+   */
+  ProcessReaper(ProcessReaper&& other) = default;
+  /*!
+   * @brief moves the specified reaper resources to this reaper
+   * @param other is the reaper to be moved
+   * @return this reaper as mutable reference
+   */
+  ProcessReaper& operator =(ProcessReaper&& other);
+  /*!
+   * @brief destructs an instance
+   * @note the background thread is stopped => processes which have not
+   *     exited yet are destructed without being waited
+   */
+  virtual ~ProcessReaper();
+  /*!
+   * @brief takes ownership of the specified process and waits for it
+   *     in the background
+   * @note thread-safe (can be called from callbacks too)
+   * @param process is the process to be adopted
+   *     @note if an error is returned -> the process is left untouched
+   * @param onExit is called after the process has been waited
+   * @return error code @see AdoptError
+   */
+  AdoptError adopt(Process&& process, Callback onExit = {});
+  /*!
+   * @brief blocks until all the adopted processes have been waited
+   *     and their callbacks have returned
+   * @note must not be called from a callback
+   */
+  void drain();
+  /*!
+   * @brief accesses the number of adopted processes which have not been
+   *     waited yet
+   * @return number of adopted processes
+   */
+  std::size_t size() const;
+protected:
+  /*!
+   * @brief The Entry struct represents an adopted process
+   */
+  struct Entry {
+    //! adopted process
+    Process process;
+    //! callback of the process
+    Callback onExit{};
+  };
+  /*!
+   * @brief The State struct contains the data shared with the background
+   *     thread
+   * @note it is allocated once so that the reaper can be moved
+   */
+  struct State {
+    //! epoll file descriptor
+    int epoll = -1;
+    //! event file descriptor which wakes up the background thread
+    int wakeup = -1;
+    //! guards the fields below
+    std::mutex mutex{};
+    //! notified when no adopted processes are left
+    std::condition_variable drained{};
+    //! adopted processes
+    std::unordered_map<Entry*, std::unique_ptr<Entry>> entries{};
+    //! true if the background thread has to stop
+    bool stopping = false;
+    //! background thread
+    std::thread thread{};
+  };
+  /*!
+   * @brief constructs an instance with the specified state
+   * @param state is the state with opened file descriptors
+   */
+  explicit ProcessReaper(std::unique_ptr<State> state);
+  /*!
+   * @brief waits for exits and dispatches them until the reaper stops
+   * @param state is the state shared with the reaper
+   */
+  static void loop(State& state);
+  /*!
+   * @brief waits the specified process and dispatches its exit
+   * @param state is the state shared with the reaper
+   * @param entry is the exited process
+   */
+  static void reap(State& state, Entry& entry);
+  /*!
+   * @brief stops the background thread and releases the resources
+   */
+  void stop();
+  //! state shared with the background thread
+  std::unique_ptr<State> state_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/epoll.h>) && __has_include(<sys/eventfd.h>) && \
+    __has_include(<unistd.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+inline std::variant<ProcessReaper, ProcessReaper::CreateError>
+ProcessReaper::create() {
+  auto state = std::make_unique<State>();
+  state->epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if (state->epoll < 0) {
+    return static_cast<CreateError>(errno);
+  }
+  state->wakeup = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (state->wakeup < 0) {
+    const auto ret = static_cast<CreateError>(errno);
+    ::close(state->epoll);
+    return ret;
+  }
+  //! the wakeup event is identified by the null pointer
+  auto event = epoll_event{};
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  if (::epoll_ctl(state->epoll, EPOLL_CTL_ADD, state->wakeup, &event) != 0) {
+    const auto ret = static_cast<CreateError>(errno);
+    ::close(state->wakeup);
+    ::close(state->epoll);
+    return ret;
+  }
+  try {
+    state->thread = std::thread{ProcessReaper::loop, std::ref(*state)};
+  } catch (const std::system_error& error) {
+    ::close(state->wakeup);
+    ::close(state->epoll);
+    return static_cast<CreateError>(error.code().value());
+  }
+  return ProcessReaper{std::move(state)};
+}
+
+inline ProcessReaper* ProcessReaper::global() {
+  static auto reaper = ProcessReaper::create();
+  return std::get_if<ProcessReaper>(&reaper);
+}
+
+inline ProcessReaper& ProcessReaper::operator =(ProcessReaper&& other) {
+  if (this != &other) {
+    this->stop();
+    this->state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+inline ProcessReaper::~ProcessReaper() {
+  this->stop();
+}
+
+inline typename ProcessReaper::AdoptError ProcessReaper::adopt(
+    Process&& process,
+    Callback onExit
+) {
+  if (this->state_ == nullptr) {
+    return AdoptError::INVAL;
+  }
+  if (process.pidfd() < 0) {
+    return AdoptError::BADF;
+  }
+  auto& state = *this->state_;
+  auto entry = std::make_unique<Entry>(
+      Entry{ std::move(process), std::move(onExit), }
+  );
+  auto event = epoll_event{};
+  event.events = EPOLLIN;
+  event.data.ptr = entry.get();
+  const auto lock = std::lock_guard{state.mutex};
+  //! the entry is stored before the event can be dispatched
+  const auto [it, inserted] = state.entries.emplace(entry.get(), nullptr);
+  it->second = std::move(entry);
+  if (
+      ::epoll_ctl(
+          state.epoll, EPOLL_CTL_ADD, it->second->process.pidfd(), &event
+      ) != 0
+  ) {
+    const auto ret = static_cast<AdoptError>(errno);
+    process = std::move(it->second->process);
+    state.entries.erase(it);
+    return ret;
+  }
+  return AdoptError::NO_ERROR;
+}
+
+inline void ProcessReaper::drain() {
+  if (this->state_ == nullptr) {
+    return;
+  }
+  auto& state = *this->state_;
+  auto lock = std::unique_lock{state.mutex};
+  state.drained.wait(lock, [&state]() { return state.entries.empty(); });
+}
+
+inline std::size_t ProcessReaper::size() const {
+  if (this->state_ == nullptr) {
+    return 0;
+  }
+  const auto lock = std::lock_guard{this->state_->mutex};
+  return this->state_->entries.size();
+}
+
+inline ProcessReaper::ProcessReaper(std::unique_ptr<State> state)
+  : state_{std::move(state)}
+{}
+
+inline void ProcessReaper::loop(State& state) {
+  std::array<epoll_event, 256> events;
+  while (true) {
+    const auto count =
+        ::epoll_wait(state.epoll, events.data(), events.size(), -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    for (auto i = 0; i < count; i++) {
+      if (events[i].data.ptr == nullptr) { //! woken up by ProcessReaper::stop()
+        std::uint64_t value;
+        [[maybe_unused]] const auto bytes =
+            ::read(state.wakeup, &value, sizeof(value));
+        const auto lock = std::lock_guard{state.mutex};
+        if (state.stopping) {
+          return;
+        }
+        continue;
+      }
+      ProcessReaper::reap(state, *static_cast<Entry*>(events[i].data.ptr));
+    }
+  }
+}
+
+inline void ProcessReaper::reap(State& state, Entry& entry) {
+  ::epoll_ctl(state.epoll, EPOLL_CTL_DEL, entry.process.pidfd(), NULL);
+  //! the process has exited => the wait does not block
+  entry.process.waitCautious();
+  if (entry.onExit) {
+    entry.onExit(entry.process);
+  }
+  auto released = std::unique_ptr<Entry>{};
+  {
+    const auto lock = std::lock_guard{state.mutex};
+    const auto it = state.entries.find(&entry);
+    released = std::move(it->second);
+    state.entries.erase(it);
+    if (state.entries.empty()) {
+      state.drained.notify_all();
+    }
+  }
+  //! the process is destructed outside of the lock
+}
+
+inline void ProcessReaper::stop() {
+  if (!this->state_) {
+    return;
+  }
+  auto& state = *this->state_;
+  {
+    const auto lock = std::lock_guard{state.mutex};
+    state.stopping = true;
+  }
+  const auto value = std::uint64_t{1};
+  [[maybe_unused]] const auto bytes =
+      ::write(state.wakeup, &value, sizeof(value));
+  if (state.thread.joinable()) {
+    state.thread.join();
+  }
+  ::close(state.wakeup);
+  ::close(state.epoll);
+  this->state_.reset();
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_PROCESS_REAPER_HH_
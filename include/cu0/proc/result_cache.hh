@@ -0,0 +1,805 @@
+#ifndef CU0_RESULT_CACHE_HH_
+#define CU0_RESULT_CACHE_HH_
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::ResultCache will not be supported
+#else
+#include <fcntl.h>
+#endif
+#if !__has_include(<sys/mman.h>)
+#warning <sys/mman.h> is not found => \
+    cu0::ResultCache will not be supported
+#else
+#include <sys/mman.h>
+#endif
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::ResultCache will not be supported
+#else
+#include <sys/stat.h>
+#endif
+#if !__has_include(<sys/uio.h>) || !__has_include(<unistd.h>)
+#warning <sys/uio.h> or <unistd.h> is not found => \
+    cu0::ResultCache will not be supported
+#else
+#include <unistd.h>
+#endif
+#if !__has_include(<poll.h>) || !__has_include(<signal.h>)
+#warning <poll.h> or <signal.h> is not found => \
+    cu0::ResultCache will not be supported
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::ResultCache will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<poll.h>) && \
+    __has_include(<signal.h>)
+/*!
+ * @brief The ResultCache struct provides an on-disk cache of results of
+ *     deterministic executables => a repeated execution is a file lookup
+ *     instead of a process
+ * @note a result is addressed by SHA-256 of the contents and the path of
+ *     the binary, the arguments, the environment and the stdin of
+ *     the execution
+ *     @note the current directory and files read by the process are not
+ *         part of the key => the cache is only for executables whose
+ *         output depends on the key alone
+ * @note a result is one file "<directory>/<2 hex digits>/<62 hex digits>"
+ *     written to a temporary file and renamed => concurrent processes
+ *     sharing the directory see either no result or a complete one
+ * @note a found result is mapped (mmap()) => it is not copied
+ * @note usage:
+ *     ResultCache::open() -> ResultCache::run() ...
+ *     or
+ *     ResultCache::keyOf() -> ResultCache::find() or ResultCache::store()
+ */
+struct ResultCache {
+public:
+  //! SHA-256 digest
+  using Key = std::array<std::byte, 32>;
+  enum struct OpenError {
+    NO_ERROR = 0, //! no error
+    ACCES = EACCES, //! @see EACCES
+    NOSPC = ENOSPC, //! @see ENOSPC
+    NOTDIR = ENOTDIR, //! @see ENOTDIR
+    ROFS = EROFS, //! @see EROFS
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::mkdir()
+  };
+  enum struct StoreError {
+    NO_ERROR = 0, //! no error
+    ACCES = EACCES, //! @see EACCES
+    DQUOT = EDQUOT, //! @see EDQUOT
+    NOSPC = ENOSPC, //! @see ENOSPC
+    ROFS = EROFS, //! @see EROFS
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::mkostemp(), ::writev() and
+    //!     @see ::rename()
+  };
+  /*!
+   * @brief The Record struct contains a result of an execution
+   */
+  struct Record {
+  public:
+    friend struct ResultCache;
+    Record(const Record& other) = delete;
+    Record& operator =(const Record& other) = delete;
+    /*!
+     * @brief moves the specified record resources to this record
+     * @param other is the record to be moved
+     */
+    Record(Record&& other);
+    /*!
+     * @brief moves the specified record resources to this record
+     * @param other is the record to be moved
+     * @return this record as mutable reference
+     */
+    Record& operator =(Record&& other);
+    /*!
+     * @brief destructs an instance
+     * @note the mapped file is unmapped
+     */
+    virtual ~Record();
+    /*!
+     * @brief accesses the exit status code
+     * @return exit status code @see Process::exitCode()
+     *     @note empty if the process has been terminated by a signal
+     */
+    const std::optional<int>& exitCode() const;
+    /*!
+     * @brief accesses the stdout
+     * @return stdout @note valid while this record exists
+     */
+    std::string_view out() const;
+    /*!
+     * @brief accesses the stderr
+     * @return stderr @note valid while this record exists
+     */
+    std::string_view err() const;
+    /*!
+     * @brief checks whether this record has been read from the cache
+     * @return true if this record is a mapped file of the cache
+     */
+    bool cached() const;
+  protected:
+    /*!
+     * @brief constructs an empty instance
+     */
+    Record() = default;
+    /*!
+     * @brief accesses the beginning of the stdout followed by the stderr
+     * @return pointer to the data
+     */
+    const char* data() const;
+    //! mapped file @note nullptr if the data are owned
+    void* mapping_ = nullptr;
+    //! size of the mapped file
+    std::size_t mappingSize_ = 0;
+    //! stdout followed by the stderr if not mapped
+    std::string owned_{};
+    //! exit status code
+    std::optional<int> exitCode_{};
+    //! size of the stdout
+    std::size_t outSize_ = 0;
+    //! size of the stderr
+    std::size_t errSize_ = 0;
+  private:
+  };
+  /*!
+   * @brief opens a cache in the specified directory
+   * @note the directory is created if it does not exist
+   * @param directory is the directory of the cache
+   * @return
+   *     if there were no errors -> opened cache
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<ResultCache, OpenError> open(
+      const std::filesystem::path& directory
+  );
+  /*!
+   * @brief computes SHA-256 of the specified data
+   * @param data are the data
+   * @return digest
+   */
+  static Key digestOf(std::string_view data);
+  /*!
+   * @brief converts the specified key to lower-case hexadecimal digits
+   * @param key is the key
+   * @return 64 hexadecimal digits
+   */
+  static std::string hexOf(const Key& key);
+  ResultCache(const ResultCache& other) = delete;
+  ResultCache& operator =(const ResultCache& other) = delete;
+  /*!
+   * @brief moves the specified cache resources to this cache
+   * @param other is the cache to be moved
+   */
+  ResultCache(ResultCache&& other) = default;
+  /*!
+   * @brief moves the specified cache resources to this cache
+   * @param other is the cache to be moved
+   * @return this cache as mutable reference
+   */
+  ResultCache& operator =(ResultCache&& other);
+  /*!
+   * @brief destructs an instance
+   */
+  virtual ~ResultCache() = default;
+  /*!
+   * @brief computes the key of an execution
+   * @note thread-safe
+   * @note digests of binaries are remembered by their path, device, inode,
+   *     size and modification time => a binary is read once while it is
+   *     not modified
+   * @param executable is the executable
+   * @param input is the stdin of the execution
+   * @return
+   *     if the binary has been read -> key
+   *     else -> empty optional
+   */
+  std::optional<Key> keyOf(
+      const Executable& executable,
+      std::string_view input = {}
+  ) const;
+  /*!
+   * @brief finds the result of the specified key
+   * @note thread-safe
+   * @param key is the key @see ResultCache::keyOf()
+   * @return
+   *     if a valid result is stored -> record of the result
+   *     else -> empty optional
+   */
+  std::optional<Record> find(const Key& key) const;
+  /*!
+   * @brief stores the specified result
+   * @note thread-safe, an existing result is replaced
+   * @param key is the key @see ResultCache::keyOf()
+   * @param exitCode is the exit status code
+   * @param out is the stdout
+   * @param err is the stderr
+   * @return error code @see StoreError
+   */
+  StoreError store(
+      const Key& key,
+      const int& exitCode,
+      std::string_view out,
+      std::string_view err
+  ) const;
+  /*!
+   * @brief returns the stored result of the specified execution or
+   *     executes it and stores its result
+   * @note thread-safe
+   * @note a process terminated by a signal is not stored
+   * @note if the binary cannot be read -> the executable is executed
+   *     without the cache
+   * @note if the result cannot be stored -> it is returned anyway
+   * @param executable is the executable
+   * @param input is the stdin of the execution
+   * @return
+   *     if there were no errors -> record of the result
+   *         @see ResultCache::Record::cached()
+   *     if there was an error -> error code @see Process::create()
+   */
+  [[nodiscard]] std::variant<Record, Process::CreateError> run(
+      const Executable& executable,
+      std::string_view input = {}
+  ) const;
+  /*!
+   * @brief accesses the directory of the cache
+   * @return directory of the cache
+   */
+  const std::filesystem::path& directory() const;
+protected:
+  //! identifies a stored result and the version of its layout
+  static constexpr char MAGIC_[8] = {
+    'c', 'u', '0', 'r', 'e', 's', '2', '\n',
+  };
+  /*!
+   * @brief The Header struct precedes the stdout and the stderr in a file
+   * @note native byte order => a cache is not portable between platforms
+   */
+  struct Header {
+    //! @see ResultCache::MAGIC_
+    char magic[sizeof(MAGIC_)];
+    //! exit status code
+    std::int64_t exitCode;
+    //! size of the stdout
+    std::uint64_t outSize;
+    //! size of the stderr
+    std::uint64_t errSize;
+  };
+  /*!
+   * @brief The Binary struct identifies a version of a binary
+   */
+  struct Binary {
+    //! @see stat::st_dev
+    dev_t device = 0;
+    //! @see stat::st_ino
+    ino_t inode = 0;
+    //! @see stat::st_size
+    off_t size = 0;
+    //! @see stat::st_mtim
+    timespec modified{};
+    //! digest of the contents
+    Key digest{};
+  };
+  /*!
+   * @brief The State struct contains the directory and the remembered
+   *     digests of binaries
+   * @note kept in memory at a stable address => the cache is movable
+   */
+  struct State {
+    //! directory of the cache
+    std::filesystem::path directory{};
+    //! held while the binaries are accessed
+    std::mutex mutex{};
+    //! remembered binaries by their paths
+    std::map<std::filesystem::path, Binary> binaries{};
+  };
+  /*!
+   * @brief The Sha256 struct computes SHA-256 of data passed in parts
+   */
+  struct Sha256 {
+    /*!
+     * @brief passes the specified part of the data
+     * @param data is the part of the data
+     */
+    void update(std::span<const std::byte> data);
+    /*!
+     * @brief passes the size of the specified value and the value
+     * @note values are separated => ("ab", "c") and ("a", "bc") differ
+     * @param value is the value
+     */
+    void updateSized(std::string_view value);
+    /*!
+     * @brief finishes the computation
+     * @return digest of the passed data
+     */
+    Key finish();
+    /*!
+     * @brief processes the buffered block
+     */
+    void compress();
+    //! intermediate hash value
+    std::array<std::uint32_t, 8> state{
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    //! block being filled
+    std::array<std::uint8_t, 64> block{};
+    //! number of bytes in the block
+    std::size_t used = 0;
+    //! number of passed bytes
+    std::uint64_t length = 0;
+  };
+  /*!
+   * @brief constructs an instance with the specified state
+   * @param state is the state of the cache
+   */
+  explicit ResultCache(std::unique_ptr<State> state);
+  /*!
+   * @brief computes the digest of the contents of the specified binary
+   * @param binary is the path to the binary
+   * @return
+   *     if the binary has been read -> digest
+   *     else -> empty optional
+   */
+  std::optional<Key> digestOfBinary(const std::filesystem::path& binary) const;
+  /*!
+   * @brief accesses the path of the file of the specified key
+   * @param key is the key
+   * @return path of the file
+   */
+  std::filesystem::path pathOf(const Key& key) const;
+  //! state of the cache
+  std::unique_ptr<State> state_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<poll.h>) && \
+    __has_include(<signal.h>)
+inline ResultCache::Record::Record(Record&& other) {
+  *this = std::move(other);
+}
+
+inline ResultCache::Record& ResultCache::Record::operator =(Record&& other) {
+  std::swap(this->mapping_, other.mapping_);
+  std::swap(this->mappingSize_, other.mappingSize_);
+  std::swap(this->owned_, other.owned_);
+  std::swap(this->exitCode_, other.exitCode_);
+  std::swap(this->outSize_, other.outSize_);
+  std::swap(this->errSize_, other.errSize_);
+  return *this;
+}
+
+inline ResultCache::Record::~Record() {
+  if (this->mapping_ != nullptr) {
+    ::munmap(this->mapping_, this->mappingSize_);
+  }
+}
+
+inline const std::optional<int>& ResultCache::Record::exitCode() const {
+  return this->exitCode_;
+}
+
+inline std::string_view ResultCache::Record::out() const {
+  return { this->data(), this->outSize_, };
+}
+
+inline std::string_view ResultCache::Record::err() const {
+  return { this->data() + this->outSize_, this->errSize_, };
+}
+
+inline bool ResultCache::Record::cached() const {
+  return this->mapping_ != nullptr;
+}
+
+inline const char* ResultCache::Record::data() const {
+  if (this->mapping_ == nullptr) {
+    return this->owned_.data();
+  }
+  return static_cast<const char*>(this->mapping_) + sizeof(Header);
+}
+
+inline std::variant<ResultCache, ResultCache::OpenError> ResultCache::open(
+    const std::filesystem::path& directory
+) {
+  auto error = std::error_code{};
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    return static_cast<OpenError>(error.value());
+  }
+  if (!std::filesystem::is_directory(directory, error)) {
+    return OpenError::NOTDIR;
+  }
+  auto state = std::make_unique<State>();
+  state->directory = directory;
+  return ResultCache{std::move(state)};
+}
+
+inline ResultCache::Key ResultCache::digestOf(std::string_view data) {
+  auto sha256 = Sha256{};
+  sha256.update(std::as_bytes(std::span{data}));
+  return sha256.finish();
+}
+
+inline std::string ResultCache::hexOf(const Key& key) {
+  constexpr auto DIGITS = std::string_view{"0123456789abcdef"};
+  auto ret = std::string(key.size() * 2, '0');
+  for (auto i = std::size_t{0}; i < key.size(); i++) {
+    const auto byte = std::to_integer<unsigned>(key[i]);
+    ret[2 * i] = DIGITS[byte >> 4];
+    ret[2 * i + 1] = DIGITS[byte & 0xf];
+  }
+  return ret;
+}
+
+inline ResultCache& ResultCache::operator =(ResultCache&& other) {
+  std::swap(this->state_, other.state_);
+  return *this;
+}
+
+inline std::optional<ResultCache::Key> ResultCache::keyOf(
+    const Executable& executable,
+    std::string_view input
+) const {
+  const auto binary = this->digestOfBinary(executable.binary);
+  if (!binary.has_value()) {
+    return std::nullopt;
+  }
+  auto sha256 = Sha256{};
+  sha256.update(*binary);
+  //! multi-call binaries (e.g. hard links of busybox) differ by argv[0]
+  sha256.updateSized(executable.binary.string());
+  for (const auto& argument : executable.arguments) {
+    sha256.updateSized(argument);
+  }
+  //! the number of arguments separates them from the environment
+  const auto count = static_cast<std::uint64_t>(executable.arguments.size());
+  sha256.update(std::as_bytes(std::span{&count, 1}));
+  for (const auto& [key, value] : executable.environment) {
+    sha256.updateSized(key);
+    sha256.updateSized(value);
+  }
+  const auto variables =
+      static_cast<std::uint64_t>(executable.environment.size());
+  sha256.update(std::as_bytes(std::span{&variables, 1}));
+  sha256.updateSized(input);
+  return sha256.finish();
+}
+
+inline std::optional<ResultCache::Record> ResultCache::find(
+    const Key& key
+) const {
+  const auto fd = ::open(this->pathOf(key).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat status;
+  if (
+      ::fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < sizeof(Header)
+  ) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  const auto size = static_cast<std::size_t>(status.st_size);
+  auto* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  //! the mapping keeps the file => the file descriptor is not needed
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+  auto record = Record{};
+  record.mapping_ = mapping;
+  record.mappingSize_ = size;
+  auto header = Header{};
+  std::memcpy(&header, mapping, sizeof(header));
+  //! a file of another layout or truncated by a crash is a miss
+  if (
+      std::memcmp(header.magic, MAGIC_, sizeof(MAGIC_)) != 0 ||
+      header.outSize > size - sizeof(Header) ||
+      header.errSize != size - sizeof(Header) - header.outSize
+  ) {
+    return std::nullopt;
+  }
+  record.exitCode_ = static_cast<int>(header.exitCode);
+  record.outSize_ = static_cast<std::size_t>(header.outSize);
+  record.errSize_ = static_cast<std::size_t>(header.errSize);
+  return record;
+}
+
+inline ResultCache::StoreError ResultCache::store(
+    const Key& key,
+    const int& exitCode,
+    std::string_view out,
+    std::string_view err
+) const {
+  const auto path = this->pathOf(key);
+  if (::mkdir(path.parent_path().c_str(), 0777) != 0 && errno != EEXIST) {
+    return static_cast<StoreError>(errno);
+  }
+  auto temporary = (path.parent_path() / ("." + path.filename().string() +
+      ".XXXXXX")).string();
+  const auto fd = ::mkostemp(temporary.data(), O_CLOEXEC);
+  if (fd < 0) {
+    return static_cast<StoreError>(errno);
+  }
+  auto header = Header{
+    .magic = {},
+    .exitCode = exitCode,
+    .outSize = out.size(),
+    .errSize = err.size(),
+  };
+  std::memcpy(header.magic, MAGIC_, sizeof(MAGIC_));
+  const std::string_view parts[3] = {
+    { reinterpret_cast<const char*>(&header), sizeof(header), },
+    out,
+    err,
+  };
+  auto [ret, _] = Process::writeVectorInto<
+      std::tuple<Process::WriteError, std::size_t>
+  >(fd, parts);
+  ::close(fd);
+  if (ret == Process::WriteError::NO_ERROR) {
+    //! atomic => readers see either the previous file or this one
+    if (::rename(temporary.c_str(), path.c_str()) == 0) {
+      return StoreError::NO_ERROR;
+    }
+    ret = static_cast<Process::WriteError>(errno);
+  }
+  ::unlink(temporary.c_str());
+  return static_cast<StoreError>(ret);
+}
+
+inline std::variant<ResultCache::Record, Process::CreateError>
+ResultCache::run(
+    const Executable& executable,
+    std::string_view input
+) const {
+  const auto key = this->keyOf(executable, input);
+  if (key.has_value()) {
+    if (auto found = this->find(*key); found.has_value()) {
+      return *std::move(found);
+    }
+  }
+  auto created = Process::create(executable, Stdio{});
+  if (std::holds_alternative<Process::CreateError>(created)) {
+    return std::get<Process::CreateError>(created);
+  }
+  auto& process = std::get<Process>(created);
+  auto [out, err, writeError, readError] = process.communicateCautious(input);
+  process.wait();
+  if (
+      key.has_value() &&
+      process.exitCode().has_value() &&
+      writeError == Process::WriteError::NO_ERROR &&
+      readError == Process::ReadError::NO_ERROR
+  ) {
+    static_cast<void>(
+        this->store(*key, *process.exitCode(), out, err)
+    );
+  }
+  auto record = Record{};
+  record.exitCode_ = process.exitCode();
+  record.outSize_ = out.size();
+  record.errSize_ = err.size();
+  record.owned_ = std::move(out);
+  record.owned_ += err;
+  return record;
+}
+
+inline const std::filesystem::path& ResultCache::directory() const {
+  return this->state_->directory;
+}
+
+inline ResultCache::ResultCache(std::unique_ptr<State> state)
+  : state_{std::move(state)}
+{}
+
+inline std::optional<ResultCache::Key> ResultCache::digestOfBinary(
+    const std::filesystem::path& binary
+) const {
+  const auto fd = ::open(binary.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  const auto same = [&status](const Binary& remembered) {
+    return remembered.device == status.st_dev &&
+        remembered.inode == status.st_ino &&
+        remembered.size == status.st_size &&
+        remembered.modified.tv_sec == status.st_mtim.tv_sec &&
+        remembered.modified.tv_nsec == status.st_mtim.tv_nsec;
+  };
+  {
+    const auto lock = std::lock_guard{this->state_->mutex};
+    const auto it = this->state_->binaries.find(binary);
+    if (it != this->state_->binaries.end() && same(it->second)) {
+      ::close(fd);
+      return it->second.digest;
+    }
+  }
+  auto sha256 = Sha256{};
+  auto buffer = std::array<std::byte, 65536>{};
+  while (true) {
+    const auto bytes = ::read(fd, buffer.data(), buffer.size());
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ::close(fd);
+      return std::nullopt;
+    }
+    if (bytes == 0) { //! end of file
+      break;
+    }
+    sha256.update(
+        std::span{buffer.data(), static_cast<std::size_t>(bytes)}
+    );
+  }
+  ::close(fd);
+  const auto remembered = Binary{
+    .device = status.st_dev,
+    .inode = status.st_ino,
+    .size = status.st_size,
+    .modified = status.st_mtim,
+    .digest = sha256.finish(),
+  };
+  const auto lock = std::lock_guard{this->state_->mutex};
+  this->state_->binaries.insert_or_assign(binary, remembered);
+  return remembered.digest;
+}
+
+inline std::filesystem::path ResultCache::pathOf(const Key& key) const {
+  const auto hex = ResultCache::hexOf(key);
+  return this->state_->directory / hex.substr(0, 2) / hex.substr(2);
+}
+
+inline void ResultCache::Sha256::update(std::span<const std::byte> data) {
+  this->length += data.size();
+  for (const auto& byte : data) {
+    this->block[this->used++] = std::to_integer<std::uint8_t>(byte);
+    if (this->used == this->block.size()) {
+      this->compress();
+    }
+  }
+}
+
+inline void ResultCache::Sha256::updateSized(std::string_view value) {
+  const auto size = static_cast<std::uint64_t>(value.size());
+  this->update(std::as_bytes(std::span{&size, 1}));
+  this->update(std::as_bytes(std::span{value}));
+}
+
+inline ResultCache::Key ResultCache::Sha256::finish() {
+  const auto bits = this->length * 8;
+  this->block[this->used++] = 0x80;
+  if (this->used > 56) {
+    std::fill(this->block.begin() + this->used, this->block.end(), 0);
+    this->used = this->block.size();
+    this->compress();
+  }
+  std::fill(this->block.begin() + this->used, this->block.begin() + 56, 0);
+  for (auto i = 0; i < 8; i++) { //! big-endian length in bits
+    this->block[63 - i] = static_cast<std::uint8_t>(bits >> (8 * i));
+  }
+  this->compress();
+  auto ret = Key{};
+  for (auto i = std::size_t{0}; i < this->state.size(); i++) {
+    for (auto j = 0; j < 4; j++) {
+      ret[4 * i + j] =
+          static_cast<std::byte>(this->state[i] >> (24 - 8 * j));
+    }
+  }
+  return ret;
+}
+
+inline void ResultCache::Sha256::compress() {
+  static constexpr std::uint32_t ROUNDS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+  };
+  std::uint32_t words[64];
+  for (auto i = 0; i < 16; i++) {
+    words[i] = static_cast<std::uint32_t>(this->block[4 * i]) << 24 |
+        static_cast<std::uint32_t>(this->block[4 * i + 1]) << 16 |
+        static_cast<std::uint32_t>(this->block[4 * i + 2]) << 8 |
+        static_cast<std::uint32_t>(this->block[4 * i + 3]);
+  }
+  for (auto i = 16; i < 64; i++) {
+    const auto s0 = std::rotr(words[i - 15], 7) ^
+        std::rotr(words[i - 15], 18) ^ (words[i - 15] >> 3);
+    const auto s1 = std::rotr(words[i - 2], 17) ^
+        std::rotr(words[i - 2], 19) ^ (words[i - 2] >> 10);
+    words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+  }
+  auto [a, b, c, d, e, f, g, h] = this->state;
+  for (auto i = 0; i < 64; i++) {
+    const auto s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+    const auto choice = (e & f) ^ (~e & g);
+    const auto t1 = h + s1 + choice + ROUNDS[i] + words[i];
+    const auto s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+    const auto majority = (a & b) ^ (a & c) ^ (b & c);
+    const auto t2 = s0 + majority;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  const std::uint32_t values[8] = { a, b, c, d, e, f, g, h, };
+  for (auto i = std::size_t{0}; i < this->state.size(); i++) {
+    this->state[i] += values[i];
+  }
+  this->used = 0;
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_RESULT_CACHE_HH_
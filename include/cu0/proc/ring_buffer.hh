@@ -0,0 +1,717 @@
+#ifndef CU0_RING_BUFFER_HH_
+#define CU0_RING_BUFFER_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <fcntl.h>
+#endif
+#if !__has_include(<sys/mman.h>)
+#warning <sys/mman.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <sys/mman.h>
+#endif
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <sys/stat.h>
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <sys/syscall.h>
+#endif
+#if !__has_include(<linux/futex.h>)
+#warning <linux/futex.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <linux/futex.h>
+#endif
+#if !__has_include(<poll.h>)
+#warning <poll.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <poll.h>
+#endif
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::RingBuffer will not be supported
+#else
+#include <unistd.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::RingBuffer will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<linux/futex.h>) && __has_include(<poll.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief The RingBuffer struct provides a single-producer single-consumer
+ *     channel in memory shared by a created process and this process
+ * @note the memory is a memfd => it is passed to the created process as
+ *     an inherited file descriptor @see RingBuffer::share()
+ * @note data are copied by memcpy() only, system calls are made only if
+ *     a side has to sleep (futex) or to wake up the other side
+ * @note usage:
+ *     this process (reader):
+ *         RingBuffer::create() -> RingBuffer::share() -> Process::create()
+ *         -> RingBuffer::readChunks() or RingBuffer::read()
+ *     created process (writer):
+ *         RingBuffer::attach() -> RingBuffer::write() -> RingBuffer::close()
+ */
+struct RingBuffer {
+public:
+  enum struct CreateError {
+    NO_ERROR = 0, //! no error
+    INVAL = EINVAL, //! @see EINVAL
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NOMEM = ENOMEM, //! @see ENOMEM
+    NOSYS = ENOSYS, //! @see ENOSYS
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::memfd_create() and ::mmap()
+  };
+  enum struct AttachError {
+    NO_ERROR = 0, //! no error
+    BADF = EBADF, //! the file descriptor is not present
+    INVAL = EINVAL, //! the file descriptor is not a ring buffer
+    NOMEM = ENOMEM, //! @see ENOMEM
+  };
+  enum struct WriteError {
+    NO_ERROR = 0, //! no error
+    PIPE = EPIPE, //! the reader has been closed or this buffer moved from
+  };
+  enum struct ReadError {
+    NO_ERROR = 0, //! no error
+    //! the writer exited without RingBuffer::close() or this buffer
+    //!     has been moved from
+    PIPE = EPIPE,
+  };
+  //! name of the environment variable containing the file descriptor of
+  //!     the ring buffer in the created process @see RingBuffer::share()
+  static constexpr const char* ENVIRONMENT_VARIABLE = "CU0_RING_BUFFER_FD";
+  /*!
+   * @brief creates a ring buffer to be read by this process
+   * @param capacity is the minimal number of bytes the buffer can hold
+   *     @note it is rounded up to a power of two of at least a page
+   * @return
+   *     if there were no errors -> created ring buffer
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<RingBuffer, CreateError> create(
+      const std::size_t& capacity = std::size_t{1} << 20
+  );
+  /*!
+   * @brief attaches to a ring buffer to be written by this process
+   * @param fd is the file descriptor of the ring buffer
+   *     @note the file descriptor is owned by the attached ring buffer
+   * @return
+   *     if there were no errors -> attached ring buffer
+   *     if there was an error -> error code
+   */
+  [[nodiscard]] static std::variant<RingBuffer, AttachError> attach(
+      const int& fd
+  );
+  /*!
+   * @brief attaches to the ring buffer shared by the parent process
+   * @note the file descriptor is taken from the environment variable
+   *     @see RingBuffer::ENVIRONMENT_VARIABLE
+   * @return @see RingBuffer::attach(const int&)
+   */
+  [[nodiscard]] static std::variant<RingBuffer, AttachError> attach();
+  RingBuffer(const RingBuffer& other) = delete;
+  RingBuffer& operator =(const RingBuffer& other) = delete;
+  /*!
+   * @brief moves the specified ring buffer resources to this ring buffer
+   * @param other is the ring buffer to be moved
+   */
+  RingBuffer(RingBuffer&& other);
+  /*!
+   * @brief moves the specified ring buffer resources to this ring buffer
+   * @param other is the ring buffer to be moved
+   * @return this ring buffer as mutable reference
+   */
+  RingBuffer& operator =(RingBuffer&& other);
+  /*!
+   * @brief destructs an instance
+   * @note the side of this ring buffer is closed @see RingBuffer::close()
+   */
+  virtual ~RingBuffer();
+  /*!
+   * @brief makes the ring buffer available to a process to be created
+   * @note the file descriptor is inherited as the specified file descriptor
+   *     and its number is stored in the environment of the executable
+   * @param executable is the executable to be run by the process
+   * @param stdio are the redirections of the process
+   * @param target is the file descriptor in the created process
+   */
+  void share(
+      Executable& executable,
+      Stdio& stdio,
+      const int& target = 3
+  ) const;
+  /*!
+   * @brief writes the specified data into the ring buffer
+   * @note blocks while the ring buffer is full
+   * @note supported by the writer only
+   * @param data are the data to be written
+   * @return
+   *     if there were no errors -> WriteError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  WriteError write(std::span<const std::byte> data);
+  /*!
+   * @brief writes the specified data into the ring buffer
+   * @see RingBuffer::write(std::span<const std::byte>)
+   */
+  WriteError write(std::string_view data);
+  /*!
+   * @brief reads available data into the specified buffer
+   * @note blocks while the ring buffer is empty
+   * @note supported by the reader only
+   * @param buffer is the buffer to read into
+   * @param pidfd is the process file descriptor of the writer
+   *     @note if present -> the writer exiting without RingBuffer::close()
+   *         is detected
+   * @return tuple containing
+   *     number of read bytes (0 if the writer is closed and all the data
+   *         have been read)
+   *     error code
+   */
+  std::tuple<std::size_t, ReadError> read(
+      std::span<std::byte> buffer,
+      const int& pidfd = -1
+  );
+  /*!
+   * @brief passes available data to the callback chunk by chunk until
+   *     the writer is closed
+   * @note the chunks point into the shared memory => no data are copied
+   * @note supported by the reader only
+   * @tparam Callback is invocable with std::span<const std::byte>
+   *     @note if it returns bool -> false stops reading
+   * @param callback is called with every chunk
+   *     @note the chunk is valid only during the call
+   * @param pidfd @see RingBuffer::read()
+   * @return
+   *     if there were no errors -> ReadError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  template <class Callback>
+  ReadError readChunks(Callback&& callback, const int& pidfd = -1);
+  /*!
+   * @brief closes the side of this ring buffer
+   * @note the writer -> the reader reads the end of file
+   * @note the reader -> the writer gets WriteError::PIPE
+   * @note a moved-from ring buffer is left untouched
+   */
+  void close();
+  /*!
+   * @brief accesses the file descriptor of the ring buffer
+   * @return memfd file descriptor
+   */
+  constexpr const int& fd() const;
+  /*!
+   * @brief accesses the capacity of the ring buffer
+   * @return number of bytes the buffer can hold (0 if moved from)
+   */
+  std::size_t capacity() const;
+protected:
+  /*!
+   * @brief The Header struct is placed at the beginning of the shared memory
+   * @note the counters are accessed by std::atomic_ref => they are plain
+   *     integers with the same layout in both the processes
+   */
+  struct Header {
+    //! identifies the ring buffer @see RingBuffer::MAGIC_
+    std::uint64_t magic;
+    //! number of bytes of data following the header page
+    std::uint64_t capacity;
+    //! total number of written bytes
+    alignas(64) std::uint64_t head;
+    //! total number of read bytes
+    alignas(64) std::uint64_t tail;
+    //! 1 if the reader sleeps waiting for data (futex word)
+    alignas(64) std::uint32_t readerWaiting;
+    //! 1 if the writer sleeps waiting for space (futex word)
+    std::uint32_t writerWaiting;
+    //! 1 if the writer is closed
+    std::uint32_t writerClosed;
+    //! 1 if the reader is closed
+    std::uint32_t readerClosed;
+  };
+  //! "cu0ring" + version
+  static constexpr std::uint64_t MAGIC_ = 0x63753072696e6701;
+  /*!
+   * @brief constructs an instance with the specified mapping
+   * @param fd is the memfd file descriptor
+   * @param memory is the mapped memfd
+   * @param size is the size of the mapping
+   * @param capacity is the number of bytes of data following the header page
+   * @param reader is true for the reader side
+   */
+  RingBuffer(
+      const int& fd,
+      void* memory,
+      const std::size_t& size,
+      const std::size_t& capacity,
+      const bool& reader
+  );
+  /*!
+   * @brief accesses a counter of the header atomically
+   * @tparam T is the type of the counter
+   * @param counter is the counter
+   * @return atomic reference to the counter
+   */
+  template <class T>
+  static std::atomic_ref<T> atomic(T& counter);
+  /*!
+   * @brief waits until the futex word changes from 1 or the timeout expires
+   * @param word is the futex word
+   * @param timeout is the timeout (nullptr to wait infinitely)
+   */
+  static void sleep(std::uint32_t& word, const timespec* timeout);
+  /*!
+   * @brief wakes up the side sleeping on the specified futex word
+   * @param word is the futex word
+   */
+  static void wake(std::uint32_t& word);
+  /*!
+   * @brief waits until data are available or the writer is closed
+   * @param pidfd @see RingBuffer::read()
+   * @return tuple containing
+   *     number of available bytes
+   *     error code
+   */
+  std::tuple<std::size_t, ReadError> waitData(const int& pidfd);
+  /*!
+   * @brief passes available data to the callback chunk by chunk until
+   *     the writer is closed
+   * @tparam Callback @see RingBuffer::readChunks()
+   * @param callback @see RingBuffer::readChunks()
+   * @param pidfd @see RingBuffer::read()
+   * @param limit is the maximal size of a chunk
+   * @return @see RingBuffer::readChunks()
+   */
+  template <class Callback>
+  ReadError readChunksUpTo(
+      Callback&& callback,
+      const int& pidfd,
+      const std::size_t& limit
+  );
+  /*!
+   * @brief accesses the header of the shared memory
+   * @return header as mutable reference
+   */
+  Header& header() const;
+  /*!
+   * @brief accesses the data of the shared memory
+   * @return ptr to the first byte of the data
+   */
+  std::byte* data() const;
+  //! memfd file descriptor
+  int fd_ = -1;
+  //! mapped memfd
+  void* memory_ = nullptr;
+  //! size of the mapping
+  std::size_t size_ = 0;
+  //! number of bytes of data following the header page
+  //!     @note kept out of the shared memory => the other process cannot
+  //!         make offsets of this process point past the mapping
+  std::size_t capacity_ = 0;
+  //! true for the reader side
+  bool reader_ = false;
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+    __has_include(<sys/stat.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<linux/futex.h>) && __has_include(<poll.h>) && \
+    __has_include(<unistd.h>)
+inline std::variant<RingBuffer, RingBuffer::CreateError> RingBuffer::create(
+    const std::size_t& capacity
+) {
+  const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  if (capacity > std::size_t{1} << 40) {
+    return CreateError::INVAL;
+  }
+  //! a power of two => a position is masked instead of divided
+  const auto size = std::bit_ceil(std::max(capacity, page));
+  const auto fd = ::memfd_create("cu0-ring-buffer", MFD_CLOEXEC);
+  if (fd < 0) {
+    return static_cast<CreateError>(errno);
+  }
+  //! the header occupies the first page
+  if (::ftruncate(fd, page + size) != 0) {
+    const auto ret = static_cast<CreateError>(errno);
+    ::close(fd);
+    return ret;
+  }
+  auto* memory = ::mmap(
+      NULL, page + size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0
+  );
+  if (memory == MAP_FAILED) {
+    const auto ret = static_cast<CreateError>(errno);
+    ::close(fd);
+    return ret;
+  }
+  auto& header = *static_cast<Header*>(memory);
+  header.capacity = size;
+  header.magic = MAGIC_;
+  return RingBuffer{fd, memory, page + size, size, true};
+}
+
+inline std::variant<RingBuffer, RingBuffer::AttachError> RingBuffer::attach(
+    const int& fd
+) {
+  struct stat status;
+  if (fd < 0 || ::fstat(fd, &status) != 0) {
+    return AttachError::BADF;
+  }
+  const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const auto size = static_cast<std::size_t>(status.st_size);
+  if (size <= page) {
+    return AttachError::INVAL;
+  }
+  auto* memory = ::mmap(
+      NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0
+  );
+  if (memory == MAP_FAILED) {
+    return errno == ENOMEM ? AttachError::NOMEM : AttachError::INVAL;
+  }
+  const auto& header = *static_cast<const Header*>(memory);
+  if (header.magic != MAGIC_ || page + header.capacity != size) {
+    ::munmap(memory, size);
+    return AttachError::INVAL;
+  }
+  //! the inherited file descriptor is not passed to grandchildren
+  ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  return RingBuffer{fd, memory, size, size - page, false};
+}
+
+inline std::variant<RingBuffer, RingBuffer::AttachError> RingBuffer::attach() {
+  const auto* value = std::getenv(ENVIRONMENT_VARIABLE);
+  if (value == nullptr) {
+    return AttachError::BADF;
+  }
+  char* end = nullptr;
+  const auto fd = std::strtol(value, &end, 10);
+  if (end == value || *end != '\0') {
+    return AttachError::BADF;
+  }
+  return RingBuffer::attach(static_cast<int>(fd));
+}
+
+inline RingBuffer::RingBuffer(RingBuffer&& other)
+  : fd_{std::exchange(other.fd_, -1)},
+    memory_{std::exchange(other.memory_, nullptr)},
+    size_{std::exchange(other.size_, 0)},
+    capacity_{std::exchange(other.capacity_, 0)},
+    reader_{other.reader_}
+{}
+
+inline RingBuffer& RingBuffer::operator =(RingBuffer&& other) {
+  if (this != &other) {
+    std::swap(this->fd_, other.fd_);
+    std::swap(this->memory_, other.memory_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->capacity_, other.capacity_);
+    std::swap(this->reader_, other.reader_);
+  }
+  return *this;
+}
+
+inline RingBuffer::~RingBuffer() {
+  if (this->memory_ != nullptr) {
+    this->close();
+    ::munmap(this->memory_, this->size_);
+  }
+  if (this->fd_ >= 0) {
+    ::close(this->fd_);
+  }
+}
+
+inline void RingBuffer::share(
+    Executable& executable,
+    Stdio& stdio,
+    const int& target
+) const {
+  executable.environment[ENVIRONMENT_VARIABLE] = std::to_string(target);
+  stdio.fds.emplace_back(target, this->fd_);
+}
+
+inline typename RingBuffer::WriteError RingBuffer::write(
+    std::span<const std::byte> data
+) {
+  if (this->memory_ == nullptr) { //! moved from
+    return WriteError::PIPE;
+  }
+  auto& header = this->header();
+  const auto capacity = this->capacity_;
+  auto head = atomic(header.head).load(std::memory_order_relaxed);
+  while (!data.empty()) {
+    auto free = capacity - (head - atomic(header.tail).load());
+    if (free == 0) {
+      //! announce the sleep and check the space again =>
+      //!     the reader either sees the announcement or the space is seen
+      atomic(header.writerWaiting).store(1);
+      free = capacity - (head - atomic(header.tail).load());
+      if (free == 0) {
+        if (atomic(header.readerClosed).load() != 0) {
+          atomic(header.writerWaiting).store(0);
+          return WriteError::PIPE;
+        }
+        RingBuffer::sleep(header.writerWaiting, nullptr);
+      }
+      atomic(header.writerWaiting).store(0);
+      continue;
+    }
+    if (atomic(header.readerClosed).load(std::memory_order_relaxed) != 0) {
+      return WriteError::PIPE;
+    }
+    //! copied in at most two parts if the data wrap around
+    const auto size = std::min<std::size_t>(free, data.size());
+    const auto offset = head & (capacity - 1);
+    const auto first = std::min<std::size_t>(size, capacity - offset);
+    std::memcpy(this->data() + offset, data.data(), first);
+    std::memcpy(this->data(), data.data() + first, size - first);
+    head += size;
+    atomic(header.head).store(head);
+    data = data.subspan(size);
+    if (atomic(header.readerWaiting).load() != 0) {
+      RingBuffer::wake(header.readerWaiting);
+    }
+  }
+  return WriteError::NO_ERROR;
+}
+
+inline typename RingBuffer::WriteError RingBuffer::write(
+    std::string_view data
+) {
+  return this->write(std::as_bytes(std::span<const char>{data}));
+}
+
+inline std::tuple<std::size_t, typename RingBuffer::ReadError>
+RingBuffer::read(std::span<std::byte> buffer, const int& pidfd) {
+  auto read = std::size_t{0};
+  const auto ret = this->readChunksUpTo(
+      [&buffer, &read](std::span<const std::byte> chunk) {
+        std::memcpy(buffer.data() + read, chunk.data(), chunk.size());
+        read += chunk.size();
+        return false;
+      },
+      pidfd,
+      buffer.size()
+  );
+  return { read, ret, };
+}
+
+template <class Callback>
+typename RingBuffer::ReadError RingBuffer::readChunks(
+    Callback&& callback,
+    const int& pidfd
+) {
+  return this->readChunksUpTo(
+      std::forward<Callback>(callback), pidfd, this->capacity()
+  );
+}
+
+inline void RingBuffer::close() {
+  if (this->memory_ == nullptr) { //! moved from
+    return;
+  }
+  auto& header = this->header();
+  if (this->reader_) {
+    atomic(header.readerClosed).store(1);
+    if (atomic(header.writerWaiting).load() != 0) {
+      RingBuffer::wake(header.writerWaiting);
+    }
+  } else {
+    atomic(header.writerClosed).store(1);
+    if (atomic(header.readerWaiting).load() != 0) {
+      RingBuffer::wake(header.readerWaiting);
+    }
+  }
+}
+
+constexpr const int& RingBuffer::fd() const {
+  return this->fd_;
+}
+
+inline std::size_t RingBuffer::capacity() const {
+  return this->capacity_;
+}
+
+inline RingBuffer::RingBuffer(
+    const int& fd,
+    void* memory,
+    const std::size_t& size,
+    const std::size_t& capacity,
+    const bool& reader
+)
+  : fd_{fd}, memory_{memory}, size_{size}, capacity_{capacity}, reader_{reader}
+{}
+
+template <class T>
+std::atomic_ref<T> RingBuffer::atomic(T& counter) {
+  static_assert(std::atomic_ref<T>::is_always_lock_free);
+  return std::atomic_ref<T>{counter};
+}
+
+inline void RingBuffer::sleep(std::uint32_t& word, const timespec* timeout) {
+  //! not FUTEX_PRIVATE_FLAG => the word is shared by the processes
+  ::syscall(SYS_futex, &word, FUTEX_WAIT, 1, timeout, NULL, 0);
+}
+
+inline void RingBuffer::wake(std::uint32_t& word) {
+  atomic(word).store(0);
+  ::syscall(SYS_futex, &word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+inline std::tuple<std::size_t, typename RingBuffer::ReadError>
+RingBuffer::waitData(const int& pidfd) {
+  auto& header = this->header();
+  const auto tail = atomic(header.tail).load(std::memory_order_relaxed);
+  //! the writer exiting is checked periodically if it can be detected
+  constexpr auto PERIOD = timespec{ .tv_sec = 0, .tv_nsec = 50'000'000, };
+  //! the counters are written by the other process =>
+  //!     more than the capacity is never read
+  const auto availableOf = [this, &header, &tail]() {
+    return std::min<std::size_t>(
+        atomic(header.head).load() - tail, this->capacity_
+    );
+  };
+  while (true) {
+    auto available = availableOf();
+    if (available > 0) {
+      return { available, ReadError::NO_ERROR, };
+    }
+    if (atomic(header.writerClosed).load() != 0) {
+      //! the data written before the close are visible now
+      available = availableOf();
+      return { available, ReadError::NO_ERROR, };
+    }
+    //! announce the sleep and check the data again =>
+    //!     the writer either sees the announcement or the data are seen
+    atomic(header.readerWaiting).store(1);
+    if (
+        atomic(header.head).load() == tail &&
+        atomic(header.writerClosed).load() == 0
+    ) {
+      RingBuffer::sleep(header.readerWaiting, pidfd < 0 ? nullptr : &PERIOD);
+    }
+    atomic(header.readerWaiting).store(0);
+    if (pidfd >= 0) {
+      auto descriptor = pollfd{ .fd = pidfd, .events = POLLIN, .revents = 0, };
+      if (
+          ::poll(&descriptor, 1, 0) > 0 &&
+          atomic(header.head).load() == tail &&
+          atomic(header.writerClosed).load() == 0
+      ) { //! the writer exited without closing
+        return { 0, ReadError::PIPE, };
+      }
+    }
+  }
+}
+
+template <class Callback>
+typename RingBuffer::ReadError RingBuffer::readChunksUpTo(
+    Callback&& callback,
+    const int& pidfd,
+    const std::size_t& limit
+) {
+  if (this->memory_ == nullptr) { //! moved from
+    return ReadError::PIPE;
+  }
+  auto& header = this->header();
+  const auto capacity = this->capacity_;
+  while (true) {
+    const auto [available, error] = this->waitData(pidfd);
+    if (error != ReadError::NO_ERROR) {
+      return error;
+    }
+    if (available == 0) { //! end of file
+      return ReadError::NO_ERROR;
+    }
+    const auto tail = atomic(header.tail).load(std::memory_order_relaxed);
+    //! a chunk ends where the data wrap around
+    const auto offset = tail & (capacity - 1);
+    const auto size = std::min({
+      static_cast<std::size_t>(available),
+      static_cast<std::size_t>(capacity - offset),
+      limit,
+    });
+    const auto chunk = std::span<const std::byte>{this->data() + offset, size};
+    auto proceed = true;
+    if constexpr (
+        std::is_same_v<
+            std::invoke_result_t<Callback, std::span<const std::byte>>, bool
+        >
+    ) {
+      proceed = callback(chunk);
+    } else {
+      callback(chunk);
+    }
+    //! the chunk is released after the call => the writer can reuse it
+    atomic(header.tail).store(tail + size);
+    if (atomic(header.writerWaiting).load() != 0) {
+      RingBuffer::wake(header.writerWaiting);
+    }
+    if (!proceed) {
+      return ReadError::NO_ERROR;
+    }
+  }
+}
+
+inline typename RingBuffer::Header& RingBuffer::header() const {
+  return *static_cast<Header*>(this->memory_);
+}
+
+inline std::byte* RingBuffer::data() const {
+  return static_cast<std::byte*>(this->memory_) +
+      (this->size_ - this->capacity_);
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_RING_BUFFER_HH_
@@ -0,0 +1,294 @@
+#ifndef CU0_SPAWN_SERVER_HH_
+#define CU0_SPAWN_SERVER_HH_
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/exec_plan.hh>
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+#include <cu0/proc/stdio.hh>
+#include <cu0/proc/zygote_pool.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/socket.h>)
+#warning <sys/socket.h> is not found => \
+    cu0::SpawnServer will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::SpawnServer will not be supported
+#endif
+#if !__has_include(<sys/types.h>) || !__has_include(<sys/wait.h>)
+#warning <sys/types.h> or <sys/wait.h> is not found => \
+    cu0::SpawnServer will not be supported
+#endif
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::SpawnServer will not be supported
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::SpawnServer will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief The SpawnServer struct provides a way to create processes by
+ *     a small helper process => the cost of a spawn does not depend on
+ *     memory and threads of this process
+ * @note the server is forked from this process by SpawnServer::create() =>
+ *     it has to be created early while this process is small and
+ *     single-threaded
+ * @note a process is spawned by the server with CLONE_PARENT =>
+ *     it is a child of this process and SpawnServer::spawn() returns
+ *     a Process which behaves as one created by Process::create()
+ * @note executables and file descriptors are passed to the server over
+ *     a unix socket (SCM_RIGHTS) @see ZygotePool
+ * @note spawned processes inherit the current directory, the signal
+ *     dispositions and Redirection::Kind::INHERIT streams of this process as
+ *     they were when the server was created
+ */
+struct SpawnServer {
+public:
+  /*!
+   * @brief creates a spawn server by forking this process
+   * @note has to be called by a single-threaded process => the server
+   *     allocates (requests are decoded into an ExecPlan) and a lock held by
+   *     another thread during fork() would never be released in the server
+   * @note file descriptors of this process other than stdin, stdout and
+   *     stderr are closed in the server
+   * @return
+   *     if there were no errors -> created spawn server
+   *     if there was an error -> error code @see Process::create()
+   */
+  [[nodiscard]] static std::variant<SpawnServer, Process::CreateError>
+  create();
+  SpawnServer(const SpawnServer& other) = delete;
+  SpawnServer& operator =(const SpawnServer& other) = delete;
+  /*!
+   * @brief moves the specified spawn server resources to this spawn server
+   * @param other is the spawn server to be moved
+   */
+  SpawnServer(SpawnServer&& other) = default;
+  /*!
+   * @brief moves the specified spawn server resources to this spawn server
+   * @param other is the spawn server to be moved
+   * @return this spawn server as mutable reference
+   */
+  SpawnServer& operator =(SpawnServer&& other);
+  /*!
+   * @brief destructs an instance
+   * @note the server exits and is waited
+   */
+  virtual ~SpawnServer();
+  /*!
+   * @brief spawns a process executing the specified executable by the server
+   * @note thread-safe, the spawns are served one by one
+   * @note the process is spawned by clone(CLONE_PARENT | CLONE_VFORK) +
+   *     execve() => errors of execve() are the exit status code of
+   *     the process as for Process::SpawnStrategy::VFORK
+   * @param executable is the executable to be run by the process
+   *     @note the arguments and the environment have to fit into one
+   *         socket message @see SO_SNDBUF
+   * @param stdio are the redirections of the process
+   *     @see Process::create(const ExecPlan&, const Stdio&)
+   * @return
+   *     if there were no errors -> created process
+   *     if there was an error -> error code @see Process::create()
+   *         @note Process::CreateError::AGAIN is returned if the server has
+   *             exited
+   *         @note Process::CreateError::INVAL is returned if the server has
+   *             been moved from
+   */
+  [[nodiscard]] std::variant<Process, Process::CreateError> spawn(
+      const Executable& executable,
+      const Stdio& stdio = Stdio{}
+  ) const;
+protected:
+  /*!
+   * @brief constructs an instance with the specified server
+   * @param server is the server process and its control socket
+   */
+  explicit SpawnServer(std::unique_ptr<ZygotePool::Zygote> server);
+  /*!
+   * @brief serves spawn requests until the control socket is closed
+   * @note runs in the server
+   * @param socket is the control socket
+   */
+  [[noreturn]] static void serve(const int& socket);
+  /*!
+   * @brief closes all the file descriptors of the current process except
+   *     stdin, stdout, stderr and the specified one
+   * @param fd is the file descriptor to be kept
+   */
+  static void closeAllExcept(const int& fd);
+  //! the server process and its control socket
+  std::unique_ptr<ZygotePool::Zygote> server_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+inline std::variant<SpawnServer, Process::CreateError> SpawnServer::create() {
+  int sockets[2];
+  if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) {
+    return static_cast<Process::CreateError>(errno);
+  }
+  auto server = std::make_unique<ZygotePool::Zygote>();
+  const auto pid = ::fork();
+  if (pid == 0) { //! server, allocates => single-threaded caller only
+    SpawnServer::closeAllExcept(sockets[1]);
+    SpawnServer::serve(sockets[1]);
+  }
+  ::close(sockets[1]);
+  if (pid < 0) { //! fork failed
+    const auto ret = static_cast<Process::CreateError>(errno);
+    ::close(sockets[0]);
+    return ret;
+  }
+  server->process.pid_ = static_cast<unsigned>(pid);
+  //! the server does not exit before its control socket is closed or
+  //!     it is killed => the pid is not reused before the pidfd is opened
+  server->process.pidfd_ = Process::pidfdOf(pid);
+  server->socket = sockets[0];
+  if (
+      const auto ret = ZygotePool::ready(*server);
+      ret != Process::CreateError::NO_ERROR
+  ) {
+    ZygotePool::stop(*server);
+    return ret;
+  }
+  return SpawnServer{std::move(server)};
+}
+
+inline SpawnServer& SpawnServer::operator =(SpawnServer&& other) {
+  std::swap(this->server_, other.server_);
+  return *this;
+}
+
+inline SpawnServer::~SpawnServer() {
+  if (this->server_ != nullptr) {
+    ZygotePool::stop(*this->server_);
+  }
+}
+
+inline std::variant<Process, Process::CreateError> SpawnServer::spawn(
+    const Executable& executable,
+    const Stdio& stdio
+) const {
+  if (this->server_ == nullptr) {
+    return Process::CreateError::INVAL;
+  }
+  return ZygotePool::launchWith(
+      executable,
+      stdio,
+      [this](std::string_view request, std::span<const int> fds) {
+        const auto lock = std::lock_guard{this->server_->mutex};
+        return ZygotePool::exchange(*this->server_, request, fds);
+      }
+  );
+}
+
+inline SpawnServer::SpawnServer(std::unique_ptr<ZygotePool::Zygote> server)
+  : server_{std::move(server)}
+{}
+
+inline void SpawnServer::serve(const int& socket) {
+  //! the server is ready
+  if (!ZygotePool::reply(socket, 0)) {
+    ::_exit(0);
+  }
+  //! reused => the server allocates only for larger requests
+  auto request = std::vector<char>{};
+  auto fds = std::vector<int>{};
+  auto targets = std::vector<int>{};
+  auto pairs = std::vector<std::pair<int, int>>{};
+  auto scratch = std::vector<int>{};
+  while (ZygotePool::receiveMessage(socket, request, fds) == 0) {
+    const auto executable =
+        ZygotePool::executableOf(request, fds.size(), targets);
+    auto pid = pid_t{-1};
+    auto pidfd = -1;
+    auto error = EINVAL;
+    if (executable.has_value()) {
+      const auto plan = ExecPlan{*executable};
+      pairs.resize(fds.size());
+      for (auto i = std::size_t{0}; i < fds.size(); i++) {
+        pairs[i] = { targets[i], fds[i], };
+      }
+      scratch.resize(fds.size());
+#ifdef CLONE_VFORK
+      //! the server is suspended until the process calls execve()
+      pid = ZygotePool::cloneSibling(CLONE_VFORK, &pidfd);
+#else
+      pid = ZygotePool::cloneSibling(0, &pidfd);
+#endif
+      if (pid == 0) { //! spawned process
+        Process::execute(plan.argv(), plan.envp(), pairs, scratch);
+      }
+      error = errno;
+    }
+    //! the pid is replied first => a spawned process is not left unowned
+    //!     by a failure of the server after the clone
+    const auto replied =
+        ZygotePool::reply(socket, pid < 0 ? -error : pid, pidfd);
+    //! the received file descriptors have FD_CLOEXEC set =>
+    //!     the spawned process has closed its copies by execve()
+    for (const auto& fd : fds) {
+      ::close(fd);
+    }
+    if (pidfd >= 0) {
+      ::close(pidfd);
+    }
+    if (!replied) {
+      break;
+    }
+  }
+  //! _exit() => handlers and destructors of the forked process are not run
+  ::_exit(0);
+}
+
+inline void SpawnServer::closeAllExcept(const int& fd) {
+  for (auto i = 3; i < fd; i++) {
+    ::close(i);
+  }
+#ifdef SYS_close_range
+  if (::syscall(SYS_close_range, fd + 1, ~0u, 0) == 0) {
+    return;
+  }
+#endif
+  const auto limit = ::sysconf(_SC_OPEN_MAX);
+  for (auto i = fd + 1; i < limit; i++) {
+    ::close(i);
+  }
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_SPAWN_SERVER_HH_
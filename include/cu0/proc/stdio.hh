@@ -0,0 +1,174 @@
+#ifndef CU0_STDIO_HH_
+#define CU0_STDIO_HH_
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cu0 {
+
+/*!
+ * @brief The Redirection struct specifies where a standard stream of
+ *     a created process is connected to
+ * @see Stdio
+ */
+struct Redirection {
+public:
+  enum struct Kind {
+    //! a pipe to this process
+    //! @note the only kind supported by Process::stdin(), Process::stdout()
+    //!     and Process::stderr()
+    PIPE = 0,
+    //! the stream of this process is inherited
+    INHERIT,
+    //! /dev/null
+    NUL,
+    //! a file opened by a path
+    PATH,
+    //! an already opened file descriptor of this process
+    FD,
+    //! the same file as stdout of the created process ("2>&1")
+    //! @note supported by stderr only
+    STDOUT,
+    //! a sealed in-memory file containing the specified data
+    //! @note supported by stdin only
+    //! @note the created process can seek it and mmap() it
+    MEMORY,
+  };
+  /*!
+   * @brief creates a redirection to a pipe
+   * @return redirection of Kind::PIPE
+   */
+  static Redirection pipe();
+  /*!
+   * @brief creates a redirection to the stream of this process
+   * @return redirection of Kind::INHERIT
+   */
+  static Redirection inherit();
+  /*!
+   * @brief creates a redirection to /dev/null
+   * @return redirection of Kind::NUL
+   */
+  static Redirection null();
+  /*!
+   * @brief creates a redirection to a file
+   * @param path is the path to the file
+   * @param flags are flags of ::open()
+   *     @note O_CLOEXEC is always added
+   *     if not specified ->
+   *         O_RDONLY for stdin,
+   *         O_WRONLY | O_CREAT | O_TRUNC for stdout and stderr
+   * @return redirection of Kind::PATH
+   */
+  static Redirection file(
+      const std::filesystem::path& path,
+      const std::optional<int>& flags = std::nullopt
+  );
+  /*!
+   * @brief creates a redirection to a file descriptor
+   * @note the file descriptor is duplicated => it is not closed and can be
+   *     reused by the caller
+   * @param fd is the file descriptor of this process
+   * @return redirection of Kind::FD
+   */
+  static Redirection fd(const int& fd);
+  /*!
+   * @brief creates a redirection of stderr to stdout ("2>&1")
+   * @return redirection of Kind::STDOUT
+   */
+  static Redirection toStdout();
+  /*!
+   * @brief creates a redirection of stdin to a sealed in-memory file
+   * @note the data are copied into a memfd once, which is sealed against
+   *     any modification => the created process gets a regular read-only
+   *     file which it can seek and mmap()
+   * @param data are the data to be read by the created process
+   *     @note they have to be valid until Process::create() returns
+   * @return redirection of Kind::MEMORY
+   */
+  static Redirection memory(std::span<const std::byte> data);
+  /*!
+   * @brief creates a redirection of stdin to a sealed in-memory file
+   * @see Redirection::memory(std::span<const std::byte>)
+   */
+  static Redirection memory(std::string_view data);
+  //! kind of the redirection
+  Kind kind = Kind::PIPE;
+  //! path to the file @see Kind::PATH
+  std::filesystem::path path{};
+  //! flags of ::open() @see Kind::PATH
+  std::optional<int> flags{};
+  //! file descriptor of this process @see Kind::FD
+  int descriptor = -1;
+  //! data of the in-memory file @see Kind::MEMORY
+  std::span<const std::byte> data{};
+protected:
+private:
+};
+
+/*!
+ * @brief The Stdio struct specifies file descriptors of a created process
+ * @note only pipes of Redirection::Kind::PIPE are created =>
+ *     streams which are not needed cost no system calls
+ * @see Process::create(const ExecPlan&, const Stdio&)
+ */
+struct Stdio {
+  //! redirection of stdin
+  Redirection in{};
+  //! redirection of stdout
+  Redirection out{};
+  //! redirection of stderr
+  Redirection err{};
+  //! extra file descriptors to be inherited as pairs of
+  //!     a file descriptor in the created process and
+  //!     a file descriptor of this process
+  //! @note e.g. { 3, fd, } makes fd available as 3 in the created process
+  std::vector<std::pair<int, int>> fds{};
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline Redirection Redirection::pipe() {
+  return {};
+}
+
+inline Redirection Redirection::inherit() {
+  return { .kind = Kind::INHERIT };
+}
+
+inline Redirection Redirection::null() {
+  return { .kind = Kind::NUL };
+}
+
+inline Redirection Redirection::file(
+    const std::filesystem::path& path,
+    const std::optional<int>& flags
+) {
+  return { .kind = Kind::PATH, .path = path, .flags = flags, };
+}
+
+inline Redirection Redirection::fd(const int& fd) {
+  return { .kind = Kind::FD, .descriptor = fd, };
+}
+
+inline Redirection Redirection::toStdout() {
+  return { .kind = Kind::STDOUT };
+}
+
+inline Redirection Redirection::memory(std::span<const std::byte> data) {
+  return { .kind = Kind::MEMORY, .data = data, };
+}
+
+inline Redirection Redirection::memory(std::string_view data) {
+  return Redirection::memory(std::as_bytes(std::span<const char>{data}));
+}
+
+} /// namespace cu0
+
+#endif /// CU0_STDIO_HH_
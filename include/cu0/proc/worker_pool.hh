@@ -0,0 +1,543 @@
+#ifndef CU0_WORKER_POOL_HH_
+#define CU0_WORKER_POOL_HH_
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/exec_plan.hh>
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<signal.h>)
+#warning <signal.h> is not found => \
+    cu0::WorkerPool will not be supported
+#else
+#include <signal.h>
+#endif
+#if !__has_include(<sys/types.h>) || !__has_include(<sys/wait.h>)
+#warning <sys/types.h> or <sys/wait.h> is not found => \
+    cu0::WorkerPool will not be supported
+#endif
+#if !__has_include(<sys/uio.h>)
+#warning <sys/uio.h> is not found => \
+    cu0::WorkerPool will not be supported
+#endif
+#if !__has_include(<unistd.h>) || !__has_include(<fcntl.h>)
+#warning <unistd.h> or <fcntl.h> is not found => \
+    cu0::WorkerPool will not be supported
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::WorkerPool will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<signal.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+/*!
+ * @brief The WorkerPool struct provides a way to pass many requests to
+ *     long-lived processes (workers) => the cost of a request is a pipe
+ *     round trip instead of the start of a process
+ * @note a request and a response are frames on the stdin and the stdout of
+ *     a worker: the size as native std::uint64_t followed by the payload
+ * @note a worker is the specified executable which calls WorkerPool::serve()
+ * @note usage:
+ *     this process:
+ *         WorkerPool::create() -> WorkerPool::call() ...
+ *     worker (the executable):
+ *         initialisation -> WorkerPool::serve(handler)
+ */
+struct WorkerPool {
+public:
+  enum struct CallError {
+    NO_ERROR = 0, //! no error
+    AGAIN = EAGAIN, //! the worker could not be created again
+    INVAL = EINVAL, //! the pool has been moved from
+    //! the response is larger than WorkerPool::MAX_RESPONSE_SIZE
+    MSGSIZE = EMSGSIZE,
+    NOMEM = ENOMEM, //! the response could not be allocated
+    PIPE = EPIPE, //! the worker has exited during the call
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::writev() and @see ::read()
+  };
+  enum struct ServeError {
+    NO_ERROR = 0, //! no error, the stdin has been closed
+    IO = EIO, //! the stdin has been closed in the middle of a request
+    PIPE = EPIPE, //! the stdout has been closed (if SIGPIPE is ignored)
+    //! it is possible that a value is not listed in this enum ->
+    //!     for other error codes @see ::read() and @see ::writev()
+  };
+  //! maximum size of a response in bytes
+  //!     @note a larger size is treated as a broken response =>
+  //!         garbage written to the stdout of a worker is not allocated
+  static constexpr std::size_t MAX_RESPONSE_SIZE = std::size_t{1} << 30;
+  /*!
+   * @brief creates workers running the specified executable
+   * @note stdin and stdout of the workers are pipes of the pool,
+   *     stderr is inherited
+   * @note returns without waiting for the workers to be initialised =>
+   *     the first requests are queued in the pipes
+   * @param executable is the executable to be run by the workers
+   * @param size is the number of workers
+   *     @note every worker serves one request at a time =>
+   *         it is the number of concurrent calls
+   * @return
+   *     if there were no errors -> created worker pool
+   *     if there was an error -> error code @see Process::create()
+   *         @note Process::CreateError::INVAL is returned for no workers
+   */
+  [[nodiscard]] static std::variant<WorkerPool, Process::CreateError> create(
+      const Executable& executable,
+      const std::size_t& size =
+          std::max(std::thread::hardware_concurrency(), 1u)
+  );
+  /*!
+   * @brief serves requests of the worker pool which created
+   *     the current process until its stdin is closed
+   * @note a request is read completely before the handler is called and
+   *     the response is written completely before the next request is read
+   * @note the stdout of the current process is redirected to its stderr =>
+   *     output of the handler does not break the frames
+   *     @note data buffered by std::cout before the call are written
+   *         to the stderr
+   * @tparam Handler is invocable with std::string_view (the request)
+   *     returning a type convertible to std::string_view (the response)
+   * @param handler is called for every request
+   *     @note the request is valid only during the call
+   * @return
+   *     if the stdin has been closed between requests -> ServeError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  template <class Handler>
+  static ServeError serve(Handler&& handler);
+  WorkerPool(const WorkerPool& other) = delete;
+  WorkerPool& operator =(const WorkerPool& other) = delete;
+  /*!
+   * @brief moves the specified worker pool resources to this worker pool
+   * @param other is the worker pool to be moved
+   */
+  WorkerPool(WorkerPool&& other) = default;
+  /*!
+   * @brief moves the specified worker pool resources to this worker pool
+   * @param other is the worker pool to be moved
+   * @return this worker pool as mutable reference
+   */
+  WorkerPool& operator =(WorkerPool&& other);
+  /*!
+   * @brief destructs an instance
+   * @note the stdin of the workers is closed and the workers are waited
+   */
+  virtual ~WorkerPool();
+  /*!
+   * @brief passes the specified request to an idle worker and returns
+   *     its response
+   * @see WorkerPool::callCautious()
+   * @param request is the request
+   * @return response (empty if there was an error)
+   */
+  std::string call(std::string_view request) const;
+  /*!
+   * @brief passes the specified request to an idle worker and returns
+   *     its response
+   * @note thread-safe, blocks until a worker is idle
+   *     @note the most recently used idle worker is preferred =>
+   *         its memory is likely to be cached
+   * @note SIGPIPE is blocked for the calling thread during the call
+   * @note if the worker has exited or sent a broken response
+   *     (including a response larger than WorkerPool::MAX_RESPONSE_SIZE) ->
+   *     it is killed and created again, the request is not retried
+   *     because it may have crashed the worker
+   * @param request is the request
+   * @return tuple containing
+   *     response (empty if there was an error)
+   *     CallError::NO_ERROR if there were no errors
+   *         otherwise error code
+   */
+  std::tuple<std::string, CallError> callCautious(
+      std::string_view request
+  ) const;
+  /*!
+   * @brief accesses the number of workers
+   * @return number of workers
+   */
+  std::size_t size() const;
+protected:
+  /*!
+   * @brief The State struct contains the workers
+   * @note kept in memory at a stable address => the worker pool is movable
+   */
+  struct State {
+    //! packed executable of the workers
+    ExecPlan plan;
+    //! the workers @note a worker with pid 0 is created by the next call
+    std::vector<Process> workers{};
+    //! held while the idle workers are accessed
+    std::mutex mutex{};
+    //! notified when a worker becomes idle
+    std::condition_variable released{};
+    //! indices of the idle workers
+    std::vector<std::size_t> idle{};
+  };
+  /*!
+   * @brief constructs an instance with the specified state
+   * @param state is the state of the worker pool
+   */
+  explicit WorkerPool(std::unique_ptr<State> state);
+  /*!
+   * @brief creates a worker
+   * @param plan is the packed executable of the worker
+   * @param worker is the worker to be created
+   * @return
+   *     if there were no errors -> Process::CreateError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  static Process::CreateError start(const ExecPlan& plan, Process& worker);
+  /*!
+   * @brief passes the specified request to the worker and reads its response
+   * @param worker is the worker
+   * @param request is the request
+   * @param response is the response
+   * @return
+   *     if there were no errors -> CallError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  static CallError exchange(
+      const Process& worker,
+      std::string_view request,
+      std::string& response
+  );
+  /*!
+   * @brief reads exactly the specified number of bytes
+   * @note interrupted and partial reads are continued
+   * @param fd is the file descriptor to read from
+   * @param data is the memory to read into
+   * @return tuple containing
+   *     number of read bytes
+   *     0 if all the bytes have been read,
+   *         EPIPE if the end of file has been reached before,
+   *         otherwise errno of ::read()
+   */
+  static std::tuple<std::size_t, int> readExactly(
+      const int& fd,
+      std::span<std::byte> data
+  );
+  //! state of the worker pool
+  std::unique_ptr<State> state_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<signal.h>) && __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>) && __has_include(<sys/uio.h>) && \
+    __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+inline std::variant<WorkerPool, Process::CreateError> WorkerPool::create(
+    const Executable& executable,
+    const std::size_t& size
+) {
+  if (size == 0) {
+    return Process::CreateError::INVAL;
+  }
+  auto state = std::make_unique<State>(ExecPlan{executable});
+  state->workers.reserve(size);
+  for (auto i = std::size_t{0}; i < size; i++) {
+    state->workers.push_back(Process{});
+  }
+  //! the worker to be used first is on top
+  state->idle.reserve(size);
+  for (auto i = size; i > 0; i--) {
+    state->idle.push_back(i - 1);
+  }
+  for (auto& worker : state->workers) {
+    if (
+        const auto ret = WorkerPool::start(state->plan, worker);
+        ret != Process::CreateError::NO_ERROR
+    ) {
+      //! the created workers are stopped by the destructor
+      static_cast<void>(WorkerPool{std::move(state)});
+      return ret;
+    }
+  }
+  return WorkerPool{std::move(state)};
+}
+
+template <class Handler>
+WorkerPool::ServeError WorkerPool::serve(Handler&& handler) {
+  //! the frames are written to a copy of the stdout
+  const auto out = ::fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, STDERR_FILENO + 1);
+  if (out < 0) {
+    return static_cast<ServeError>(errno);
+  }
+  ::dup2(STDERR_FILENO, STDOUT_FILENO);
+  auto request = std::string{};
+  auto ret = ServeError::NO_ERROR;
+  while (true) {
+    auto size = std::uint64_t{0};
+    const auto [bytes, error] = WorkerPool::readExactly(
+        STDIN_FILENO, std::as_writable_bytes(std::span{&size, 1})
+    );
+    if (error != 0) {
+      if (error != EPIPE) {
+        ret = static_cast<ServeError>(error);
+      } else if (bytes != 0) {
+        ret = ServeError::IO;
+      }
+      break;
+    }
+    //! reused => allocates only for larger requests
+    request.resize(size);
+    if (
+        const auto [_, requestError] = WorkerPool::readExactly(
+            STDIN_FILENO, std::as_writable_bytes(std::span{request})
+        );
+        requestError != 0
+    ) {
+      ret = requestError == EPIPE ?
+          ServeError::IO : static_cast<ServeError>(requestError);
+      break;
+    }
+    const auto& response = handler(std::string_view{request});
+    const auto payload = std::string_view{response};
+    const auto responseSize = static_cast<std::uint64_t>(payload.size());
+    const std::string_view frame[2] = {
+      { reinterpret_cast<const char*>(&responseSize), sizeof(responseSize), },
+      payload,
+    };
+    if (
+        const auto [responseError, _] = Process::writeVectorInto<
+            std::tuple<Process::WriteError, std::size_t>
+        >(out, frame);
+        responseError != Process::WriteError::NO_ERROR
+    ) {
+      ret = static_cast<ServeError>(responseError);
+      break;
+    }
+  }
+  ::close(out);
+  return ret;
+}
+
+inline WorkerPool& WorkerPool::operator =(WorkerPool&& other) {
+  std::swap(this->state_, other.state_);
+  return *this;
+}
+
+inline WorkerPool::~WorkerPool() {
+  if (this->state_ == nullptr) {
+    return;
+  }
+  //! all the workers are stopped first => they exit concurrently
+  for (auto& worker : this->state_->workers) {
+    worker.closeStdin();
+  }
+  for (auto& worker : this->state_->workers) {
+    if (worker.pid() != 0) {
+      worker.wait();
+    }
+  }
+}
+
+inline std::string WorkerPool::call(std::string_view request) const {
+  return std::get<0>(this->callCautious(request));
+}
+
+inline std::tuple<std::string, WorkerPool::CallError>
+WorkerPool::callCautious(std::string_view request) const {
+  if (this->state_ == nullptr) {
+    return { std::string{}, CallError::INVAL, };
+  }
+  auto& state = *this->state_;
+  auto index = std::size_t{0};
+  {
+    auto lock = std::unique_lock{state.mutex};
+    state.released.wait(lock, [&state]() { return !state.idle.empty(); });
+    index = state.idle.back();
+    state.idle.pop_back();
+  }
+  //! the worker is owned by this call until it is released =>
+  //!     it is released on every exit path
+  struct Release {
+    State& state;
+    const std::size_t& index;
+    ~Release() {
+      {
+        const auto lock = std::lock_guard{this->state.mutex};
+        this->state.idle.push_back(this->index);
+      }
+      this->state.released.notify_one();
+    }
+  };
+  const auto release = Release{ .state = state, .index = index, };
+  auto& worker = state.workers[index];
+  auto response = std::string{};
+  auto ret = CallError::NO_ERROR;
+  if (
+      worker.pid() == 0 &&
+      WorkerPool::start(state.plan, worker) != Process::CreateError::NO_ERROR
+  ) {
+    ret = CallError::AGAIN;
+  }
+  if (ret == CallError::NO_ERROR) {
+    //! block SIGPIPE so that an exited worker is reported as
+    //!     CallError::PIPE instead of killing the caller
+    sigset_t pipeSignal;
+    sigset_t previousSignals;
+    ::sigemptyset(&pipeSignal);
+    ::sigaddset(&pipeSignal, SIGPIPE);
+    ::pthread_sigmask(SIG_BLOCK, &pipeSignal, &previousSignals);
+    sigset_t pendingSignals;
+    ::sigpending(&pendingSignals);
+    const auto pipeSignalWasPending = ::sigismember(&pendingSignals, SIGPIPE);
+    ret = WorkerPool::exchange(worker, request, response);
+    if (ret == CallError::PIPE && !pipeSignalWasPending) {
+      //! consume SIGPIPE generated by this call before unblocking it
+      const auto noWait = timespec{};
+      ::sigtimedwait(&pipeSignal, nullptr, &noWait);
+    }
+    ::pthread_sigmask(SIG_SETMASK, &previousSignals, nullptr);
+  }
+  if (ret != CallError::NO_ERROR && worker.pid() != 0) {
+    //! the state of the worker is unknown => it is replaced
+    worker.signal(SIGKILL);
+    worker.wait();
+    worker = Process{};
+    if (
+        WorkerPool::start(state.plan, worker) != Process::CreateError::NO_ERROR
+    ) {
+      worker = Process{};
+    }
+    response.clear();
+  }
+  return { std::move(response), ret, };
+}
+
+inline std::size_t WorkerPool::size() const {
+  return this->state_ == nullptr ? 0 : this->state_->workers.size();
+}
+
+inline WorkerPool::WorkerPool(std::unique_ptr<State> state)
+  : state_{std::move(state)}
+{}
+
+inline Process::CreateError WorkerPool::start(
+    const ExecPlan& plan,
+    Process& worker
+) {
+  auto created = Process::create(
+      plan,
+      Stdio{
+        .in = Redirection::pipe(),
+        .out = Redirection::pipe(),
+        .err = Redirection::inherit(),
+      }
+  );
+  if (std::holds_alternative<Process::CreateError>(created)) {
+    return std::get<Process::CreateError>(created);
+  }
+  worker = std::get<Process>(std::move(created));
+  return Process::CreateError::NO_ERROR;
+}
+
+inline WorkerPool::CallError WorkerPool::exchange(
+    const Process& worker,
+    std::string_view request,
+    std::string& response
+) {
+  const auto requestSize = static_cast<std::uint64_t>(request.size());
+  const std::string_view frame[2] = {
+    { reinterpret_cast<const char*>(&requestSize), sizeof(requestSize), },
+    request,
+  };
+  //! the worker reads the whole request before responding =>
+  //!     the request is written completely before the response is read
+  if (
+      const auto [error, _] = worker.stdinCautious(std::span{frame});
+      error != Process::WriteError::NO_ERROR
+  ) {
+    return static_cast<CallError>(error);
+  }
+  auto size = std::uint64_t{0};
+  if (
+      const auto [_, error] = WorkerPool::readExactly(
+          worker.stdoutPipe(), std::as_writable_bytes(std::span{&size, 1})
+      );
+      error != 0
+  ) {
+    return static_cast<CallError>(error);
+  }
+  if (size > MAX_RESPONSE_SIZE) {
+    return CallError::MSGSIZE;
+  }
+  try {
+    response.resize(size);
+  } catch (const std::bad_alloc&) {
+    return CallError::NOMEM;
+  }
+  if (
+      const auto [_, error] = WorkerPool::readExactly(
+          worker.stdoutPipe(), std::as_writable_bytes(std::span{response})
+      );
+      error != 0
+  ) {
+    return static_cast<CallError>(error);
+  }
+  return CallError::NO_ERROR;
+}
+
+inline std::tuple<std::size_t, int> WorkerPool::readExactly(
+    const int& fd,
+    std::span<std::byte> data
+) {
+  auto bytesRead = std::size_t{0};
+  while (bytesRead < data.size()) {
+    const auto bytes =
+        ::read(fd, data.data() + bytesRead, data.size() - bytesRead);
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return { bytesRead, errno, };
+    }
+    if (bytes == 0) { //! end of file
+      return { bytesRead, EPIPE, };
+    }
+    bytesRead += static_cast<std::size_t>(bytes);
+  }
+  return { bytesRead, 0, };
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_WORKER_POOL_HH_
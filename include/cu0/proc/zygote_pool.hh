@@ -0,0 +1,1001 @@
+#ifndef CU0_ZYGOTE_POOL_HH_
+#define CU0_ZYGOTE_POOL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cu0/proc/exec_plan.hh>
+#include <cu0/proc/executable.hh>
+#include <cu0/proc/process.hh>
+#include <cu0/proc/stdio.hh>
+
+/*!
+ * @brief checks software compatibility during compile-time
+ */
+#ifdef __unix__
+#if !__has_include(<sys/socket.h>)
+#warning <sys/socket.h> is not found => \
+    cu0::ZygotePool will not be supported
+#else
+#include <sys/socket.h>
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::ZygotePool will not be supported
+#else
+#include <sys/syscall.h>
+#endif
+#if !__has_include(<sys/types.h>) || !__has_include(<sys/wait.h>)
+#warning <sys/types.h> or <sys/wait.h> is not found => \
+    cu0::ZygotePool will not be supported
+#endif
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::ZygotePool will not be supported
+#else
+#include <unistd.h>
+#endif
+#else
+#warning __unix__ is not defined => \
+    cu0::ZygotePool will not be supported
+#endif
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief The ZygotePool struct provides a way to launch processes by forking
+ *     pre-initialised template processes (zygotes) instead of executing
+ *     a binary => exec, dynamic linking and initialisation are skipped
+ * @note a zygote is the specified executable which calls ZygotePool::serve()
+ *     once it has been initialised, the launched processes return from it
+ * @note a launched process is cloned with CLONE_PARENT => it is a child of
+ *     this process and it is waited as any created process
+ * @note arguments, environment and file descriptors of a launched process
+ *     are passed over a unix socket (SCM_RIGHTS)
+ * @note usage:
+ *     this process:
+ *         ZygotePool::create() -> ZygotePool::launch() -> Process::wait()
+ *     zygote (the executable):
+ *         initialisation -> ZygotePool::serve()
+ *             if an executable is returned -> the launched process
+ *             else -> the zygote pool has been destructed or
+ *                 the executable is not a zygote
+ */
+struct ZygotePool {
+public:
+  friend struct SpawnServer;
+  enum struct ServeError {
+    NO_ERROR = 0, //! no error
+    BADF = EBADF, //! the process has not been created by a zygote pool
+    PIPE = EPIPE, //! the zygote pool has been destructed
+  };
+  //! name of the environment variable containing the file descriptor of
+  //!     the control socket in a zygote
+  static constexpr const char* ENVIRONMENT_VARIABLE = "CU0_ZYGOTE_FD";
+  /*!
+   * @brief creates zygotes running the specified executable
+   * @note returns after all the zygotes have called ZygotePool::serve()
+   * @note stdin, stdout and stderr of the zygotes are inherited
+   * @param executable is the executable to be run by the zygotes
+   * @param size is the number of zygotes
+   *     @note every zygote serves one launch at a time =>
+   *         it is the number of concurrent launches
+   * @return
+   *     if there were no errors -> created zygote pool
+   *     if there was an error -> error code @see Process::create()
+   *         @note Process::CreateError::AGAIN is returned if a zygote exited
+   *             without calling ZygotePool::serve()
+   *         @note Process::CreateError::INVAL is returned for no zygotes
+   */
+  [[nodiscard]] static std::variant<ZygotePool, Process::CreateError> create(
+      const Executable& executable,
+      const std::size_t& size = 1
+  );
+  /*!
+   * @brief serves launch requests of the zygote pool which created
+   *     the current process
+   * @note has to be called by a single-threaded process => no lock is held
+   *     by another thread when a process is launched
+   * @note a launched process is cloned by a raw system call, not by fork() =>
+   *     the C library does not know about the new process:
+   *     fork handlers (pthread_atfork()) are not run,
+   *     the thread id cached by the C library is the one of the zygote
+   * @note in a launched process the following can be used:
+   *     system calls and async-signal-safe functions,
+   *     memory allocation and the standard library except threads and
+   *         synchronisation,
+   *     execution of a binary (e.g. ::execve()) which resets the C library
+   * @note in a launched process the following must not be used:
+   *     creation of threads and pthread functions relying on the thread id
+   *         (e.g. pthread_self() compared to other ids, recursive,
+   *         error-checking, robust or priority-inheriting mutexes,
+   *         raise() or pthread_kill() of itself)
+   *     libraries which reset their state by fork handlers
+   *         (e.g. random generators or connection pools) =>
+   *         they have to be initialised after ZygotePool::serve() returns
+   * @note in a launched process:
+   *     the environment is replaced by the requested environment,
+   *     the requested file descriptors are set up @see Stdio,
+   *     the control socket is closed
+   *     @note if the file descriptors cannot be set up ->
+   *         the launched process exits with errno as the exit status code
+   *         instead of returning
+   * @return
+   *     in a launched process -> the requested executable
+   *         @note Executable::binary is as requested, the image of
+   *             the zygote keeps running
+   *     in the zygote ->
+   *         ServeError::PIPE if the zygote pool has been destructed
+   *         ServeError::BADF if the current process is not a zygote
+   */
+  [[nodiscard]] static std::variant<Executable, ServeError> serve();
+  ZygotePool(const ZygotePool& other) = delete;
+  ZygotePool& operator =(const ZygotePool& other) = delete;
+  /*!
+   * @brief moves the specified zygote pool resources to this zygote pool
+   * @param other is the zygote pool to be moved
+   */
+  ZygotePool(ZygotePool&& other) = default;
+  /*!
+   * @brief moves the specified zygote pool resources to this zygote pool
+   * @param other is the zygote pool to be moved
+   * @return this zygote pool as mutable reference
+   */
+  ZygotePool& operator =(ZygotePool&& other);
+  /*!
+   * @brief destructs an instance
+   * @note the control sockets are closed and the zygotes are waited
+   */
+  virtual ~ZygotePool();
+  /*!
+   * @brief launches a process by forking a zygote
+   * @note thread-safe, a free zygote is preferred
+   * @note if the zygote has exited -> it is created again,
+   *     the launch is retried once only if the request has not been sent
+   *     @note if the zygote has exited after receiving the request ->
+   *         Process::CreateError::PIPE is returned instead of launching
+   *         the process twice
+   *         @note if the zygote has been killed between the clone and
+   *             the reply -> the launched process is not owned by
+   *             a Process and it is not waited
+   * @param executable contains arguments and environment of the process
+   *     @note the binary is not executed => it is only passed to
+   *         ZygotePool::serve() @see ZygotePool::serve()
+   *     @note the arguments and the environment have to fit into one
+   *         socket message @see SO_SNDBUF
+   * @param stdio are the redirections of the process
+   *     @see Process::create(const ExecPlan&, const Stdio&)
+   *     @note Redirection::Kind::INHERIT inherits the stream of the zygote
+   * @return
+   *     if there were no errors -> launched process
+   *     if there was an error -> error code @see Process::create()
+   *         @note errors of the clone in the zygote are returned as they are
+   *         @note Process::CreateError::INVAL is returned if the pool has
+   *             been moved from
+   */
+  [[nodiscard]] std::variant<Process, Process::CreateError> launch(
+      const Executable& executable,
+      const Stdio& stdio = Stdio{}
+  ) const;
+  /*!
+   * @brief accesses the number of zygotes
+   * @return number of zygotes
+   */
+  std::size_t size() const;
+protected:
+  //! file descriptor of the control socket in a zygote
+  static constexpr int CONTROL_FD_ = 3;
+  //! maximal number of file descriptors passed by one message
+  //!     @see SCM_MAX_FD
+  static constexpr std::size_t MAX_FDS_ = 253;
+  /*!
+   * @brief The Zygote struct contains a zygote and its control socket
+   */
+  struct Zygote {
+    //! the zygote
+    Process process{};
+    //! control socket of this process
+    int socket = -1;
+    //! held during a launch
+    std::mutex mutex{};
+  };
+  /*!
+   * @brief The State struct contains the zygotes
+   * @note kept in memory at a stable address => the zygote pool is movable
+   */
+  struct State {
+    //! packed executable of the zygotes including the control socket
+    ExecPlan plan;
+    //! the zygotes
+    std::vector<std::unique_ptr<Zygote>> zygotes{};
+    //! index of the zygote to be tried first by the next launch
+    std::atomic<std::size_t> next{0};
+  };
+  /*!
+   * @brief constructs an instance with the specified state
+   * @param state is the state of the zygote pool
+   */
+  explicit ZygotePool(std::unique_ptr<State> state);
+  /*!
+   * @brief creates a zygote without waiting for it to serve
+   * @param plan is the packed executable of the zygote
+   * @param zygote is the zygote to be created
+   * @return
+   *     if there were no errors -> Process::CreateError::NO_ERROR
+   *     if there was an error -> error code
+   */
+  static Process::CreateError start(const ExecPlan& plan, Zygote& zygote);
+  /*!
+   * @brief waits until the specified zygote serves
+   * @param zygote is the zygote
+   * @return
+   *     if the zygote serves -> Process::CreateError::NO_ERROR
+   *     if the zygote has exited -> Process::CreateError::AGAIN
+   */
+  static Process::CreateError ready(Zygote& zygote);
+  /*!
+   * @brief closes the control socket of the specified zygote and waits for it
+   * @param zygote is the zygote
+   */
+  static void stop(Zygote& zygote);
+  /*!
+   * @brief launches a process by the specified exchange of a request
+   * @note the file descriptors of the stdio are opened by this process and
+   *     closed after the exchange
+   * @tparam Exchange is invocable with std::string_view (the packed request)
+   *     and std::span<const int> (the file descriptors to be passed)
+   *     returning @see ZygotePool::exchange()
+   * @param executable is the requested executable
+   * @param stdio are the redirections of the process
+   * @param exchange passes the request to a zygote
+   * @return @see ZygotePool::launch()
+   */
+  template <class Exchange>
+  static std::variant<Process, Process::CreateError> launchWith(
+      const Executable& executable,
+      const Stdio& stdio,
+      Exchange&& exchange
+  );
+  /*!
+   * @brief passes the specified request to the zygote and receives the pid
+   *     of the launched process
+   * @param zygote is the zygote
+   * @param request is the packed request @see ZygotePool::requestOf()
+   * @param fds are the file descriptors of this process to be passed
+   * @return tuple containing
+   *     if the process has been launched -> pid of the process
+   *     if the zygote has failed to launch it -> -errno
+   *     if the zygote has exited after the request has been sent -> -EPIPE
+   *     if the request has not been sent because the zygote has exited or
+   *         it has not been restarted -> 0
+   *     and process file descriptor of the launched process obtained by
+   *         the zygote with CLONE_PIDFD (-1 if it is not supported)
+   */
+  static std::tuple<std::int64_t, int> exchange(
+      Zygote& zygote,
+      std::string_view request,
+      std::span<const int> fds
+  );
+  /*!
+   * @brief packs a launch request
+   * @note layout: number of arguments, number of environment variables and
+   *     number of file descriptors as std::uint32_t, targets of the file
+   *     descriptors as std::int32_t, NUL-terminated binary, arguments and
+   *     "key=value" environment
+   * @param executable is the requested executable
+   * @param targets are the file descriptors in the launched process
+   * @return packed request
+   */
+  static std::string requestOf(
+      const Executable& executable,
+      std::span<const int> targets
+  );
+  /*!
+   * @brief unpacks a launch request
+   * @param request is the packed request @see ZygotePool::requestOf()
+   * @param fdCount is the number of received file descriptors
+   * @param targets are the file descriptors in the launched process
+   * @return
+   *     if the request is valid -> requested executable
+   *     else -> empty optional
+   */
+  static std::optional<Executable> executableOf(
+      std::span<const char> request,
+      const std::size_t& fdCount,
+      std::vector<int>& targets
+  );
+  /*!
+   * @brief replies to a request of this process
+   * @param socket is the control socket
+   * @param value is the reply @see ZygotePool::exchange()
+   * @param pidfd is the process file descriptor to be passed (-1 if none)
+   * @return true if the reply has been sent
+   */
+  static bool reply(
+      const int& socket,
+      const std::int64_t& value,
+      const int& pidfd = -1
+  );
+  /*!
+   * @brief sends a message with file descriptors
+   * @param socket is the socket to send to
+   * @param message is the message
+   *     @note it must not be empty
+   * @param fds are the file descriptors to be passed (SCM_RIGHTS)
+   * @return
+   *     if there were no errors -> 0
+   *     if there was an error -> -1 and errno is set
+   */
+  static int sendMessage(
+      const int& socket,
+      std::string_view message,
+      std::span<const int> fds
+  );
+  /*!
+   * @brief receives a message with file descriptors
+   * @note the received file descriptors have FD_CLOEXEC set
+   * @param socket is the socket to receive from
+   * @param message is the received message
+   * @param fds are the received file descriptors
+   * @return
+   *     if a message has been received -> 0
+   *     if the peer has closed the socket -> -1 and errno is EPIPE
+   *     if there was an error -> -1 and errno is set
+   *         @note received file descriptors are closed
+   */
+  static int receiveMessage(
+      const int& socket,
+      std::vector<char>& message,
+      std::vector<int>& fds
+  );
+  /*!
+   * @brief clones the current process as a sibling
+   * @note the cloned process is a child of the parent of the current process
+   * @param flags are additional flags of clone() (e.g. CLONE_VFORK)
+   * @param pidfd is set to the process file descriptor of the cloned process
+   *     obtained atomically by CLONE_PIDFD (-1 if it is not supported)
+   *     @note nullptr -> no process file descriptor is opened
+   * @return @see fork()
+   */
+  static pid_t cloneSibling(
+      const std::uint64_t& flags = 0,
+      int* pidfd = nullptr
+  );
+  //! state of the zygote pool
+  std::unique_ptr<State> state_{};
+private:
+};
+#endif
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#ifdef __unix__
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && __has_include(<sys/wait.h>) && \
+    __has_include(<unistd.h>)
+inline std::variant<ZygotePool, Process::CreateError> ZygotePool::create(
+    const Executable& executable,
+    const std::size_t& size
+) {
+  if (size == 0) {
+    return Process::CreateError::INVAL;
+  }
+  auto zygoteExecutable = executable;
+  zygoteExecutable.environment[ENVIRONMENT_VARIABLE] =
+      std::to_string(CONTROL_FD_);
+  auto state = std::make_unique<State>(ExecPlan{zygoteExecutable});
+  state->zygotes.reserve(size);
+  //! the zygotes are created first => they initialise concurrently
+  for (auto i = std::size_t{0}; i < size; i++) {
+    auto& zygote = *state->zygotes.emplace_back(std::make_unique<Zygote>());
+    if (
+        const auto ret = ZygotePool::start(state->plan, zygote);
+        ret != Process::CreateError::NO_ERROR
+    ) {
+      state->zygotes.pop_back();
+      return ret;
+    }
+  }
+  for (auto& zygote : state->zygotes) {
+    if (
+        const auto ret = ZygotePool::ready(*zygote);
+        ret != Process::CreateError::NO_ERROR
+    ) {
+      return ret;
+    }
+  }
+  return ZygotePool{std::move(state)};
+}
+
+inline std::variant<Executable, ZygotePool::ServeError> ZygotePool::serve() {
+  const auto* value = std::getenv(ENVIRONMENT_VARIABLE);
+  if (value == nullptr) {
+    return ServeError::BADF;
+  }
+  char* end = nullptr;
+  const auto socket = static_cast<int>(std::strtol(value, &end, 10));
+  if (end == value || *end != '\0') {
+    return ServeError::BADF;
+  }
+  //! the control socket is not passed to processes created by the zygote
+  if (::fcntl(socket, F_SETFD, FD_CLOEXEC) != 0) {
+    return ServeError::BADF;
+  }
+  //! the zygote is ready
+  if (!ZygotePool::reply(socket, 0)) {
+    ::close(socket);
+    return ServeError::PIPE;
+  }
+  auto request = std::vector<char>{};
+  auto fds = std::vector<int>{};
+  auto targets = std::vector<int>{};
+  while (ZygotePool::receiveMessage(socket, request, fds) == 0) {
+    auto executable = ZygotePool::executableOf(request, fds.size(), targets);
+    auto pidfd = -1;
+    const auto pid = executable.has_value() ?
+        ZygotePool::cloneSibling(0, &pidfd) : (errno = EINVAL, -1);
+    if (pid == 0) { //! launched process
+      ::close(socket);
+      auto pairs = std::vector<std::pair<int, int>>(fds.size());
+      for (auto i = std::size_t{0}; i < fds.size(); i++) {
+        pairs[i] = { targets[i], fds[i], };
+      }
+      auto scratch = std::vector<int>(fds.size());
+      if (Process::redirect(pairs, scratch) != 0) {
+        //! the process would run with wrong stdio => it exits with errno
+        //!     as if execve() failed
+        ::_exit(errno);
+      }
+      //! the received file descriptors are not executed =>
+      //!     FD_CLOEXEC does not close them
+      for (auto i = std::size_t{0}; i < fds.size(); i++) {
+        if (scratch[i] != fds[i]) {
+          ::close(scratch[i]);
+        }
+        const auto target = std::find(targets.begin(), targets.end(), fds[i]);
+        if (target == targets.end()) {
+          ::close(fds[i]);
+        }
+      }
+      ::clearenv();
+      for (const auto& [key, value] : executable->environment) {
+        ::setenv(key.c_str(), value.c_str(), 1);
+      }
+      return *std::move(executable);
+    }
+    //! the pid is replied first => a launched process is not left unowned
+    //!     by a failure of this zygote after the clone
+    const auto replied =
+        ZygotePool::reply(socket, pid < 0 ? -errno : pid, pidfd);
+    for (const auto& fd : fds) {
+      ::close(fd);
+    }
+    if (pidfd >= 0) {
+      ::close(pidfd);
+    }
+    if (!replied) {
+      break;
+    }
+  }
+  ::close(socket);
+  return ServeError::PIPE;
+}
+
+inline ZygotePool& ZygotePool::operator =(ZygotePool&& other) {
+  std::swap(this->state_, other.state_);
+  return *this;
+}
+
+inline ZygotePool::~ZygotePool() {
+  if (this->state_ == nullptr) {
+    return;
+  }
+  //! all the zygotes are stopped first => they exit concurrently
+  for (auto& zygote : this->state_->zygotes) {
+    ::close(std::exchange(zygote->socket, -1));
+  }
+  for (auto& zygote : this->state_->zygotes) {
+    ZygotePool::stop(*zygote);
+  }
+}
+
+inline std::variant<Process, Process::CreateError> ZygotePool::launch(
+    const Executable& executable,
+    const Stdio& stdio
+) const {
+  if (this->state_ == nullptr) {
+    return Process::CreateError::INVAL;
+  }
+  return ZygotePool::launchWith(
+      executable,
+      stdio,
+      [this](std::string_view request, std::span<const int> fds) {
+        auto& zygotes = this->state_->zygotes;
+        const auto first = this->state_->next.fetch_add(1) % zygotes.size();
+        auto index = first;
+        auto lock = std::unique_lock{zygotes[index]->mutex, std::try_to_lock};
+        for (
+            auto i = std::size_t{1};
+            !lock.owns_lock() && i < zygotes.size();
+            i++
+        ) {
+          index = (first + i) % zygotes.size();
+          lock = std::unique_lock{zygotes[index]->mutex, std::try_to_lock};
+        }
+        if (!lock.owns_lock()) {
+          index = first;
+          lock = std::unique_lock{zygotes[index]->mutex};
+        }
+        auto& zygote = *zygotes[index];
+        auto [pid, pidfd] = ZygotePool::exchange(zygote, request, fds);
+        if (pid == 0 || pid == -EPIPE) {
+          //! the zygote has exited => it is replaced
+          ZygotePool::stop(zygote);
+          auto ret = ZygotePool::start(this->state_->plan, zygote);
+          if (ret == Process::CreateError::NO_ERROR) {
+            ret = ZygotePool::ready(zygote);
+          }
+          if (pid == -EPIPE) {
+            //! the process may have been launched => the request is not sent
+            //!     again, a failed restart is retried by the next launch
+            return std::make_tuple(pid, -1);
+          }
+          if (ret != Process::CreateError::NO_ERROR) {
+            return std::make_tuple(-static_cast<std::int64_t>(ret), -1);
+          }
+          std::tie(pid, pidfd) = ZygotePool::exchange(zygote, request, fds);
+        }
+        return std::make_tuple(pid, pidfd);
+      }
+  );
+}
+
+template <class Exchange>
+std::variant<Process, Process::CreateError> ZygotePool::launchWith(
+    const Executable& executable,
+    const Stdio& stdio,
+    Exchange&& exchange
+) {
+  int pipes[3];
+  int sources[3];
+  bool owned[3];
+  if (
+      const auto ret = Process::openStdio(stdio, pipes, sources, owned);
+      ret != Process::CreateError::NO_ERROR
+  ) {
+    return ret;
+  }
+  const auto release = [&pipes, &sources, &owned]() {
+    for (auto i = 0; i < 3; i++) {
+      if (owned[i]) {
+        ::close(sources[i]);
+      }
+      if (pipes[i] >= 0) {
+        ::close(pipes[i]);
+      }
+    }
+  };
+  auto targets = std::vector<int>{};
+  auto fds = std::vector<int>{};
+  targets.reserve(3 + stdio.fds.size());
+  fds.reserve(3 + stdio.fds.size());
+  for (auto i = 0; i < 3; i++) {
+    if (sources[i] >= 0) {
+      targets.push_back(i);
+      fds.push_back(sources[i]);
+    }
+  }
+  for (const auto& [target, source] : stdio.fds) {
+    if (target < 0 || source < 0) {
+      release();
+      return Process::CreateError::INVAL;
+    }
+    targets.push_back(target);
+    fds.push_back(source);
+  }
+  if (fds.size() > MAX_FDS_) {
+    release();
+    return Process::CreateError::INVAL;
+  }
+  const auto request = ZygotePool::requestOf(executable, targets);
+  const auto [pid, pidfd] =
+      exchange(std::string_view{request}, std::span{fds});
+  //! the launched process has its own copies => close the ends of this process
+  for (auto i = 0; i < 3; i++) {
+    if (owned[i]) {
+      ::close(sources[i]);
+      owned[i] = false;
+    }
+  }
+  if (pid <= 0) {
+    release();
+    return pid == 0 ?
+        Process::CreateError::AGAIN : static_cast<Process::CreateError>(-pid);
+  }
+  auto process = Process{};
+  process.pid_ = static_cast<unsigned>(pid);
+  //! opened from the pid only if the zygote could not pass it
+  process.pidfd_ = pidfd >= 0 ?
+      pidfd : Process::pidfdOf(static_cast<pid_t>(pid));
+  process.stdinPipe_ = pipes[0];
+  process.stdoutPipe_ = pipes[1];
+  process.stderrPipe_ = pipes[2];
+  return process;
+}
+
+inline std::size_t ZygotePool::size() const {
+  return this->state_ == nullptr ? 0 : this->state_->zygotes.size();
+}
+
+inline ZygotePool::ZygotePool(std::unique_ptr<State> state)
+  : state_{std::move(state)}
+{}
+
+inline Process::CreateError ZygotePool::start(
+    const ExecPlan& plan,
+    Zygote& zygote
+) {
+  int sockets[2];
+  if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) {
+    return static_cast<Process::CreateError>(errno);
+  }
+  auto created = Process::create(
+      plan,
+      Stdio{
+        .in = Redirection::inherit(),
+        .out = Redirection::inherit(),
+        .err = Redirection::inherit(),
+        .fds = { { CONTROL_FD_, sockets[1], }, },
+      }
+  );
+  ::close(sockets[1]);
+  if (std::holds_alternative<Process::CreateError>(created)) {
+    ::close(sockets[0]);
+    return std::get<Process::CreateError>(created);
+  }
+  zygote.process = std::get<Process>(std::move(created));
+  zygote.socket = sockets[0];
+  return Process::CreateError::NO_ERROR;
+}
+
+inline Process::CreateError ZygotePool::ready(Zygote& zygote) {
+  auto value = std::int64_t{-1};
+  auto bytes = ssize_t{0};
+  do {
+    bytes = ::recv(zygote.socket, &value, sizeof(value), 0);
+  } while (bytes < 0 && errno == EINTR);
+  return bytes == sizeof(value) && value == 0 ?
+      Process::CreateError::NO_ERROR : Process::CreateError::AGAIN;
+}
+
+inline void ZygotePool::stop(Zygote& zygote) {
+  ::close(std::exchange(zygote.socket, -1));
+  if (zygote.process.pid() != 0) {
+    zygote.process.wait();
+  }
+}
+
+inline std::tuple<std::int64_t, int> ZygotePool::exchange(
+    Zygote& zygote,
+    std::string_view request,
+    std::span<const int> fds
+) {
+  //! a failed restart leaves no socket => the restart is retried
+  if (zygote.socket < 0) {
+    return { 0, -1, };
+  }
+  if (ZygotePool::sendMessage(zygote.socket, request, fds) != 0) {
+    return {
+      errno == EPIPE || errno == ECONNRESET || errno == ENOTCONN ? 0 : -errno,
+      -1,
+    };
+  }
+  auto value = std::int64_t{0};
+  auto vector = iovec{ .iov_base = &value, .iov_len = sizeof(value), };
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  auto header = msghdr{};
+  header.msg_iov = &vector;
+  header.msg_iovlen = 1;
+  header.msg_control = control;
+  header.msg_controllen = sizeof(control);
+  auto bytes = ssize_t{0};
+  do {
+    bytes = ::recvmsg(zygote.socket, &header, MSG_CMSG_CLOEXEC);
+  } while (bytes < 0 && errno == EINTR);
+  auto pidfd = -1;
+  for (
+      auto* received = bytes > 0 ? CMSG_FIRSTHDR(&header) : nullptr;
+      received != nullptr;
+      received = CMSG_NXTHDR(&header, received)
+  ) {
+    if (
+        received->cmsg_level == SOL_SOCKET &&
+        received->cmsg_type == SCM_RIGHTS &&
+        received->cmsg_len == CMSG_LEN(sizeof(int))
+    ) {
+      std::memcpy(&pidfd, CMSG_DATA(received), sizeof(int));
+    }
+  }
+  if (bytes != sizeof(value) || value <= 0) {
+    if (pidfd >= 0) {
+      ::close(pidfd);
+    }
+    //! the request has been sent => it is not to be sent again
+    return { bytes == sizeof(value) ? value : -EPIPE, -1, };
+  }
+  return { value, pidfd, };
+}
+
+inline std::string ZygotePool::requestOf(
+    const Executable& executable,
+    std::span<const int> targets
+) {
+  const std::uint32_t counts[] = {
+    static_cast<std::uint32_t>(executable.arguments.size()),
+    static_cast<std::uint32_t>(executable.environment.size()),
+    static_cast<std::uint32_t>(targets.size()),
+  };
+  auto size = sizeof(counts) + targets.size() * sizeof(std::int32_t) +
+      executable.binary.native().size() + 1;
+  for (const auto& argument : executable.arguments) {
+    size += argument.size() + 1;
+  }
+  for (const auto& [key, value] : executable.environment) {
+    size += key.size() + value.size() + 2;
+  }
+  auto request = std::string{};
+  request.reserve(size);
+  request.append(reinterpret_cast<const char*>(counts), sizeof(counts));
+  for (const auto& target : targets) {
+    const auto value = static_cast<std::int32_t>(target);
+    request.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  request.append(executable.binary.native()).push_back('\0');
+  for (const auto& argument : executable.arguments) {
+    request.append(argument).push_back('\0');
+  }
+  for (const auto& [key, value] : executable.environment) {
+    request.append(key).append(1, '=').append(value).push_back('\0');
+  }
+  return request;
+}
+
+inline std::optional<Executable> ZygotePool::executableOf(
+    std::span<const char> request,
+    const std::size_t& fdCount,
+    std::vector<int>& targets
+) {
+  std::uint32_t counts[3];
+  if (request.size() < sizeof(counts)) {
+    return std::nullopt;
+  }
+  std::memcpy(counts, request.data(), sizeof(counts));
+  request = request.subspan(sizeof(counts));
+  if (
+      counts[2] != fdCount ||
+      request.size() < counts[2] * sizeof(std::int32_t)
+  ) {
+    return std::nullopt;
+  }
+  targets.resize(counts[2]);
+  for (auto& target : targets) {
+    auto value = std::int32_t{0};
+    std::memcpy(&value, request.data(), sizeof(value));
+    target = value;
+    request = request.subspan(sizeof(value));
+  }
+  //! takes the next NUL-terminated string
+  const auto next = [&request]() -> std::optional<std::string_view> {
+    const auto end = std::find(request.begin(), request.end(), '\0');
+    if (end == request.end()) {
+      return std::nullopt;
+    }
+    const auto value = std::string_view{
+        request.data(), static_cast<std::size_t>(end - request.begin())
+    };
+    request = request.subspan(value.size() + 1);
+    return value;
+  };
+  auto executable = Executable{};
+  const auto binary = next();
+  if (!binary.has_value()) {
+    return std::nullopt;
+  }
+  executable.binary = *binary;
+  executable.arguments.reserve(counts[0]);
+  for (auto i = std::uint32_t{0}; i < counts[0]; i++) {
+    const auto argument = next();
+    if (!argument.has_value()) {
+      return std::nullopt;
+    }
+    executable.arguments.emplace_back(*argument);
+  }
+  for (auto i = std::uint32_t{0}; i < counts[1]; i++) {
+    const auto variable = next();
+    if (!variable.has_value()) {
+      return std::nullopt;
+    }
+    const auto separator = variable->find('=');
+    if (separator == std::string_view::npos) {
+      return std::nullopt;
+    }
+    executable.environment.emplace(
+        variable->substr(0, separator), variable->substr(separator + 1)
+    );
+  }
+  return executable;
+}
+
+inline int ZygotePool::sendMessage(
+    const int& socket,
+    std::string_view message,
+    std::span<const int> fds
+) {
+  auto vector = iovec{
+    .iov_base = const_cast<char*>(message.data()),
+    .iov_len = message.size(),
+  };
+  auto header = msghdr{};
+  header.msg_iov = &vector;
+  header.msg_iovlen = 1;
+  //! no memory is allocated for the usual stdin, stdout and stderr
+  alignas(cmsghdr) char buffer[CMSG_SPACE(sizeof(int) * 3)];
+  auto allocated = std::vector<cmsghdr>{};
+  if (!fds.empty()) {
+    const auto space = CMSG_SPACE(sizeof(int) * fds.size());
+    auto* control = static_cast<void*>(buffer);
+    if (space > sizeof(buffer)) {
+      allocated.resize(space / sizeof(cmsghdr) + 1);
+      control = allocated.data();
+    }
+    header.msg_control = control;
+    header.msg_controllen = space;
+    auto* message = CMSG_FIRSTHDR(&header);
+    message->cmsg_level = SOL_SOCKET;
+    message->cmsg_type = SCM_RIGHTS;
+    message->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    std::memcpy(CMSG_DATA(message), fds.data(), sizeof(int) * fds.size());
+  }
+  auto bytes = ssize_t{0};
+  do {
+    bytes = ::sendmsg(socket, &header, MSG_NOSIGNAL);
+  } while (bytes < 0 && errno == EINTR);
+  return bytes < 0 ? -1 : 0;
+}
+
+inline bool ZygotePool::reply(
+    const int& socket,
+    const std::int64_t& value,
+    const int& pidfd
+) {
+  const auto message = std::string_view{
+    reinterpret_cast<const char*>(&value), sizeof(value),
+  };
+  return ZygotePool::sendMessage(
+      socket,
+      message,
+      pidfd >= 0 ? std::span{&pidfd, 1} : std::span<const int>{}
+  ) == 0;
+}
+
+inline int ZygotePool::receiveMessage(
+    const int& socket,
+    std::vector<char>& message,
+    std::vector<int>& fds
+) {
+  fds.clear();
+  //! the size of the next message is peeked => the buffer fits the message
+  auto size = ssize_t{0};
+  do {
+    size = ::recv(socket, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+  } while (size < 0 && errno == EINTR);
+  if (size <= 0) {
+    if (size == 0) {
+      errno = EPIPE;
+    }
+    return -1;
+  }
+  message.resize(static_cast<std::size_t>(size));
+  auto vector = iovec{
+    .iov_base = message.data(),
+    .iov_len = message.size(),
+  };
+  auto control = std::vector<cmsghdr>(
+      CMSG_SPACE(sizeof(int) * MAX_FDS_) / sizeof(cmsghdr) + 1
+  );
+  auto header = msghdr{};
+  header.msg_iov = &vector;
+  header.msg_iovlen = 1;
+  header.msg_control = control.data();
+  header.msg_controllen = control.size() * sizeof(cmsghdr);
+  auto bytes = ssize_t{0};
+  do {
+    bytes = ::recvmsg(socket, &header, MSG_CMSG_CLOEXEC);
+  } while (bytes < 0 && errno == EINTR);
+  if (bytes <= 0) {
+    if (bytes == 0) {
+      errno = EPIPE;
+    }
+    return -1;
+  }
+  for (
+      auto* received = CMSG_FIRSTHDR(&header);
+      received != nullptr;
+      received = CMSG_NXTHDR(&header, received)
+  ) {
+    if (
+        received->cmsg_level == SOL_SOCKET &&
+        received->cmsg_type == SCM_RIGHTS
+    ) {
+      const auto count = (received->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      const auto offset = fds.size();
+      fds.resize(offset + count);
+      std::memcpy(
+          fds.data() + offset, CMSG_DATA(received), count * sizeof(int)
+      );
+    }
+  }
+  message.resize(static_cast<std::size_t>(bytes));
+  return 0;
+}
+
+inline pid_t ZygotePool::cloneSibling(
+    const std::uint64_t& flags,
+    int* pidfd
+) {
+  if (pidfd != nullptr) {
+    *pidfd = -1;
+  }
+#if __has_include(<linux/sched.h>) && defined(CLONE_PARENT)
+#ifdef SYS_clone3
+  //! the exit signal of a sibling is the one of the zygote (SIGCHLD) =>
+  //!     clone_args::exit_signal is ignored for CLONE_PARENT
+  auto args = clone_args{};
+  args.flags = CLONE_PARENT | flags;
+#ifdef CLONE_PIDFD
+  if (pidfd != nullptr) {
+    //! opened in the zygote with FD_CLOEXEC => passed to this process
+    args.flags |= CLONE_PIDFD;
+    args.pidfd = reinterpret_cast<std::uintptr_t>(pidfd);
+  }
+#endif
+  const auto pid = ::syscall(SYS_clone3, &args, sizeof(args));
+  if (pid >= 0 || errno != ENOSYS) {
+    return static_cast<pid_t>(pid);
+  }
+#endif
+  //! no stack => the child continues on its own copy of the stack as fork()
+  return static_cast<pid_t>(
+      ::syscall(SYS_clone, CLONE_PARENT | flags, 0, 0, 0, 0)
+  );
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+#endif
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_ZYGOTE_POOL_HH_
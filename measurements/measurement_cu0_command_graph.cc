@@ -0,0 +1,83 @@
+#include <cu0/proc/command_graph.hh>
+#include <cu0/proc/command_runner.hh>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_command_graph will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/epoll.h>) || \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<signal.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/epoll.h> or <sys/types.h> or <sys/wait.h> or <signal.h> \
+    or <unistd.h> is not found => \
+    measurement_cu0_command_graph will be hollow
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds{std::stoi(argv[1])}
+    );
+    return 0;
+  }
+  //! creates an executable sleeping for the milliseconds
+  const auto sleep = [&argv](const int& milliseconds) {
+    return cu0::Executable{
+      .binary = argv[0],
+      .arguments = { std::to_string(milliseconds), },
+    };
+  };
+  //! short chains of two nodes and a long node added last =>
+  //!     the long node is the last one without estimates
+  auto graph = cu0::CommandGraph{};
+  auto work = std::chrono::milliseconds{0};
+  for (auto i = 0; i < 8; i++) {
+    const auto first = std::get<std::size_t>(graph.add(sleep(15)));
+    static_cast<void>(graph.add(sleep(15), std::vector{ first, }));
+    work += std::chrono::milliseconds{30};
+  }
+  static_cast<void>(graph.add(sleep(200)));
+  work += std::chrono::milliseconds{200};
+  constexpr auto CONCURRENCY = std::size_t{2};
+  auto created = cu0::CommandRunner::create(CONCURRENCY);
+  if (!std::holds_alternative<cu0::CommandRunner>(created)) {
+    return 1;
+  }
+  auto& runner = std::get<cu0::CommandRunner>(created);
+  std::cout << "run,total_ms,lower_bound_ms" << '\n';
+  for (const auto& name : { "without estimates", "with estimates", }) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto results = graph.run(runner);
+    const auto end = std::chrono::steady_clock::now();
+    for (const auto& result : results) {
+      if (result.exitCode != 0) {
+        return 1;
+      }
+    }
+    //! neither the longest path nor the work per process can be shortened
+    const auto bound = std::max(
+        std::chrono::duration<double, std::milli>(work).count() / CONCURRENCY,
+        200.0
+    );
+    std::cout << name << "," <<
+        std::chrono::duration<double, std::milli>(end - start).count() <<
+        "," << bound << '\n';
+    //! the next run uses the durations of this run
+    graph.updateEstimates(results);
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,127 @@
+#include <cu0/proc/command_runner.hh>
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_command_runner will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/epoll.h>) || \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<signal.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/epoll.h> or <sys/types.h> or <sys/wait.h> or <signal.h> \
+    or <unistd.h> is not found => \
+    measurement_cu0_command_runner will be hollow
+int main() {}
+#else
+
+//! runs the executables with the concurrency
+using Run = std::function<bool(
+    const std::vector<cu0::Executable>&,
+    const std::size_t&
+)>;
+
+/*!
+ * @brief creates the specified executables and waits for them in batches
+ * @param executables are the executables
+ * @param concurrency is the size of a batch
+ * @return true if all the processes have been created
+ */
+bool runBatches(
+    const std::vector<cu0::Executable>& executables,
+    const std::size_t& concurrency
+) {
+  for (auto i = std::size_t{0}; i < executables.size(); i += concurrency) {
+    auto processes = std::vector<cu0::Process>{};
+    for (
+        auto j = i;
+        j < std::min(i + concurrency, executables.size());
+        j++
+    ) {
+      auto created = cu0::Process::create(executables[j]);
+      if (!std::holds_alternative<cu0::Process>(created)) {
+        return false;
+      }
+      processes.push_back(std::get<cu0::Process>(std::move(created)));
+    }
+    //! the next batch waits for the slowest process of this batch
+    for (auto& process : processes) {
+      process.wait();
+    }
+  }
+  return true;
+}
+
+/*!
+ * @brief runs the specified executables by a command runner
+ * @param executables are the executables
+ * @param concurrency is the maximal number of processes at a time
+ * @return true if all the processes have exited with 0
+ */
+bool runRunner(
+    const std::vector<cu0::Executable>& executables,
+    const std::size_t& concurrency
+) {
+  auto created = cu0::CommandRunner::create(concurrency);
+  if (!std::holds_alternative<cu0::CommandRunner>(created)) {
+    return false;
+  }
+  const auto results =
+      std::get<cu0::CommandRunner>(created).run(executables);
+  for (const auto& result : results) {
+    if (result.exitCode != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds{std::stoi(argv[1])}
+    );
+    return 0;
+  }
+  //! durations vary => a batch waits for its slowest process
+  constexpr auto N = std::size_t{200};
+  auto executables = std::vector<cu0::Executable>{};
+  for (auto i = std::size_t{0}; i < N; i++) {
+    executables.push_back(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { std::to_string(i % 7 == 0 ? 40 : 2), },
+        }
+    );
+  }
+  const auto methods = {
+    std::make_tuple("batches", Run{runBatches}),
+    std::make_tuple("CommandRunner::run", Run{runRunner}),
+  };
+  std::cout << "method,concurrency,total_ms" << '\n';
+  for (const auto& concurrency : { std::size_t{4}, std::size_t{16}, }) {
+    for (const auto& [name, run] : methods) {
+      const auto start = std::chrono::steady_clock::now();
+      if (!run(executables, concurrency)) {
+        return 1;
+      }
+      const auto end = std::chrono::steady_clock::now();
+      std::cout << name << "," << concurrency << "," <<
+          std::chrono::duration<double, std::milli>(end - start).count() <<
+          '\n';
+    }
+  }
+}
+
+#endif
+#endif
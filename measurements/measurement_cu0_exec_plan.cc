@@ -0,0 +1,61 @@
+#include <cu0/proc/exec_plan.hh>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main() {
+  constexpr auto N = 2 << 13;
+  auto executable = cu0::Executable{
+    .binary = "/usr/bin/someExecutable",
+    .arguments = { "--input", "input0", "--output", "output0", "--verbose", },
+    .environment = {
+      { "HOME", "/home/user", },
+      { "PATH", "/usr/local/bin:/usr/bin:/bin", },
+      { "LANG", "C.UTF-8", },
+    },
+  };
+  std::size_t sink = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < N; i++) {
+    executable.arguments[1] = "input" + std::to_string(i);
+    const auto [argv, argvSize] = cu0::util::argvOf(executable);
+    const auto [envp, envpSize] = cu0::util::envpOf(executable);
+    auto argvRaw = std::make_unique<char*[]>(argvSize);
+    for (auto j = 0u; j < argvSize; j++) {
+      argvRaw[j] = argv[j].get();
+    }
+    auto envpRaw = std::make_unique<char*[]>(envpSize);
+    for (auto j = 0u; j < envpSize; j++) {
+      envpRaw[j] = envp[j].get();
+    }
+    sink += argvRaw[2][5] + envpRaw[0][0];
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "cu0::util::argvOf() + cu0::util::envpOf(): " <<
+      static_cast<double>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              end - start
+          ).count()
+      ) / N << "ns" << '\n';
+  auto plan = cu0::ExecPlan{executable};
+  plan.reserve(plan.size() * 2);
+  auto input = std::string{"input"};
+  input.reserve(32);
+  start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < N; i++) {
+    input.resize(5);
+    for (auto j = i; j > 0 || input.size() == 5; j /= 10) {
+      input.push_back(static_cast<char>('0' + j % 10));
+    }
+    plan.argument(1, input);
+    sink += plan.argv()[2][5] + plan.envp()[0][0];
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::cout << "cu0::ExecPlan::argument(): " <<
+      static_cast<double>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              end - start
+          ).count()
+      ) / N << "ns" << '\n';
+  return sink == 0;
+}
@@ -0,0 +1,271 @@
+#include <cu0/proc/process.hh>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_create will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<poll.h>)
+#warning <sys/types.h> or <sys/wait.h> or <unistd.h> or <poll.h> is not \
+    found => measurement_cu0_process_create will be hollow
+int main() {}
+#else
+
+/*!
+ * usage: measurement_cu0_process_create
+ *     [--format=csv|json]
+ *     [--rss=<size>[,<size>...]] (e.g. --rss=0,100M,1G,8G)
+ *     [--threads=<count>[,<count>...]] (e.g. --threads=1,8,64)
+ *     [--spawns=<count>]
+ * @note every combination of a spawn strategy, a parent resident set size
+ *     and a parent thread count is measured
+ */
+
+/*!
+ * @brief The Result struct contains the measurement of one combination
+ */
+struct Result {
+  //! name of the spawn strategy
+  std::string strategy{};
+  //! touched memory of the parent in bytes
+  std::size_t rss = 0;
+  //! number of parent threads including the spawning one
+  std::size_t threads = 0;
+  //! number of measured spawns
+  std::size_t spawns = 0;
+  //! sorted latencies of Process::create() + Process::wait()
+  std::vector<std::chrono::nanoseconds> latencies{};
+  //! spawns per second when the spawns are not waited one by one
+  double throughput = 0;
+};
+
+/*!
+ * @brief measures the latency of Process::create() + Process::wait()
+ *     one by one and the throughput of Process::create() in a batch
+ *     followed by Process::waitAll()
+ * @param executable is the executable to be run
+ * @param strategy is the spawn strategy to be measured
+ * @param n is the number of measured spawns
+ * @param result is filled by the measurement
+ * @return false if a spawn fails
+ */
+bool measure(
+    const cu0::Executable& executable,
+    const cu0::Process::SpawnStrategy& strategy,
+    const std::size_t& n,
+    Result& result
+) {
+  //! reused => the allocation is not measured
+  const auto plan = cu0::ExecPlan{executable};
+  result.latencies.clear();
+  result.latencies.reserve(n);
+  for (auto i = std::size_t{0}; i < n; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    auto created = cu0::Process::create(plan, strategy);
+    if (!std::holds_alternative<cu0::Process>(created)) {
+      return false;
+    }
+    std::get<cu0::Process>(created).wait();
+    const auto end = std::chrono::steady_clock::now();
+    result.latencies.push_back(end - start);
+  }
+  std::sort(result.latencies.begin(), result.latencies.end());
+  auto processes = std::vector<cu0::Process>{};
+  processes.reserve(n);
+  const auto start = std::chrono::steady_clock::now();
+  for (auto i = std::size_t{0}; i < n; i++) {
+    auto created = cu0::Process::create(plan, strategy);
+    if (!std::holds_alternative<cu0::Process>(created)) {
+      cu0::Process::waitAll(processes);
+      return false;
+    }
+    processes.push_back(std::get<cu0::Process>(std::move(created)));
+  }
+  cu0::Process::waitAll(processes);
+  const auto end = std::chrono::steady_clock::now();
+  result.spawns = n;
+  result.throughput = static_cast<double>(n) /
+      std::chrono::duration<double>(end - start).count();
+  return true;
+}
+
+/*!
+ * @brief accesses the specified percentile of sorted latencies
+ * @param latencies are sorted latencies
+ * @param percentile is the percentile in [0, 100]
+ * @return latency in microseconds
+ */
+double percentileOf(
+    const std::vector<std::chrono::nanoseconds>& latencies,
+    const double& percentile
+) {
+  if (latencies.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<std::size_t>(
+      percentile / 100 * static_cast<double>(latencies.size() - 1) + 0.5
+  );
+  return std::chrono::duration<double, std::micro>(latencies[index]).count();
+}
+
+/*!
+ * @brief parses a comma separated list of sizes with optional K, M, G suffixes
+ * @param list is the list to be parsed
+ * @return parsed sizes
+ */
+std::vector<std::size_t> sizesOf(const std::string& list) {
+  auto ret = std::vector<std::size_t>{};
+  auto begin = std::size_t{0};
+  while (begin < list.size()) {
+    auto end = list.find(',', begin);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    auto item = list.substr(begin, end - begin);
+    auto shift = 0;
+    switch (item.empty() ? '\0' : item.back()) {
+    case 'K': shift = 10; break;
+    case 'M': shift = 20; break;
+    case 'G': shift = 30; break;
+    }
+    if (shift != 0) {
+      item.pop_back();
+    }
+    ret.push_back(std::stoull(item) << shift);
+    begin = end + 1;
+  }
+  return ret;
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1 && std::string{argv[1]} == "child") {
+    return 0;
+  }
+  auto json = false;
+  auto rssSizes = std::vector<std::size_t>{ 0, 100 << 20, 1 << 30, };
+  auto threadCounts = std::vector<std::size_t>{ 1, 8, };
+  auto spawns = std::size_t{256};
+  for (auto i = 1; i < argc; i++) {
+    const auto argument = std::string{argv[i]};
+    const auto value = argument.substr(argument.find('=') + 1);
+    if (argument.starts_with("--format=")) {
+      json = value == "json";
+    } else if (argument.starts_with("--rss=")) {
+      rssSizes = sizesOf(value);
+    } else if (argument.starts_with("--threads=")) {
+      threadCounts = sizesOf(value);
+    } else if (argument.starts_with("--spawns=")) {
+      spawns = std::max<std::size_t>(std::stoull(value), 1);
+    } else {
+      std::cerr << "unknown argument: " << argument << '\n';
+      return 1;
+    }
+  }
+  const auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"child"},
+  };
+  const auto strategies = {
+    std::make_tuple(cu0::Process::SpawnStrategy::VFORK, "VFORK"),
+    std::make_tuple(cu0::Process::SpawnStrategy::FORK, "FORK"),
+    std::make_tuple(cu0::Process::SpawnStrategy::POSIX_SPAWN, "POSIX_SPAWN"),
+    std::make_tuple(cu0::Process::SpawnStrategy::CLONE, "CLONE"),
+  };
+  auto results = std::vector<Result>{};
+  for (const auto& rss : rssSizes) {
+    //! touched => the pages are mapped and have to be handled by the spawn
+    auto memory = std::vector<char>{};
+    memory.resize(rss);
+    std::memset(memory.data(), 1, memory.size());
+    for (const auto& threadCount : threadCounts) {
+      //! idle threads sharing the address space of the parent
+      auto mutex = std::mutex{};
+      auto stopped = std::condition_variable{};
+      auto stop = false;
+      auto threads = std::vector<std::thread>{};
+      for (auto i = std::size_t{1}; i < threadCount; i++) {
+        threads.emplace_back([&mutex, &stopped, &stop]() {
+          auto lock = std::unique_lock{mutex};
+          stopped.wait(lock, [&stop]() { return stop; });
+        });
+      }
+      for (const auto& [strategy, name] : strategies) {
+        auto result = Result{
+          .strategy = name,
+          .rss = rss,
+          .threads = threadCount,
+        };
+        if (!measure(executable, strategy, spawns, result)) {
+          result.latencies.clear();
+        }
+        results.push_back(std::move(result));
+      }
+      {
+        const auto lock = std::lock_guard{mutex};
+        stop = true;
+      }
+      stopped.notify_all();
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+  }
+  if (json) {
+    std::cout << "[" << '\n';
+  } else {
+    std::cout << "strategy,rss_bytes,threads,spawns," <<
+        "p50_us,p90_us,p99_us,max_us,spawns_per_s" << '\n';
+  }
+  for (auto i = std::size_t{0}; i < results.size(); i++) {
+    const auto& result = results[i];
+    const auto supported = !result.latencies.empty();
+    if (json) {
+      std::cout << "  {" <<
+          "\"strategy\": \"" << result.strategy << "\", " <<
+          "\"rss_bytes\": " << result.rss << ", " <<
+          "\"threads\": " << result.threads << ", " <<
+          "\"supported\": " << (supported ? "true" : "false");
+      if (supported) {
+        std::cout << ", " <<
+            "\"spawns\": " << result.spawns << ", " <<
+            "\"p50_us\": " << percentileOf(result.latencies, 50) << ", " <<
+            "\"p90_us\": " << percentileOf(result.latencies, 90) << ", " <<
+            "\"p99_us\": " << percentileOf(result.latencies, 99) << ", " <<
+            "\"max_us\": " << percentileOf(result.latencies, 100) << ", " <<
+            "\"spawns_per_s\": " << result.throughput;
+      }
+      std::cout << "}" << (i + 1 < results.size() ? "," : "") << '\n';
+    } else if (supported) {
+      std::cout << result.strategy << "," << result.rss << "," <<
+          result.threads << "," << result.spawns << "," <<
+          percentileOf(result.latencies, 50) << "," <<
+          percentileOf(result.latencies, 90) << "," <<
+          percentileOf(result.latencies, 99) << "," <<
+          percentileOf(result.latencies, 100) << "," <<
+          result.throughput << '\n';
+    } else {
+      std::cout << result.strategy << "," << result.rss << "," <<
+          result.threads << ",<not-supported>,,,,," << '\n';
+    }
+  }
+  if (json) {
+    std::cout << "]" << '\n';
+  }
+}
+
+#endif
+#endif
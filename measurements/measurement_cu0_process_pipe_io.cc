@@ -0,0 +1,145 @@
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_pipe_io will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/types.h> or <sys/wait.h> or <unistd.h> is not found => \
+    measurement_cu0_process_pipe_io will be hollow
+int main() {}
+#else
+
+/*!
+ * @brief counts read() and write() like system calls done by this process
+ * @note the counters are taken from /proc/self/io
+ * @return tuple of read and write system call counts (-1 if not available)
+ */
+std::tuple<long long, long long> syscallsOf() {
+  auto io = std::ifstream{"/proc/self/io"};
+  auto reads = -1ll;
+  auto writes = -1ll;
+  auto key = std::string{};
+  auto value = 0ll;
+  while (io >> key >> value) {
+    if (key == "syscr:") {
+      reads = value;
+    } else if (key == "syscw:") {
+      writes = value;
+    }
+  }
+  return { reads, writes, };
+}
+
+/*!
+ * @brief measures one transfer between this process and a child
+ * @param binary is the path to this measurement
+ * @param arguments are the arguments of the child
+ * @param size is the number of transferred bytes
+ * @param transfer feeds or captures the process
+ * @return tuple of throughput in MB/s and system calls per MB
+ *     (negative if not available)
+ */
+std::tuple<double, double> measure(
+    const std::string& binary,
+    const std::vector<std::string>& arguments,
+    const std::size_t& size,
+    const std::function<void(cu0::Process&)>& transfer
+) {
+  auto created = cu0::Process::create(cu0::Executable{
+    .binary = binary,
+    .arguments = arguments,
+  });
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return { 0, 0, };
+  }
+  auto& process = std::get<cu0::Process>(created);
+  const auto [readsBefore, writesBefore] = syscallsOf();
+  const auto start = std::chrono::steady_clock::now();
+  transfer(process);
+  const auto end = std::chrono::steady_clock::now();
+  const auto [readsAfter, writesAfter] = syscallsOf();
+  process.closeStdin();
+  process.wait();
+  const auto megabytes = static_cast<double>(size) / 1e6;
+  //! one read of /proc/self/io is counted too
+  const auto syscalls = readsBefore < 0 ? -1.0 : static_cast<double>(
+      (readsAfter - readsBefore) + (writesAfter - writesBefore) - 1
+  );
+  return {
+    megabytes / std::chrono::duration<double>(end - start).count(),
+    syscalls < 0 ? -1.0 : syscalls / megabytes,
+  };
+}
+
+/*!
+ * @brief measures Process::stdin() and Process::stdout() with the specified
+ *     buffer size for all the payload sizes
+ * @tparam BUFFER_SIZE is the buffer size to be measured
+ * @param binary is the path to this measurement
+ */
+template <std::size_t BUFFER_SIZE>
+void sweep(const std::string& binary) {
+  for (const auto& size : { std::size_t{1} << 20, std::size_t{64} << 20, }) {
+    const auto input = std::string(size, 'x');
+    const auto [stdinThroughput, stdinSyscalls] = measure(
+        binary, {"discard"}, size, [&input](cu0::Process& process) {
+          process.stdin<BUFFER_SIZE>(input);
+        }
+    );
+    auto captured = std::size_t{0};
+    const auto [stdoutThroughput, stdoutSyscalls] = measure(
+        binary, {"produce", std::to_string(size)}, size,
+        [&captured](cu0::Process& process) {
+          captured = process.stdout<BUFFER_SIZE>().size();
+        }
+    );
+    std::cout << "stdin," << BUFFER_SIZE << "," << size << "," <<
+        stdinThroughput << "," << stdinSyscalls << '\n';
+    std::cout << "stdout," << BUFFER_SIZE << "," << captured << "," <<
+        stdoutThroughput << "," << stdoutSyscalls << '\n';
+  }
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    char buffer[1 << 16];
+    if (std::string{argv[1]} == "discard") {
+      while (::read(STDIN_FILENO, buffer, sizeof(buffer)) > 0) {}
+      return 0;
+    }
+    auto size = std::stoull(argv[2]);
+    std::fill(std::begin(buffer), std::end(buffer), 'x');
+    while (size > 0) {
+      const auto bytes = ::write(
+          STDOUT_FILENO, buffer, std::min<std::size_t>(size, sizeof(buffer))
+      );
+      if (bytes <= 0) {
+        return 1;
+      }
+      size -= bytes;
+    }
+    return 0;
+  }
+  std::cout << "direction,buffer_bytes,payload_bytes,mb_per_s," <<
+      "syscalls_per_mb" << '\n';
+  sweep<std::size_t{1} << 10>(argv[0]);
+  sweep<std::size_t{4} << 10>(argv[0]);
+  sweep<std::size_t{16} << 10>(argv[0]);
+  sweep<std::size_t{64} << 10>(argv[0]);
+  sweep<std::size_t{256} << 10>(argv[0]);
+  sweep<std::size_t{1} << 20>(argv[0]);
+}
+
+#endif
+#endif
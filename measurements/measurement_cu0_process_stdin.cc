@@ -0,0 +1,108 @@
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_stdin will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<sys/uio.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/types.h> or <sys/wait.h> or <sys/uio.h> or <unistd.h> is not \
+    found => measurement_cu0_process_stdin will be hollow
+int main() {}
+#else
+
+/*!
+ * @brief writes the input the way Process::stdin() did before it became
+ *     copy-free: substr() + copy into a 1 KiB stack buffer + write()
+ * @param pipe is the pipe to write into
+ * @param input is the data to write
+ */
+void legacyWriteInto(const int& pipe, const std::string& input) {
+  constexpr auto BUFFER_SIZE = std::size_t{1024};
+  char buffer[BUFFER_SIZE];
+  for (auto i = 0u; i <= input.size() / BUFFER_SIZE; i++) {
+    const auto data = input.substr(i * BUFFER_SIZE, BUFFER_SIZE);
+    const auto end = data.size();
+    for (auto j = 0u; j < end; j++) {
+      buffer[j] = data[j];
+    }
+    auto bytes = std::size_t{0};
+    while (bytes < end) {
+      const auto writeResult = ::write(pipe, buffer + bytes, end - bytes);
+      if (writeResult < 0) {
+        return;
+      }
+      bytes += writeResult;
+    }
+  }
+}
+
+/*!
+ * @brief measures throughput of feeding a child which discards its stdin
+ * @param binary is the path to this measurement
+ * @param size is the number of bytes to feed
+ * @param feed writes the input into the process
+ * @return throughput in MB/s
+ */
+double measure(
+    const std::string& binary,
+    const std::size_t& size,
+    const std::function<void(cu0::Process&)>& feed
+) {
+  auto created = cu0::Process::create(cu0::Executable{
+    .binary = binary,
+    .arguments = {"discard"},
+  });
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return 0;
+  }
+  auto& process = std::get<cu0::Process>(created);
+  const auto start = std::chrono::high_resolution_clock::now();
+  feed(process);
+  process.closeStdin();
+  process.wait();
+  const auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(size) / 1e6 /
+      std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    char buffer[1 << 16];
+    while (::read(STDIN_FILENO, buffer, sizeof(buffer)) > 0) {}
+    return 0;
+  }
+  constexpr auto SIZE = std::size_t{100} << 20;
+  const auto input = std::string(SIZE, 'x');
+  std::cout << "legacy substr() + copy + write(): " <<
+      measure(argv[0], SIZE, [&input](cu0::Process& process) {
+        legacyWriteInto(process.stdinPipe(), input);
+      }) << "MB/s" << '\n';
+  std::cout << "cu0::Process::stdin(std::string_view): " <<
+      measure(argv[0], SIZE, [&input](cu0::Process& process) {
+        process.stdin(std::string_view{input});
+      }) << "MB/s" << '\n';
+  constexpr auto BLOCK_SIZE = std::size_t{4096};
+  auto inputs = std::vector<std::string_view>{};
+  for (auto i = std::size_t{0}; i < SIZE; i += BLOCK_SIZE) {
+    inputs.emplace_back(input.data() + i, BLOCK_SIZE);
+  }
+  std::cout << "cu0::Process::stdin(std::span<const std::string_view>) " <<
+      "of 4 KiB blocks: " <<
+      measure(argv[0], SIZE, [&inputs](cu0::Process& process) {
+        process.stdin(std::span<const std::string_view>{inputs});
+      }) << "MB/s" << '\n';
+}
+
+#endif
+#endif
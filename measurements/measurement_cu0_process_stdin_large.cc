@@ -0,0 +1,146 @@
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_stdin_large will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<sys/resource.h>) || \
+  !__has_include(<sys/mman.h>) || \
+  !__has_include(<sys/uio.h>) || \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<fcntl.h>)
+#warning <sys/types.h> or <sys/wait.h> or <sys/resource.h> or <sys/mman.h> \
+    or <sys/uio.h> or <unistd.h> or <fcntl.h> is not found => \
+    measurement_cu0_process_stdin_large will be hollow
+int main() {}
+#else
+
+/*!
+ * @brief accesses the cpu time spent by this process
+ * @return user + system cpu time
+ */
+std::chrono::microseconds cpuTime() {
+  auto usage = rusage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return std::chrono::seconds{usage.ru_utime.tv_sec} +
+      std::chrono::seconds{usage.ru_stime.tv_sec} +
+      std::chrono::microseconds{usage.ru_utime.tv_usec} +
+      std::chrono::microseconds{usage.ru_stime.tv_usec};
+}
+
+/*!
+ * @brief measures passing data to stdin of a child until it has consumed them
+ * @param binary is the path to this measurement
+ * @param input are the data passed to the child
+ * @param stdio specifies stdio of the child
+ * @param transfer passes the data to the process
+ * @return tuple of throughput in MB/s and cpu time of this process per MB
+ *     in microseconds
+ */
+std::tuple<double, double> measure(
+    const std::string& binary,
+    const std::string& input,
+    const cu0::Stdio& stdio,
+    const std::function<void(cu0::Process&)>& transfer
+) {
+  const auto cpuStart = cpuTime();
+  const auto start = std::chrono::steady_clock::now();
+  auto created = cu0::Process::create(
+      cu0::Executable{ .binary = binary, .arguments = { "consume", }, },
+      stdio
+  );
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return { 0, 0, };
+  }
+  auto& process = std::get<cu0::Process>(created);
+  transfer(process);
+  process.wait();
+  const auto end = std::chrono::steady_clock::now();
+  const auto cpuEnd = cpuTime();
+  const auto megabytes = static_cast<double>(input.size()) / 1e6;
+  return {
+    megabytes / std::chrono::duration<double>(end - start).count(),
+    static_cast<double>((cpuEnd - cpuStart).count()) / megabytes,
+  };
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    //! a regular file is mapped, a pipe is read
+    auto status = ::lseek(STDIN_FILENO, 0, SEEK_END);
+    if (status > 0) {
+      const auto size = static_cast<std::size_t>(status);
+      const auto data = ::mmap(
+          nullptr, size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0
+      );
+      if (data == MAP_FAILED) {
+        return 1;
+      }
+      const auto bytes = static_cast<const volatile char*>(data);
+      auto sum = char{0};
+      for (auto i = std::size_t{0}; i < size; i += 4096) {
+        sum += bytes[i];
+      }
+      ::munmap(data, size);
+      return sum == 1;
+    }
+    char buffer[1 << 16];
+    while (::read(STDIN_FILENO, buffer, sizeof(buffer)) > 0);
+    return 0;
+  }
+  //! name, whether stdin is an in-memory file, transfer of the input
+  const auto methods = {
+    std::make_tuple(
+        "stdin", false,
+        std::function<void(cu0::Process&, const std::string&)>{
+          [](cu0::Process& process, const std::string& input) {
+            process.stdin(input);
+            process.closeStdin();
+          }
+        }
+    ),
+    std::make_tuple(
+        "stdinSpliced", false,
+        std::function<void(cu0::Process&, const std::string&)>{
+          [](cu0::Process& process, const std::string& input) {
+            process.stdinSpliced(input);
+            process.closeStdin();
+          }
+        }
+    ),
+    std::make_tuple(
+        "memory", true,
+        std::function<void(cu0::Process&, const std::string&)>{
+          [](cu0::Process&, const std::string&) {}
+        }
+    ),
+  };
+  std::cout << "method,payload_bytes,mb_per_s,cpu_us_per_mb" << '\n';
+  for (const auto& size : { std::size_t{64} << 20, std::size_t{512} << 20, }) {
+    const auto input = std::string(size, 'x');
+    for (const auto& [name, memory, transfer] : methods) {
+      const auto stdio = memory ?
+          cu0::Stdio{ .in = cu0::Redirection::memory(input) } : cu0::Stdio{};
+      const auto [throughput, cpu] = measure(
+          argv[0], input, stdio,
+          [&transfer, &input](cu0::Process& process) {
+            transfer(process, input);
+          }
+      );
+      std::cout << name << "," << size << "," << throughput << "," << cpu <<
+          '\n';
+    }
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,115 @@
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_stdout will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/types.h> or <sys/wait.h> or <unistd.h> is not found => \
+    measurement_cu0_process_stdout will be hollow
+int main() {}
+#else
+
+/*!
+ * @brief reads the pipe the way Process::stdout() did before it became
+ *     binary-safe: NUL-terminated 1 KiB chunks streamed into
+ *     std::ostringstream until the first short read
+ * @param pipe is the pipe to read from
+ * @return read value
+ */
+std::string legacyReadFrom(const int& pipe) {
+  constexpr auto BUFFER_SIZE = std::size_t{1024};
+  auto oss = std::ostringstream{};
+  ssize_t bytes;
+  do {
+    char buffer[BUFFER_SIZE];
+    bytes = ::read(pipe, buffer, BUFFER_SIZE - 1);
+    if (bytes < 0) {
+      return oss.str();
+    }
+    buffer[bytes] = '\0';
+    oss << buffer;
+  } while (bytes == BUFFER_SIZE - 1);
+  return oss.str();
+}
+
+/*!
+ * @brief measures throughput of capturing the stdout of a child
+ * @param binary is the path to this measurement
+ * @param size is the number of bytes the child writes
+ * @param capture reads the stdout of the process
+ * @return tuple of throughput in MB/s and the number of captured bytes
+ */
+std::tuple<double, std::size_t> measure(
+    const std::string& binary,
+    const std::size_t& size,
+    const std::function<std::string(cu0::Process&)>& capture
+) {
+  auto created = cu0::Process::create(cu0::Executable{
+    .binary = binary,
+    .arguments = {"produce", std::to_string(size)},
+  });
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return { 0, 0, };
+  }
+  auto& process = std::get<cu0::Process>(created);
+  const auto start = std::chrono::high_resolution_clock::now();
+  const auto captured = capture(process).size();
+  const auto end = std::chrono::high_resolution_clock::now();
+  process.signal(SIGKILL); //! the legacy path may stop early
+  process.wait();
+  return {
+    static_cast<double>(captured) / 1e6 /
+        std::chrono::duration<double>(end - start).count(),
+    captured,
+  };
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 2) {
+    auto size = std::stoull(argv[2]);
+    const auto block = std::string(1 << 16, 'x');
+    while (size > 0) {
+      const auto bytes = ::write(
+          STDOUT_FILENO, block.data(), std::min<std::size_t>(size, block.size())
+      );
+      if (bytes <= 0) {
+        return 1;
+      }
+      size -= bytes;
+    }
+    return 0;
+  }
+  constexpr auto MIN_SIZE = std::size_t{1} << 10; //! 1 KiB
+  constexpr auto MAX_SIZE = std::size_t{1} << 30; //! 1 GiB
+  for (auto size = MIN_SIZE; size <= MAX_SIZE; size <<= 5) {
+    const auto [legacyThroughput, legacyBytes] = measure(
+        argv[0], size, [](cu0::Process& process) {
+          return legacyReadFrom(process.stdoutPipe());
+        }
+    );
+    const auto [throughput, bytes] = measure(
+        argv[0], size, [](cu0::Process& process) {
+          return process.stdout();
+        }
+    );
+    std::cout << size << "B: " <<
+        "legacy ostringstream: " << legacyThroughput << "MB/s " <<
+        "(" << legacyBytes << "B captured), " <<
+        "cu0::Process::stdout(): " << throughput << "MB/s " <<
+        "(" << bytes << "B captured)" << '\n';
+  }
+}
+
+#endif
+#endif
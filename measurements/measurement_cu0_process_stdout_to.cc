@@ -0,0 +1,163 @@
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_process_stdout_to will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<sys/resource.h>) || \
+  !__has_include(<sys/stat.h>) || \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<fcntl.h>)
+#warning <sys/types.h> or <sys/wait.h> or <sys/resource.h> or <sys/stat.h> \
+    or <unistd.h> or <fcntl.h> is not found => \
+    measurement_cu0_process_stdout_to will be hollow
+int main() {}
+#else
+
+/*!
+ * @brief accesses the cpu time spent by this process
+ * @return user + system cpu time
+ */
+std::chrono::microseconds cpuTime() {
+  auto usage = rusage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return std::chrono::seconds{usage.ru_utime.tv_sec} +
+      std::chrono::seconds{usage.ru_stime.tv_sec} +
+      std::chrono::microseconds{usage.ru_utime.tv_usec} +
+      std::chrono::microseconds{usage.ru_stime.tv_usec};
+}
+
+/*!
+ * @brief measures persisting stdout of a child to a file
+ * @param binary is the path to this measurement
+ * @param size is the number of bytes produced by the child
+ * @param path is the path to the file
+ * @param flags are additional flags of ::open()
+ * @param transfer moves the stdout of the process to the file descriptor
+ * @return tuple of throughput in MB/s and cpu time of this process per MB
+ *     in microseconds
+ */
+std::tuple<double, double> measure(
+    const std::string& binary,
+    const std::size_t& size,
+    const std::filesystem::path& path,
+    const int& flags,
+    const std::function<void(cu0::Process&, const int&)>& transfer
+) {
+  auto created = cu0::Process::create(cu0::Executable{
+    .binary = binary,
+    .arguments = { "produce", std::to_string(size), },
+  });
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return { 0, 0, };
+  }
+  auto& process = std::get<cu0::Process>(created);
+  const auto fd = ::open(
+      path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | flags, 0666
+  );
+  if (fd < 0) {
+    return { 0, 0, };
+  }
+  const auto cpuStart = cpuTime();
+  const auto start = std::chrono::steady_clock::now();
+  transfer(process, fd);
+  const auto end = std::chrono::steady_clock::now();
+  const auto cpuEnd = cpuTime();
+  ::close(fd);
+  process.wait();
+  std::filesystem::remove(path);
+  const auto megabytes = static_cast<double>(size) / 1e6;
+  return {
+    megabytes / std::chrono::duration<double>(end - start).count(),
+    static_cast<double>((cpuEnd - cpuStart).count()) / megabytes,
+  };
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    char buffer[1 << 16];
+    auto size = std::stoull(argv[2]);
+    std::fill(std::begin(buffer), std::end(buffer), 'x');
+    while (size > 0) {
+      const auto bytes = ::write(
+          STDOUT_FILENO, buffer, std::min<std::size_t>(size, sizeof(buffer))
+      );
+      if (bytes <= 0) {
+        return 1;
+      }
+      size -= bytes;
+    }
+    return 0;
+  }
+  const auto path = std::filesystem::temp_directory_path() /
+      ("measurement_cu0_process_stdout_to_" + std::to_string(::getpid()));
+  const auto methods = {
+    std::make_tuple(
+        "stdout+write", 0,
+        std::function<void(cu0::Process&, const int&)>{
+          [](cu0::Process& process, const int& fd) {
+            const auto output = process.stdout();
+            for (auto written = std::size_t{0}; written < output.size();) {
+              const auto bytes = ::write(
+                  fd, output.data() + written, output.size() - written
+              );
+              if (bytes <= 0) {
+                return;
+              }
+              written += bytes;
+            }
+          }
+        }
+    ),
+    std::make_tuple(
+        "stdoutTo", 0,
+        std::function<void(cu0::Process&, const int&)>{
+          [](cu0::Process& process, const int& fd) {
+            process.stdoutTo(fd);
+          }
+        }
+    ),
+    //! older kernels do not splice() to O_APPEND => read() + write() fallback
+    std::make_tuple(
+        "stdoutTo(O_APPEND)", O_APPEND,
+        std::function<void(cu0::Process&, const int&)>{
+          [](cu0::Process& process, const int& fd) {
+            process.stdoutTo(fd);
+          }
+        }
+    ),
+    std::make_tuple(
+        "stdoutTee", 0,
+        std::function<void(cu0::Process&, const int&)>{
+          [](cu0::Process& process, const int& fd) {
+            auto count = std::size_t{0};
+            process.stdoutTee(fd, [&count](std::span<const std::byte> chunk) {
+              count += chunk.size();
+            });
+          }
+        }
+    ),
+  };
+  std::cout << "method,payload_bytes,mb_per_s,cpu_us_per_mb" << '\n';
+  for (const auto& size : { std::size_t{64} << 20, std::size_t{512} << 20, }) {
+    for (const auto& [name, flags, transfer] : methods) {
+      const auto [throughput, cpu] =
+          measure(argv[0], size, path, flags, transfer);
+      std::cout << name << "," << size << "," << throughput << "," << cpu <<
+          '\n';
+    }
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,85 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/result_cache.hh>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_result_cache will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<fcntl.h>) || \
+  !__has_include(<sys/mman.h>) || \
+  !__has_include(<sys/stat.h>) || \
+  !__has_include(<sys/uio.h>) || \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<poll.h>) || \
+  !__has_include(<signal.h>)
+#warning <fcntl.h> or <sys/mman.h> or <sys/stat.h> or <sys/uio.h> \
+    or <unistd.h> or <poll.h> or <signal.h> is not found => \
+    measurement_cu0_result_cache will be hollow
+int main() {}
+#else
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    std::cout << std::string(std::stoul(argv[1]), 'o');
+    return 0;
+  }
+  const auto directory = std::filesystem::temp_directory_path() /
+      ("measurement_cu0_result_cache_" + std::to_string(::getpid()));
+  auto opened = cu0::ResultCache::open(directory);
+  if (!std::holds_alternative<cu0::ResultCache>(opened)) {
+    return 1;
+  }
+  const auto& cache = std::get<cu0::ResultCache>(opened);
+  constexpr auto N = 200;
+  std::cout << "method,out_bytes,per_run_us" << '\n';
+  for (const auto& size : { 16, 1 << 20, }) {
+    //! every run of the miss is a new key => executed and stored
+    const auto executable = [&argv, &size](const int& run) {
+      return cu0::Executable{
+        .binary = argv[0],
+        .arguments = { std::to_string(size), std::to_string(run), },
+      };
+    };
+    const auto measure = [&size](const char* name, const auto& run) {
+      const auto start = std::chrono::steady_clock::now();
+      for (auto i = 0; i < N; i++) {
+        if (!run(i)) {
+          std::exit(1);
+        }
+      }
+      const auto end = std::chrono::steady_clock::now();
+      std::cout << name << "," << size << "," <<
+          std::chrono::duration<double, std::micro>(end - start).count() / N <<
+          '\n';
+    };
+    measure("Process::communicate", [&executable](const int& i) {
+      auto created = cu0::Process::create(executable(i));
+      if (!std::holds_alternative<cu0::Process>(created)) {
+        return false;
+      }
+      auto& process = std::get<cu0::Process>(created);
+      const auto [out, err] = process.communicate();
+      process.wait();
+      return process.exitCode() == 0;
+    });
+    measure("ResultCache::run miss", [&cache, &executable](const int& i) {
+      const auto ran = cache.run(executable(i));
+      return std::holds_alternative<cu0::ResultCache::Record>(ran);
+    });
+    measure("ResultCache::run hit", [&cache, &executable](const int& i) {
+      const auto ran = cache.run(executable(i));
+      return std::get<cu0::ResultCache::Record>(ran).cached();
+    });
+  }
+  std::filesystem::remove_all(directory);
+}
+
+#endif
+#endif
@@ -0,0 +1,135 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/ring_buffer.hh>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_ring_buffer will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<fcntl.h>) || \
+  !__has_include(<sys/mman.h>) || \
+  !__has_include(<sys/stat.h>) || \
+  !__has_include(<sys/syscall.h>) || \
+  !__has_include(<linux/futex.h>) || \
+  !__has_include(<poll.h>) || \
+  !__has_include(<unistd.h>)
+#warning <fcntl.h> or <sys/mman.h> or <sys/stat.h> or <sys/syscall.h> or \
+    <linux/futex.h> or <poll.h> or <unistd.h> is not found => \
+    measurement_cu0_ring_buffer will be hollow
+int main() {}
+#else
+
+/*!
+ * usage: measurement_cu0_ring_buffer
+ * @note a child produces the payload in chunks through its stdout pipe or
+ *     through a ring buffer of a given capacity, this process consumes it
+ *     chunk by chunk without copying it anywhere
+ */
+
+constexpr auto CHUNK_SIZE = std::size_t{1} << 16; //! [B]
+
+/*!
+ * @brief measures the consumption of the payload of a child
+ * @param binary is the path to this measurement
+ * @param size is the size of the payload
+ * @param capacity is the capacity of the ring buffer (0 for the pipe)
+ * @return throughput in MB/s (0 if the measurement failed)
+ */
+double measure(
+    const std::string& binary,
+    const std::size_t& size,
+    const std::size_t& capacity
+) {
+  auto executable = cu0::Executable{
+    .binary = binary,
+    .arguments = { capacity == 0 ? "pipe" : "ring", std::to_string(size), },
+  };
+  auto stdio = cu0::Stdio{ .in = cu0::Redirection::null() };
+  auto ring = std::optional<cu0::RingBuffer>{};
+  if (capacity != 0) {
+    auto created = cu0::RingBuffer::create(capacity);
+    if (!std::holds_alternative<cu0::RingBuffer>(created)) {
+      return 0;
+    }
+    ring.emplace(std::get<cu0::RingBuffer>(std::move(created)));
+    ring->share(executable, stdio);
+  }
+  const auto start = std::chrono::steady_clock::now();
+  auto created = cu0::Process::create(executable, stdio);
+  if (!std::holds_alternative<cu0::Process>(created)) {
+    return 0;
+  }
+  auto& process = std::get<cu0::Process>(created);
+  auto consumed = std::size_t{0};
+  const auto consume = [&consumed](std::span<const std::byte> chunk) {
+    consumed += chunk.size();
+  };
+  if (ring) {
+    ring->readChunks(consume, process.pidfd());
+  } else {
+    process.stdoutChunks<CHUNK_SIZE>(consume);
+  }
+  process.wait();
+  const auto end = std::chrono::steady_clock::now();
+  if (consumed != size) {
+    return 0;
+  }
+  return static_cast<double>(size) / 1e6 /
+      std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 2) {
+    auto size = static_cast<std::size_t>(std::stoull(argv[2]));
+    const auto chunk = std::vector<std::byte>(CHUNK_SIZE, std::byte{'x'});
+    if (std::string{argv[1]} == "pipe") {
+      while (size > 0) {
+        const auto bytes = ::write(
+            STDOUT_FILENO, chunk.data(), std::min(size, chunk.size())
+        );
+        if (bytes <= 0) {
+          return 1;
+        }
+        size -= bytes;
+      }
+      return 0;
+    }
+    auto attached = cu0::RingBuffer::attach();
+    if (!std::holds_alternative<cu0::RingBuffer>(attached)) {
+      return 1;
+    }
+    auto& ring = std::get<cu0::RingBuffer>(attached);
+    while (size > 0) {
+      const auto bytes = std::min(size, chunk.size());
+      ring.write(std::span{chunk}.first(bytes));
+      size -= bytes;
+    }
+    return 0;
+  }
+  std::cout << "channel,capacity_bytes,payload_bytes,mb_per_s" << '\n';
+  for (const auto& size : { std::size_t{64} << 20, std::size_t{1} << 30, }) {
+    std::cout << "pipe,0," << size << "," << measure(argv[0], size, 0) <<
+        '\n';
+    for (
+        const auto& capacity : {
+          std::size_t{64} << 10,
+          std::size_t{1} << 20,
+          std::size_t{4} << 20,
+          std::size_t{16} << 20,
+        }
+    ) {
+      std::cout << "ring," << capacity << "," << size << "," <<
+          measure(argv[0], size, capacity) << '\n';
+    }
+  }
+}
+
+#endif
+#endif
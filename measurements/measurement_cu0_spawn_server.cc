@@ -0,0 +1,118 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/spawn_server.hh>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_spawn_server will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/socket.h>) || \
+  !__has_include(<sys/syscall.h>) || \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/socket.h> or <sys/syscall.h> or <sys/types.h> or <sys/wait.h> \
+    or <unistd.h> is not found => \
+    measurement_cu0_spawn_server will be hollow
+int main() {}
+#else
+
+//! creates a process
+using Spawn =
+    std::function<std::variant<cu0::Process, cu0::Process::CreateError>()>;
+
+/*!
+ * @brief measures the median latency of creating a process and waiting for it
+ * @param n is the number of spawns
+ * @param spawn creates a process
+ * @return median latency in microseconds (0 if a spawn failed)
+ */
+double measure(const std::size_t& n, const Spawn& spawn) {
+  auto latencies = std::vector<double>{};
+  latencies.reserve(n);
+  for (auto i = std::size_t{0}; i < n; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    auto spawned = spawn();
+    if (!std::holds_alternative<cu0::Process>(spawned)) {
+      return 0;
+    }
+    std::get<cu0::Process>(spawned).wait();
+    const auto end = std::chrono::steady_clock::now();
+    latencies.push_back(
+        std::chrono::duration<double, std::micro>(end - start).count()
+    );
+  }
+  std::sort(latencies.begin(), latencies.end());
+  return latencies[latencies.size() / 2];
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 1) {
+    return 0;
+  }
+  //! created while this process is small
+  auto created = cu0::SpawnServer::create();
+  if (!std::holds_alternative<cu0::SpawnServer>(created)) {
+    return 1;
+  }
+  const auto& server = std::get<cu0::SpawnServer>(created);
+  const auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = { "exit", },
+  };
+  const auto plan = cu0::ExecPlan{executable};
+  const auto methods = {
+    std::make_tuple(
+        "create(FORK)",
+        Spawn{
+          [&plan]() {
+            return cu0::Process::create(
+                plan, cu0::Process::SpawnStrategy::FORK
+            );
+          }
+        }
+    ),
+    std::make_tuple(
+        "create(VFORK)",
+        Spawn{
+          [&plan]() {
+            return cu0::Process::create(
+                plan, cu0::Process::SpawnStrategy::VFORK
+            );
+          }
+        }
+    ),
+    std::make_tuple(
+        "SpawnServer::spawn",
+        Spawn{
+          [&server, &executable]() {
+            return server.spawn(executable);
+          }
+        }
+    ),
+  };
+  constexpr auto N = std::size_t{200};
+  std::cout << "method,parent_rss_bytes,p50_us" << '\n';
+  auto memory = std::vector<char>{};
+  for (
+      const auto& rss :
+      { std::size_t{0}, std::size_t{256} << 20, std::size_t{2} << 30, }
+  ) {
+    //! touched => the pages are mapped by the page tables of this process
+    memory.resize(rss, 1);
+    for (const auto& [name, spawn] : methods) {
+      std::cout << name << "," << rss << "," << measure(N, spawn) << '\n';
+    }
+  }
+}
+
+#endif
+#endif
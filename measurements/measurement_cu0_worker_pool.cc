@@ -0,0 +1,157 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/worker_pool.hh>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_worker_pool will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<signal.h>) || \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<sys/uio.h>) || \
+  !__has_include(<unistd.h>) || \
+  !__has_include(<fcntl.h>)
+#warning <signal.h> or <sys/types.h> or <sys/wait.h> or <sys/uio.h> \
+    or <unistd.h> or <fcntl.h> is not found => \
+    measurement_cu0_worker_pool will be hollow
+int main() {}
+#else
+
+//! value depending on the touched memory => the touching is not optimised out
+volatile std::size_t initialised = 0;
+
+/*!
+ * @brief simulates initialisation of a process by touching memory
+ * @param size is the number of bytes to be touched
+ */
+void initialise(const std::size_t& size) {
+  auto memory = std::vector<char>(size, 1);
+  for (auto i = std::size_t{0}; i < memory.size(); i += 4096) {
+    initialised = initialised + memory[i];
+  }
+}
+
+//! passes a request and returns the response
+using Request = std::function<std::string(std::string_view)>;
+
+/*!
+ * @brief measures latencies of requests
+ * @param n is the number of requests
+ * @param request passes a request and returns the response
+ * @return sorted latencies (empty if a response was wrong)
+ */
+std::vector<std::chrono::nanoseconds> measure(
+    const std::size_t& n,
+    const Request& request
+) {
+  auto latencies = std::vector<std::chrono::nanoseconds>{};
+  latencies.reserve(n);
+  for (auto i = std::size_t{0}; i < n; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto response = request("request");
+    const auto end = std::chrono::steady_clock::now();
+    if (response != "request") {
+      return {};
+    }
+    latencies.push_back(end - start);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 2) {
+    initialise(std::stoull(argv[2]));
+    if (std::string{argv[1]} == "worker") {
+      static_cast<void>(cu0::WorkerPool::serve(
+          [](std::string_view request) { return request; }
+      ));
+      return 0;
+    }
+    //! a process per request
+    std::cout << std::cin.rdbuf();
+    return 0;
+  }
+  constexpr auto N = std::size_t{500};
+  std::cout << "method,initialised_bytes,p50_us,p99_us" << '\n';
+  for (const auto& size : { std::size_t{0}, std::size_t{64} << 20, }) {
+    const auto plan = cu0::ExecPlan{
+      cu0::Executable{
+        .binary = argv[0],
+        .arguments = { "cat", std::to_string(size), },
+      }
+    };
+    auto created = cu0::WorkerPool::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "worker", std::to_string(size), },
+        },
+        1
+    );
+    if (!std::holds_alternative<cu0::WorkerPool>(created)) {
+      return 1;
+    }
+    const auto& pool = std::get<cu0::WorkerPool>(created);
+    //! the worker is initialised before the measurement
+    static_cast<void>(pool.call("request"));
+    const auto methods = {
+      std::make_tuple(
+          "Process::create",
+          Request{
+            [&plan](std::string_view request) {
+              auto created = cu0::Process::create(
+                  plan,
+                  cu0::Stdio{
+                    .in = cu0::Redirection::memory(request),
+                    .out = cu0::Redirection::pipe(),
+                  }
+              );
+              if (!std::holds_alternative<cu0::Process>(created)) {
+                return std::string{};
+              }
+              auto& process = std::get<cu0::Process>(created);
+              auto response = process.stdout();
+              process.wait();
+              return response;
+            }
+          }
+      ),
+      std::make_tuple(
+          "WorkerPool::call",
+          Request{
+            [&pool](std::string_view request) {
+              return pool.call(request);
+            }
+          }
+      ),
+    };
+    for (const auto& [name, request] : methods) {
+      const auto latencies = measure(N, request);
+      if (latencies.empty()) {
+        return 1;
+      }
+      const auto percentile = [&latencies](const double& percentile) {
+        const auto index = static_cast<std::size_t>(
+            percentile / 100 * static_cast<double>(latencies.size() - 1)
+        );
+        return std::chrono::duration<double, std::micro>(
+            latencies[index]
+        ).count();
+      };
+      std::cout << name << "," << size << "," << percentile(50) << "," <<
+          percentile(99) << '\n';
+    }
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,147 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/zygote_pool.hh>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef __unix__
+#warning __unix__ is not defined => \
+    measurement_cu0_zygote_pool will be hollow
+int main() {}
+#else
+#if \
+  !__has_include(<sys/socket.h>) || \
+  !__has_include(<sys/syscall.h>) || \
+  !__has_include(<sys/types.h>) || \
+  !__has_include(<sys/wait.h>) || \
+  !__has_include(<unistd.h>)
+#warning <sys/socket.h> or <sys/syscall.h> or <sys/types.h> or <sys/wait.h> \
+    or <unistd.h> is not found => \
+    measurement_cu0_zygote_pool will be hollow
+int main() {}
+#else
+
+//! value depending on the touched memory => the touching is not optimised out
+volatile std::size_t initialised = 0;
+
+/*!
+ * @brief simulates initialisation of a process by touching memory
+ * @param size is the number of bytes to be touched
+ */
+void initialise(const std::size_t& size) {
+  auto memory = std::vector<char>(size, 1);
+  for (auto i = std::size_t{0}; i < memory.size(); i += 4096) {
+    initialised = initialised + memory[i];
+  }
+}
+
+//! launches a process
+using Launch =
+    std::function<std::variant<cu0::Process, cu0::Process::CreateError>()>;
+
+/*!
+ * @brief measures latencies of launching a process and waiting for it
+ * @param n is the number of launches
+ * @param launch launches a process
+ * @return sorted latencies
+ */
+std::vector<std::chrono::nanoseconds> measure(
+    const std::size_t& n,
+    const Launch& launch
+) {
+  auto latencies = std::vector<std::chrono::nanoseconds>{};
+  latencies.reserve(n);
+  for (auto i = std::size_t{0}; i < n; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    auto launched = launch();
+    if (!std::holds_alternative<cu0::Process>(launched)) {
+      return {};
+    }
+    std::get<cu0::Process>(launched).wait();
+    const auto end = std::chrono::steady_clock::now();
+    latencies.push_back(end - start);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+int main(int argc, char** argv) {
+  //! for subprocess measurement
+  if (argc > 2) {
+    initialise(std::stoull(argv[2]));
+    if (std::string{argv[1]} == "zygote") {
+      //! both the launched processes and the zygote exit at once
+      static_cast<void>(cu0::ZygotePool::serve());
+    }
+    return 0;
+  }
+  constexpr auto N = std::size_t{1000};
+  std::cout << "method,initialised_bytes,p50_us,p99_us" << '\n';
+  for (const auto& size : { std::size_t{0}, std::size_t{64} << 20, }) {
+    const auto executable = cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "run", std::to_string(size), },
+    };
+    const auto plan = cu0::ExecPlan{executable};
+    auto zygoteExecutable = executable;
+    zygoteExecutable.arguments[0] = "zygote";
+    auto created = cu0::ZygotePool::create(zygoteExecutable);
+    if (!std::holds_alternative<cu0::ZygotePool>(created)) {
+      return 1;
+    }
+    const auto& pool = std::get<cu0::ZygotePool>(created);
+    const auto request = cu0::Executable{};
+    const auto methods = {
+      std::make_tuple(
+          "create(VFORK)",
+          Launch{
+            [&plan]() {
+              return cu0::Process::create(
+                  plan, cu0::Process::SpawnStrategy::VFORK
+              );
+            }
+          }
+      ),
+      std::make_tuple(
+          "create(CLONE)",
+          Launch{
+            [&plan]() {
+              return cu0::Process::create(
+                  plan, cu0::Process::SpawnStrategy::CLONE
+              );
+            }
+          }
+      ),
+      std::make_tuple(
+          "ZygotePool::launch",
+          Launch{
+            [&pool, &request]() {
+              return pool.launch(request);
+            }
+          }
+      ),
+    };
+    for (const auto& [name, launch] : methods) {
+      const auto latencies = measure(N, launch);
+      if (latencies.empty()) {
+        return 1;
+      }
+      const auto percentile = [&latencies](const double& percentile) {
+        const auto index = static_cast<std::size_t>(
+            percentile / 100 * static_cast<double>(latencies.size() - 1)
+        );
+        return std::chrono::duration<double, std::micro>(
+            latencies[index]
+        ).count();
+      };
+      std::cout << name << "," << size << "," << percentile(50) << "," <<
+          percentile(99) << '\n';
+    }
+  }
+}
+
+#endif
+#endif